@@ -0,0 +1,76 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include <ert/util/util.h>
+
+/**
+   Small benchmark of the byte swapping used when loading numeric
+   keywords from big endian files. For 4 and 8 byte elements the
+   throughput, in GB/s of decoded data, is reported for:
+
+     two-pass : memcpy() from an input buffer followed by an in place
+                util_endian_flip_vector() - the historical code path.
+     fused    : util_endian_flip_copy_vector() from the input buffer.
+     in-place : util_endian_flip_vector() on data which has been read
+                straight into the keyword storage.
+
+   Usage: kw_decode_bench [elements [repeats]]
+*/
+
+typedef void(bench_ftype)(char *, const char *, int, int);
+
+static void bench_two_pass(char *target, const char *src, int element_size,
+                           int elements) {
+    memcpy(target, src, (size_t)element_size * elements);
+    util_endian_flip_vector(target, element_size, elements);
+}
+
+static void bench_fused(char *target, const char *src, int element_size,
+                        int elements) {
+    util_endian_flip_copy_vector(target, src, element_size, elements);
+}
+
+static void bench_in_place(char *target, const char *src, int element_size,
+                           int elements) {
+    util_endian_flip_vector(target, element_size, elements);
+}
+
+static void run(const char *name, bench_ftype *func, int element_size,
+                int elements, int repeats) {
+    size_t bytes = (size_t)element_size * elements;
+    std::vector<char> src(bytes, 1);
+    std::vector<char> target(bytes, 0);
+
+    func(target.data(), src.data(), element_size, elements);
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++)
+        func(target.data(), src.data(), element_size, elements);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    double gb = 1e-9 * bytes * repeats;
+    printf("%-10s %d byte : %8.2f GB/s  (checksum:%d)\n", name, element_size,
+           gb / elapsed.count(), target[bytes / 2]);
+}
+
+int main(int argc, char **argv) {
+    int elements = 4 * 1000 * 1000;
+    int repeats = 50;
+
+    if (argc > 1)
+        util_sscanf_int(argv[1], &elements);
+    if (argc > 2)
+        util_sscanf_int(argv[2], &repeats);
+
+    const int element_sizes[] = {4, 8};
+    for (int element_size : element_sizes) {
+        run("two-pass", bench_two_pass, element_size, elements, repeats);
+        run("fused", bench_fused, element_size, elements, repeats);
+        run("in-place", bench_in_place, element_size, elements, repeats);
+    }
+    exit(0);
+}
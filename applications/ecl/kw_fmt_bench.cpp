@@ -0,0 +1,155 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <chrono>
+
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_kw.hpp>
+#include <ert/ecl/fortio.h>
+
+/**
+   Small benchmark of formatted (FUNRST/FEGRID/FSMSPEC style) keyword
+   I/O. A float and a double keyword are written to and read back from
+   a formatted file, and the time is reported for:
+
+     reference : one fprintf() / fscanf() call per element - the
+                 historical code path, reproduced here.
+     ecl_kw    : ecl_kw_fwrite() / ecl_kw_fread_alloc().
+
+   Usage: kw_fmt_bench [elements]
+*/
+
+static void reference_fprintf(FILE *stream, const char *fmt, double x) {
+    double pow_x = ceil(log10(fabs(x)));
+    double arg_x = x / pow(10.0, pow_x);
+    if (x != 0.0) {
+        if (fabs(arg_x) == 1.0) {
+            arg_x *= 0.10;
+            pow_x += 1;
+        }
+    } else {
+        arg_x = 0.0;
+        pow_x = 0.0;
+    }
+    fprintf(stream, fmt, arg_x, (int)pow_x);
+}
+
+static void reference_write(const char *filename, const ecl_kw_type *float_kw,
+                            const ecl_kw_type *double_kw) {
+    FILE *stream = util_fopen(filename, "w");
+    int size = ecl_kw_get_size(float_kw);
+
+    fprintf(stream, " '%-8s' %11d '%-4s'\n", "FLOAT", size, "REAL");
+    for (int i = 0; i < size; i++) {
+        reference_fprintf(stream, "  %11.8fE%+03d",
+                          ecl_kw_iget_float(float_kw, i));
+        if ((i + 1) % 4 == 0 || (i + 1) % 1000 == 0 || i + 1 == size)
+            fprintf(stream, "\n");
+    }
+
+    fprintf(stream, " '%-8s' %11d '%-4s'\n", "DOUBLE", size, "DOUB");
+    for (int i = 0; i < size; i++) {
+        reference_fprintf(stream, "  %17.14fD%+03d",
+                          ecl_kw_iget_double(double_kw, i));
+        if ((i + 1) % 3 == 0 || (i + 1) % 1000 == 0 || i + 1 == size)
+            fprintf(stream, "\n");
+    }
+    fclose(stream);
+}
+
+static double reference_read(const char *filename, int size) {
+    FILE *stream = util_fopen(filename, "r");
+    double sum = 0;
+    char header[32];
+
+    if (fgets(header, sizeof header, stream) == NULL)
+        util_abort("%s: failed to read header\n", __func__);
+    for (int i = 0; i < size; i++) {
+        float value;
+        if (fscanf(stream, "%gE", &value) == 1)
+            sum += value;
+    }
+    fgetc(stream);
+
+    if (fgets(header, sizeof header, stream) == NULL)
+        util_abort("%s: failed to read header\n", __func__);
+    for (int i = 0; i < size; i++) {
+        double arg;
+        int power;
+        if (fscanf(stream, "%lgD%d", &arg, &power) == 2)
+            sum += arg * pow(10, power);
+    }
+    fclose(stream);
+    return sum;
+}
+
+static void ecl_kw_write(const char *filename, const ecl_kw_type *float_kw,
+                         const ecl_kw_type *double_kw) {
+    fortio_type *fortio = fortio_open_writer(filename, true, true);
+    ecl_kw_fwrite(float_kw, fortio);
+    ecl_kw_fwrite(double_kw, fortio);
+    fortio_fclose(fortio);
+}
+
+static double ecl_kw_read(const char *filename, int size) {
+    fortio_type *fortio = fortio_open_reader(filename, true, true);
+    double sum = 0;
+    for (int k = 0; k < 2; k++) {
+        ecl_kw_type *kw = ecl_kw_fread_alloc(fortio);
+        for (int i = 0; i < size; i++)
+            sum += ecl_kw_iget_as_double(kw, i);
+        ecl_kw_free(kw);
+    }
+    fortio_fclose(fortio);
+    return sum;
+}
+
+static double elapsed(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return d.count();
+}
+
+int main(int argc, char **argv) {
+    int elements = 1000 * 1000;
+    if (argc > 1)
+        util_sscanf_int(argv[1], &elements);
+
+    ecl_kw_type *float_kw = ecl_kw_alloc("FLOAT", elements, ECL_FLOAT);
+    ecl_kw_type *double_kw = ecl_kw_alloc("DOUBLE", elements, ECL_DOUBLE);
+    for (int i = 0; i < elements; i++) {
+        double value = (i % 1000 - 500) * 0.731 + 1e-3 * i;
+        ecl_kw_iset_float(float_kw, i, value);
+        ecl_kw_iset_double(double_kw, i, value);
+    }
+
+    const char *reference_file = "kw_fmt_bench_reference.FINIT";
+    const char *ecl_kw_file = "kw_fmt_bench.FINIT";
+    auto start = std::chrono::steady_clock::now();
+    reference_write(reference_file, float_kw, double_kw);
+    double reference_write_time = elapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    double reference_sum = reference_read(reference_file, elements);
+    double reference_read_time = elapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    ecl_kw_write(ecl_kw_file, float_kw, double_kw);
+    double ecl_kw_write_time = elapsed(start);
+
+    start = std::chrono::steady_clock::now();
+    double ecl_kw_sum = ecl_kw_read(ecl_kw_file, elements);
+    double ecl_kw_read_time = elapsed(start);
+
+    printf("%-10s write: %8.3f s  read: %8.3f s  (checksum:%g)\n", "reference",
+           reference_write_time, reference_read_time, reference_sum);
+    printf("%-10s write: %8.3f s  read: %8.3f s  (checksum:%g)\n", "ecl_kw",
+           ecl_kw_write_time, ecl_kw_read_time, ecl_kw_sum);
+
+    remove(reference_file);
+    remove(ecl_kw_file);
+    ecl_kw_free(float_kw);
+    ecl_kw_free(double_kw);
+    exit(0);
+}
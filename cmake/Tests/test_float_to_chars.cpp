@@ -0,0 +1,7 @@
+#include <charconv>
+
+int main(int argc, char **argv) {
+    char buffer[32];
+    std::to_chars_result result = std::to_chars(buffer, buffer + 32, 0.1f);
+    return result.ptr == buffer;
+}
@@ -133,6 +133,8 @@ struct ecl_file_struct {
     int flags;
     vector_type *map_stack;
     inv_map_type *inv_view;
+    offset_type scan_end; /* The offset immediately after the last indexed
+                                       keyword; used by ecl_file_refresh(). */
 };
 
 /*
@@ -168,6 +170,7 @@ ecl_file_type *ecl_file_alloc_empty(int flags) {
     ecl_file->map_stack = vector_alloc_new();
     ecl_file->inv_view = inv_map_alloc();
     ecl_file->flags = flags;
+    ecl_file->scan_end = 0;
     return ecl_file;
 }
 
@@ -469,10 +472,15 @@ ecl_file_view_type *ecl_file_get_summary_view(ecl_file_type *ecl_file,
    an invalid ecl_kw instance is detected. This implies that for a partly broken
    file the ecl_file_scan function will index the valid keywords which are in
    the file, possible garbage at the end will be ignored.
+
+   The scan starts at file offset @start_offset, and the function returns
+   the offset immediately after the last valid keyword.
 */
 
-static void ecl_file_scan(ecl_file_type *ecl_file) {
-    fortio_fseek(ecl_file->fortio, 0, SEEK_SET);
+static offset_type ecl_file_scan_kw(ecl_file_type *ecl_file,
+                                    offset_type start_offset) {
+    offset_type scan_end = start_offset;
+    fortio_fseek(ecl_file->fortio, start_offset, SEEK_SET);
     {
         ecl_kw_type *work_kw = ecl_kw_alloc_new("WORK-KW", 0, ECL_INT, NULL);
 
@@ -491,9 +499,10 @@ static void ecl_file_scan(ecl_file_type *ecl_file) {
                     ecl_file_kw_type *file_kw =
                         ecl_file_kw_alloc(work_kw, current_offset);
 
-                    if (ecl_file_kw_fskip_data(file_kw, ecl_file->fortio))
+                    if (ecl_file_kw_fskip_data(file_kw, ecl_file->fortio)) {
                         ecl_file_view_add_kw(ecl_file->global_view, file_kw);
-                    else {
+                        scan_end = fortio_ftell(ecl_file->fortio);
+                    } else {
                         ecl_file_kw_free(file_kw);
                         break;
                     }
@@ -503,7 +512,189 @@ static void ecl_file_scan(ecl_file_type *ecl_file) {
 
         ecl_kw_free(work_kw);
     }
+    ecl_file->scan_end = scan_end;
+    return scan_end;
+}
+
+static offset_type ecl_file_scan(ecl_file_type *ecl_file,
+                                 offset_type start_offset) {
+    offset_type scan_end = ecl_file_scan_kw(ecl_file, start_offset);
     ecl_file_view_make_index(ecl_file->global_view);
+    return scan_end;
+}
+
+/*
+  The index cache used with the ECL_FILE_INDEX_CACHE flag is stored in
+  a hidden file next to the data file, i.e. for /path/CASE.UNRST the
+  cache is /path/.CASE.UNRST.index. The cache file contains:
+
+     1. A magic id.
+     2. The size and mtime of the data file when the cache was written.
+     3. The offset where the header scan ended; when the data file has
+        grown the scan is resumed from this offset.
+     4. The keyword index in the format of ecl_file_view_write_index().
+*/
+
+#define ECL_FILE_INDEX_CACHE_ID 7701355
+
+static char *ecl_file_alloc_index_cache_name(const char *filename) {
+    char *path;
+    char *cache_name;
+    char *basename = util_split_alloc_filename(filename);
+    char *hidden_name = util_alloc_sprintf(".%s", basename);
+
+    util_alloc_file_components(filename, &path, NULL, NULL);
+    cache_name = util_alloc_filename(path, hidden_name, "index");
+
+    free(path);
+    free(hidden_name);
+    free(basename);
+    return cache_name;
+}
+
+static ecl_file_kw_type **
+ecl_file_fread_index_cache(const char *cache_name, size_t *file_size,
+                           time_t *mtime, offset_type *scan_end, int *num_kw) {
+    ecl_file_kw_type **kw_list = NULL;
+    FILE *stream = fopen(cache_name, "rb");
+    if (!stream)
+        return NULL;
+
+    {
+        int id;
+        bool header_ok = (fread(&id, sizeof id, 1, stream) == 1) &&
+                         (id == ECL_FILE_INDEX_CACHE_ID) &&
+                         (fread(file_size, sizeof *file_size, 1, stream) == 1) &&
+                         (fread(mtime, sizeof *mtime, 1, stream) == 1) &&
+                         (fread(scan_end, sizeof *scan_end, 1, stream) == 1) &&
+                         (fread(num_kw, sizeof *num_kw, 1, stream) == 1);
+
+        if (header_ok && *num_kw > 0)
+            kw_list = ecl_file_kw_fread_alloc_multiple(stream, *num_kw);
+    }
+
+    fclose(stream);
+    return kw_list;
+}
+
+static void ecl_file_write_index_cache(const ecl_file_type *ecl_file,
+                                       const char *cache_name, size_t file_size,
+                                       time_t mtime, offset_type scan_end) {
+    /*
+      The cache is written to a temporary file which is then renamed, so
+      that concurrent readers never see a partially written cache file.
+    */
+    char *path;
+    util_alloc_file_components(cache_name, &path, NULL, NULL);
+    char *tmp_file = util_alloc_tmp_file(path ? path : ".", ".ecl_index", true);
+    FILE *stream = fopen(tmp_file, "wb");
+
+    if (stream) {
+        util_fwrite_int(ECL_FILE_INDEX_CACHE_ID, stream);
+        util_fwrite_size_t(file_size, stream);
+        util_fwrite_time_t(mtime, stream);
+        util_fwrite_offset(scan_end, stream);
+        ecl_file_view_write_index(ecl_file->global_view, stream);
+        fclose(stream);
+
+        if (rename(tmp_file, cache_name) != 0)
+            remove(tmp_file);
+    }
+
+    free(tmp_file);
+    free(path);
+}
+
+/*
+  When the data file has grown since the cache was written we verify
+  that the last keyword in the cache is still found at the same offset
+  in the file before the cached index is reused.
+*/
+
+static bool ecl_file_index_cache_tail_valid(ecl_file_type *ecl_file,
+                                            ecl_file_kw_type **kw_list,
+                                            int num_kw) {
+    const ecl_file_kw_type *last_kw = kw_list[num_kw - 1];
+    ecl_kw_type *work_kw = ecl_kw_alloc_new("WORK-KW", 0, ECL_INT, NULL);
+    bool valid = false;
+
+    fortio_fseek(ecl_file->fortio, ecl_file_kw_get_offset(last_kw), SEEK_SET);
+    if (ecl_kw_fread_header(work_kw, ecl_file->fortio) == ECL_KW_READ_OK) {
+        ecl_file_kw_type *file_kw =
+            ecl_file_kw_alloc(work_kw, ecl_file_kw_get_offset(last_kw));
+        valid = ecl_file_kw_equal(file_kw, last_kw);
+        ecl_file_kw_free(file_kw);
+    }
+
+    ecl_kw_free(work_kw);
+    return valid;
+}
+
+/**
+   Alternative to ecl_file_scan() used when the file has been opened
+   with the ECL_FILE_INDEX_CACHE flag:
+
+     1. If the cache exists and the size and mtime of the file are
+        unchanged the index is read from the cache and no scanning is
+        done.
+
+     2. If the file has grown the cached index is reused, and the
+        scan is resumed from the end of the previous scan.
+
+     3. Otherwise the complete file is scanned.
+
+   In case 2 and 3 the cache file is (re)written afterwards; failure
+   to write the cache, e.g. in a read-only directory, is silently
+   ignored. A cache file which is truncated, or has an invalid keyword
+   count or keyword type, is ignored and the complete file is scanned.
+*/
+
+static void ecl_file_scan_cached(ecl_file_type *ecl_file) {
+    const char *filename = fortio_filename_ref(ecl_file->fortio);
+    char *cache_name = ecl_file_alloc_index_cache_name(filename);
+    size_t file_size = util_file_size(filename);
+    time_t mtime = util_file_mtime(filename);
+    offset_type scan_start = 0;
+    bool unchanged = false;
+
+    {
+        size_t cache_file_size;
+        time_t cache_mtime;
+        offset_type scan_end;
+        int num_kw;
+        ecl_file_kw_type **kw_list = ecl_file_fread_index_cache(
+            cache_name, &cache_file_size, &cache_mtime, &scan_end, &num_kw);
+
+        if (kw_list) {
+            unchanged = (cache_file_size == file_size) && (cache_mtime == mtime);
+            bool grown = (file_size > cache_file_size) &&
+                         ecl_file_index_cache_tail_valid(ecl_file, kw_list,
+                                                         num_kw);
+
+            for (int i = 0; i < num_kw; i++) {
+                if (unchanged || grown)
+                    ecl_file_view_add_kw(ecl_file->global_view, kw_list[i]);
+                else
+                    ecl_file_kw_free(kw_list[i]);
+            }
+
+            if (unchanged || grown)
+                scan_start = scan_end;
+
+            free(kw_list);
+        }
+    }
+
+    if (unchanged) {
+        ecl_file_view_make_index(ecl_file->global_view);
+        ecl_file->scan_end = scan_start;
+    } else {
+        offset_type scan_end = ecl_file_scan(ecl_file, scan_start);
+        ecl_file_write_index_cache(ecl_file, cache_name, file_size, mtime,
+                                   scan_end);
+    }
+
+    free(cache_name);
 }
 
 void ecl_file_select_global(ecl_file_type *ecl_file) {
@@ -529,9 +720,14 @@ static fortio_type *ecl_file_alloc_fortio(const char *filename, int flags) {
 
     if (ecl_file_view_check_flags(flags, ECL_FILE_WRITABLE))
         fortio = fortio_open_readwrite(filename, fmt_file, ECL_ENDIAN_FLIP);
-    else
+    else {
         fortio = fortio_open_reader(filename, fmt_file, ECL_ENDIAN_FLIP);
 
+        /* If the mapping fails we silently fall back to stream based io. */
+        if (fortio && ecl_file_view_check_flags(flags, ECL_FILE_MMAP))
+            fortio_mmap(fortio);
+    }
+
     return fortio;
 }
 
@@ -544,7 +740,10 @@ ecl_file_type *ecl_file_open(const char *filename, int flags) {
         ecl_file->global_view = ecl_file_view_alloc(
             ecl_file->fortio, &ecl_file->flags, ecl_file->inv_view, true);
 
-        ecl_file_scan(ecl_file);
+        if (ecl_file_view_check_flags(flags, ECL_FILE_INDEX_CACHE))
+            ecl_file_scan_cached(ecl_file);
+        else
+            ecl_file_scan(ecl_file, 0);
         ecl_file_select_global(ecl_file);
 
         if (ecl_file_view_check_flags(ecl_file->flags, ECL_FILE_CLOSE_STREAM))
@@ -613,6 +812,79 @@ bool ecl_file_load_all(ecl_file_type *ecl_file) {
     return ecl_file_view_load_all(ecl_file->active_view);
 }
 
+bool ecl_file_load_kw_list(ecl_file_type *ecl_file, int num_kw,
+                           const char **kw_list, const int *occurence_list) {
+    return ecl_file_view_load_kw_list(ecl_file->active_view, num_kw, kw_list,
+                                      occurence_list);
+}
+
+/*
+  When the index has been loaded with ecl_file_fast_open() the end of
+  the last keyword is not known, and must be found by reading the
+  header of the last keyword.
+*/
+
+static bool ecl_file_init_scan_end(ecl_file_type *ecl_file) {
+    int size = ecl_file_view_get_size(ecl_file->global_view);
+    if (ecl_file->scan_end > 0 || size == 0)
+        return true;
+
+    const ecl_file_kw_type *last_kw =
+        ecl_file_view_iget_file_kw(ecl_file->global_view, size - 1);
+    ecl_kw_type *work_kw = ecl_kw_alloc_new("WORK-KW", 0, ECL_INT, NULL);
+    bool scan_ok = false;
+
+    fortio_fseek(ecl_file->fortio, ecl_file_kw_get_offset(last_kw), SEEK_SET);
+    if (ecl_kw_fread_header(work_kw, ecl_file->fortio) == ECL_KW_READ_OK &&
+        ecl_kw_fskip_data(work_kw, ecl_file->fortio)) {
+        ecl_file->scan_end = fortio_ftell(ecl_file->fortio);
+        scan_ok = true;
+    }
+
+    ecl_kw_free(work_kw);
+    return scan_ok;
+}
+
+/**
+   Will look for keywords which have been appended to the file since it
+   was opened - or since the previous call to ecl_file_refresh() - and
+   add them to the global view. The scan is resumed from the end of the
+   last complete keyword, so the cost is proportional to the amount of
+   new data and not to the size of the file. A partially written
+   keyword at the end of the file is left for a later refresh.
+
+   Observe that only the global view is updated, sub views like
+   restart and summary blocks which have been created before the
+   refresh do not see the new keywords. The function is a no-op for
+   files opened with ECL_FILE_WRITABLE, and for files which have been
+   detached with ecl_file_fortio_detach().
+
+   Returns the number of new keywords.
+*/
+
+int ecl_file_refresh(ecl_file_type *ecl_file) {
+    int new_kw = 0;
+
+    if (ecl_file->fortio == NULL || ecl_file_writable(ecl_file))
+        return 0;
+
+    if (fortio_assert_stream_open(ecl_file->fortio)) {
+        if (fortio_refresh_size(ecl_file->fortio) &&
+            ecl_file_init_scan_end(ecl_file)) {
+            int old_size = ecl_file_view_get_size(ecl_file->global_view);
+
+            ecl_file_scan_kw(ecl_file, ecl_file->scan_end);
+            ecl_file_view_extend_index(ecl_file->global_view, old_size);
+            new_kw = ecl_file_view_get_size(ecl_file->global_view) - old_size;
+        }
+    }
+
+    if (ecl_file_flags_set(ecl_file, ECL_FILE_CLOSE_STREAM))
+        fortio_fclose_stream(ecl_file->fortio);
+
+    return new_kw;
+}
+
 void ecl_file_free__(void *arg) { ecl_file_close(ecl_file_safe_cast(arg)); }
 
 /* Functions specialized to work with restart files.  */
@@ -20,6 +20,9 @@
 #include <stdio.h>
 #include <stdbool.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <ert/util/size_t_vector.hpp>
 #include <ert/util/util.h>
 
@@ -229,7 +232,23 @@ static void ecl_file_kw_load_kw(ecl_file_kw_type *file_kw, fortio_type *fortio,
     if (file_kw->kw != NULL)
         ecl_file_kw_drop_kw(file_kw, inv_map);
 
-    {
+    if (fortio_is_mmapped(fortio)) {
+        /*
+          The header has already been validated when the file was indexed,
+          so when the file is memory mapped the data section is decoded
+          straight from the mapping without going through the FILE stream.
+        */
+        offset_type data_offset =
+            file_kw->file_offset + ECL_KW_HEADER_FORTIO_SIZE;
+        ecl_kw_type *ecl_kw = ecl_kw_alloc(file_kw->header, file_kw->kw_size,
+                                           file_kw->data_type);
+        if (!ecl_kw_pread_data(ecl_kw, fortio, data_offset))
+            util_abort("%s: failed to load keyword:%s from mapped file:%s\n",
+                       __func__, file_kw->header, fortio_filename_ref(fortio));
+
+        file_kw->kw = ecl_kw;
+        inv_map_add_kw(inv_map, file_kw, file_kw->kw);
+    } else {
         fortio_fseek(fortio, file_kw->file_offset, SEEK_SET);
         file_kw->kw = ecl_kw_fread_alloc(fortio);
         ecl_file_kw_assert_kw(file_kw);
@@ -276,6 +295,64 @@ ecl_kw_type *ecl_file_kw_get_kw(ecl_file_kw_type *file_kw, fortio_type *fortio,
     return file_kw->kw;
 }
 
+/*
+  Will load all the keywords in @file_kw_list which are not already
+  loaded; the end result is as if ecl_file_kw_get_kw() had been
+  called for each of them in turn.
+
+  The offsets of the keywords are known from the index, so the data
+  sections are read with the positional fortio_pread_buffer() and
+  decoded in parallel; with OpenMP enabled the keywords are loaded by
+  concurrent threads. If positional reads are not supported for this
+  fortio instance - e.g. formatted files - or a read fails, the keyword
+  is loaded sequentially through the FILE stream instead.
+*/
+
+void ecl_file_kw_load_kw_list(ecl_file_kw_type **file_kw_list, int num_kw,
+                              fortio_type *fortio, inv_map_type *inv_map) {
+    std::vector<ecl_file_kw_type *> pending;
+    for (int i = 0; i < num_kw; i++) {
+        ecl_file_kw_type *file_kw = file_kw_list[i];
+        if (file_kw->ref_count == 0 &&
+            std::find(pending.begin(), pending.end(), file_kw) ==
+                pending.end()) {
+            ecl_file_kw_drop_kw(file_kw, inv_map);
+            pending.push_back(file_kw);
+        }
+    }
+
+    const int num_pending = pending.size();
+    std::vector<ecl_kw_type *> kw_list(num_pending);
+    std::vector<char> read_ok(num_pending, false);
+    for (int i = 0; i < num_pending; i++)
+        kw_list[i] = ecl_kw_alloc(pending[i]->header, pending[i]->kw_size,
+                                  pending[i]->data_type);
+
+    int i;
+#pragma omp parallel for schedule(dynamic)
+    for (i = 0; i < num_pending; i++) {
+        offset_type data_offset =
+            pending[i]->file_offset + ECL_KW_HEADER_FORTIO_SIZE;
+        read_ok[i] = ecl_kw_pread_data(kw_list[i], fortio, data_offset);
+    }
+
+    for (int i = 0; i < num_pending; i++) {
+        ecl_file_kw_type *file_kw = pending[i];
+        if (read_ok[i]) {
+            file_kw->kw = kw_list[i];
+            inv_map_add_kw(inv_map, file_kw, file_kw->kw);
+        } else {
+            ecl_kw_free(kw_list[i]);
+            ecl_file_kw_load_kw(file_kw, fortio, inv_map);
+        }
+    }
+
+    for (int i = 0; i < num_kw; i++) {
+        if (file_kw_list[i]->kw)
+            file_kw_list[i]->ref_count++;
+    }
+}
+
 bool ecl_file_kw_ptr_eq(const ecl_file_kw_type *file_kw,
                         const ecl_kw_type *ecl_kw) {
     if (file_kw->kw == ecl_kw)
@@ -357,10 +434,52 @@ void ecl_file_kw_fwrite(const ecl_file_kw_type *file_kw, FILE *stream) {
     util_fwrite_size_t(ecl_type_get_sizeof_iotype(file_kw->data_type), stream);
 }
 
+/*
+  The type and element size in an index file are checked before
+  ecl_type_create() is called, because ecl_type_create() aborts on
+  invalid input.
+*/
+
+static bool ecl_file_kw_valid_type(int type, size_t type_size) {
+    switch (type) {
+    case (ECL_CHAR_TYPE):
+    case (ECL_FLOAT_TYPE):
+    case (ECL_DOUBLE_TYPE):
+    case (ECL_INT_TYPE):
+    case (ECL_BOOL_TYPE):
+    case (ECL_MESS_TYPE):
+        return ((size_t)ecl_type_get_sizeof_iotype(ecl_type_create_from_type(
+                    (ecl_type_enum)type)) == type_size);
+    case (ECL_STRING_TYPE):
+        return (type_size > 0) && (type_size < 1000);
+    default:
+        return false;
+    }
+}
+
+/*
+  Will return NULL if the stream does not hold num complete records,
+  or if one of the records has an invalid type; i.e. a corrupt index
+  file is treated like a missing index file.
+*/
+
 ecl_file_kw_type **ecl_file_kw_fread_alloc_multiple(FILE *stream, int num) {
 
     size_t file_kw_size = ECL_STRING8_LENGTH + 2 * sizeof(int) +
                           sizeof(offset_type) + sizeof(size_t);
+    if (num < 0)
+        return NULL;
+
+    {
+        offset_type pos = util_ftell(stream);
+        if (pos >= 0 && util_fseek(stream, 0, SEEK_END) == 0) {
+            offset_type end = util_ftell(stream);
+            util_fseek(stream, pos, SEEK_SET);
+            if ((end - pos) / (offset_type)file_kw_size < num)
+                return NULL;
+        }
+    }
+
     size_t buffer_size = num * file_kw_size;
     char *buffer = (char *)util_malloc(buffer_size * sizeof *buffer);
     size_t num_read = fread(buffer, 1, buffer_size, stream);
@@ -378,7 +497,7 @@ ecl_file_kw_type **ecl_file_kw_fread_alloc_multiple(FILE *stream, int num) {
             char header[ECL_STRING8_LENGTH + 1];
             int kw_size;
             offset_type file_offset;
-            ecl_type_enum ecl_type;
+            int ecl_type;
             size_t type_size;
             {
                 int index = 0;
@@ -408,9 +527,17 @@ ecl_file_kw_type **ecl_file_kw_fread_alloc_multiple(FILE *stream, int num) {
             memcpy(&type_size, &buffer[buffer_offset], sizeof type_size);
             buffer_offset += sizeof type_size;
 
-            kw_list[ikw] =
-                ecl_file_kw_alloc0(header, ecl_type_create(ecl_type, type_size),
-                                   kw_size, file_offset);
+            if (!ecl_file_kw_valid_type(ecl_type, type_size)) {
+                for (int i = 0; i < ikw; i++)
+                    ecl_file_kw_free(kw_list[i]);
+                free(kw_list);
+                free(buffer);
+                return NULL;
+            }
+
+            kw_list[ikw] = ecl_file_kw_alloc0(
+                header, ecl_type_create((ecl_type_enum)ecl_type, type_size),
+                kw_size, file_offset);
         }
 
         free(buffer);
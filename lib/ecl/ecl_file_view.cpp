@@ -93,18 +93,29 @@ int ecl_file_view_get_global_index(const ecl_file_view_type *ecl_file_view,
 void ecl_file_view_make_index(ecl_file_view_type *ecl_file_view) {
     ecl_file_view->distinct_kw.clear();
     ecl_file_view->kw_index.clear();
-    {
-        int global_index = 0;
-        for (const auto &file_kw : ecl_file_view->kw_list) {
-            const std::string &header = ecl_file_kw_get_header(file_kw);
-            if (ecl_file_view->kw_index.find(header) ==
-                ecl_file_view->kw_index.end())
-                ecl_file_view->distinct_kw.push_back(header);
-
-            auto &index_vector = ecl_file_view->kw_index[header];
-            index_vector.push_back(global_index);
-            global_index++;
-        }
+    ecl_file_view_extend_index(ecl_file_view, 0);
+}
+
+/**
+   Will add the keywords from position @start_index and onwards in the
+   kw_list vector to the index; this can be used instead of the full
+   ecl_file_view_make_index() when keywords have only been appended to
+   the kw_list vector since the index was last built.
+*/
+
+void ecl_file_view_extend_index(ecl_file_view_type *ecl_file_view,
+                                int start_index) {
+    for (int global_index = start_index;
+         global_index < static_cast<int>(ecl_file_view->kw_list.size());
+         global_index++) {
+        const ecl_file_kw_type *file_kw = ecl_file_view->kw_list[global_index];
+        const std::string &header = ecl_file_kw_get_header(file_kw);
+        if (ecl_file_view->kw_index.find(header) ==
+            ecl_file_view->kw_index.end())
+            ecl_file_view->distinct_kw.push_back(header);
+
+        auto &index_vector = ecl_file_view->kw_index[header];
+        index_vector.push_back(global_index);
     }
 }
 
@@ -182,6 +193,45 @@ void ecl_file_view_index_fload_kw(const ecl_file_view_type *ecl_file_view,
     }
 }
 
+/*
+  Will load the data of occurence @index of keyword @kw into the
+  keyword @ecl_kw, which must already have the correct size and type.
+  As opposed to ecl_file_view_iget_named_kw() the keyword is not
+  retained by the ecl_file_view instance; i.e. the same work keyword
+  can be reused when iterating through a long sequence of keywords,
+  like the PARAMS keywords of a summary file.
+*/
+
+bool ecl_file_view_index_fread_kw(const ecl_file_view_type *ecl_file_view,
+                                  const char *kw, int index,
+                                  ecl_kw_type *ecl_kw) {
+    const ecl_file_kw_type *file_kw =
+        ecl_file_view_iget_named_file_kw(ecl_file_view, kw, index);
+
+    if (ecl_file_kw_get_size(file_kw) != ecl_kw_get_size(ecl_kw))
+        return false;
+
+    if (!ecl_type_is_equal(ecl_file_kw_get_data_type(file_kw),
+                           ecl_kw_get_data_type(ecl_kw)))
+        return false;
+
+    if (!fortio_assert_stream_open(ecl_file_view->fortio))
+        return false;
+
+    {
+        offset_type offset = ecl_file_kw_get_offset(file_kw);
+        fortio_type *fortio = ecl_file_view->fortio;
+
+        if (ecl_kw_pread_data(ecl_kw, fortio,
+                              offset + ECL_KW_HEADER_FORTIO_SIZE))
+            return true;
+
+        fortio_fseek(fortio, offset, SEEK_SET);
+        ecl_kw_fskip_header(fortio);
+        return ecl_kw_fread_data(ecl_kw, fortio);
+    }
+}
+
 int ecl_file_view_find_kw_value(const ecl_file_view_type *ecl_file_view,
                                 const char *kw, const void *value) {
     int global_index = -1;
@@ -290,9 +340,43 @@ bool ecl_file_view_load_all(ecl_file_view_type *ecl_file_view) {
     bool loadOK = false;
 
     if (fortio_assert_stream_open(ecl_file_view->fortio)) {
-        for (ecl_file_kw_type *file_kw : ecl_file_view->kw_list)
-            ecl_file_kw_get_kw(file_kw, ecl_file_view->fortio,
-                               ecl_file_view->inv_map);
+        ecl_file_kw_load_kw_list(ecl_file_view->kw_list.data(),
+                                 ecl_file_view->kw_list.size(),
+                                 ecl_file_view->fortio, ecl_file_view->inv_map);
+        loadOK = true;
+    }
+
+    if (ecl_file_view_flags_set(ecl_file_view, ECL_FILE_CLOSE_STREAM))
+        fortio_fclose_stream(ecl_file_view->fortio);
+
+    return loadOK;
+}
+
+/**
+   Will load the @num_kw keywords given by the (@kw_list[i],
+   @occurence_list[i]) pairs in one go. The keywords are read with
+   positional reads on the offsets from the index, and decoded in
+   parallel when OpenMP is enabled; this is typically much faster than
+   looking up the keywords one by one, e.g. when loading all the
+   solution arrays of one report step from a unified restart file.
+
+   After the call the keywords can be looked up with the ordinary
+   ecl_file_view_iget_named_kw() without touching the file.
+*/
+
+bool ecl_file_view_load_kw_list(ecl_file_view_type *ecl_file_view, int num_kw,
+                                const char **kw_list,
+                                const int *occurence_list) {
+    bool loadOK = false;
+    std::vector<ecl_file_kw_type *> file_kw_list;
+
+    for (int i = 0; i < num_kw; i++)
+        file_kw_list.push_back(ecl_file_view_iget_named_file_kw(
+            ecl_file_view, kw_list[i], occurence_list[i]));
+
+    if (fortio_assert_stream_open(ecl_file_view->fortio)) {
+        ecl_file_kw_load_kw_list(file_kw_list.data(), num_kw,
+                                 ecl_file_view->fortio, ecl_file_view->inv_map);
         loadOK = true;
     }
 
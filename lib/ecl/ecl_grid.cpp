@@ -23,6 +23,10 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <string>
@@ -694,8 +698,79 @@ struct ecl_cell_struct {
     nnc_info_type *nnc_info; /* Non-neighbour connection info*/
 };
 
+/*
+  Optional compact structure-of-arrays copy of the cell geometry, see
+  ecl_grid_init_compact_geometry(). The corner c of cell g is found at
+  index 8*g + c in the corner arrays. The values are copied from the
+  ecl_cell_type instances, which remain the authoritative storage, so
+  the store adds memory; it is an opt-in for speed, not for size. The
+  active maps are not part of the store since index_map and
+  inv_index_map already are flat int arrays.
+*/
+
+struct ecl_grid_geometry_struct {
+    std::vector<double> corner_x;
+    std::vector<double> corner_y;
+    std::vector<double> corner_z;
+
+    std::vector<double> center_x;
+    std::vector<double> center_y;
+    std::vector<double> center_z;
+
+    std::vector<double> volume;
+};
+
+typedef struct ecl_grid_geometry_struct ecl_grid_geometry_type;
+
+/*
+  Optional compressed sparse row storage of the NNC connections, see
+  ecl_grid_init_compact_nnc(). The connections from cell g are found in
+  the range [row_offset[g], row_offset[g + 1]) of the three connection
+  arrays, in the same order as in the nnc_info structure they replace.
+*/
+
+struct ecl_grid_nnc_store_struct {
+    std::vector<int> row_offset;
+    std::vector<int> lgr_nr;
+    std::vector<int> global_index;
+    std::vector<int> nnc_index;
+};
+
+typedef struct ecl_grid_nnc_store_struct ecl_grid_nnc_store_type;
+
+/*
+  Bounding volume hierarchy over the cell bounding boxes, used by
+  ecl_grid_get_global_index_from_xyz(). The cells of a node are the
+  range [first, first + count) of the cells vector; the two children of
+  an internal node are stored at index child and child + 1. The
+  min_index field is the smallest global index found below the node.
+  Tainted cells can never contain a point, and are not included.
+*/
+
+#define SEARCH_TREE_LEAF_SIZE 8
+
+struct ecl_grid_search_node_struct {
+    double min[3];
+    double max[3];
+    int first;
+    int count;
+    int child; /* -1 for leaf nodes. */
+    int min_index;
+};
+
+typedef struct ecl_grid_search_node_struct ecl_grid_search_node_type;
+
+struct ecl_grid_search_tree_struct {
+    std::vector<ecl_grid_search_node_type> nodes;
+    std::vector<int> cells;
+};
+
+typedef struct ecl_grid_search_tree_struct ecl_grid_search_tree_type;
+
 static ert_ecl_unit_enum
 ecl_grid_check_unit_system(const ecl_kw_type *gridunit_kw);
+static void ecl_grid_compute_cell_volumes(const ecl_grid_type *grid,
+                                          bool active_size, double *volume);
 static void ecl_grid_init_mapaxes_data_float(const ecl_grid_type *grid,
                                              float *mapaxes);
 float *ecl_grid_alloc_coord_data(const ecl_grid_type *grid);
@@ -713,8 +788,6 @@ struct ecl_grid_struct {
     int size; /* == nx*ny*nz */
     int total_active;
     int total_active_fracture;
-    bool *
-        visited; /* internal helper struct used when searching for index - can be NULL. */
     int *
         index_map; /* this a list of nx*ny*nz elements, where value -1 means inactive cell .*/
     int *
@@ -772,6 +845,16 @@ struct ecl_grid_struct {
 
     ert_ecl_unit_enum unit_system;
     int eclipse_version;
+
+    std::unique_ptr<ecl_grid_geometry_type>
+        geometry; /* Compact geometry store - NULL unless ecl_grid_init_compact_geometry() has been called. */
+    std::unique_ptr<ecl_grid_nnc_store_type>
+        nnc_store; /* CSR NNC storage - NULL unless ecl_grid_init_compact_nnc() has been called. */
+    mutable std::mutex
+        nnc_info_mutex; /* Guards the nnc_info instances created on demand from nnc_store. */
+    std::unique_ptr<ecl_grid_search_tree_type>
+        search_tree; /* Built on demand by ecl_grid_get_global_index_from_xyz(). */
+    std::once_flag search_tree_once;
 };
 
 ert_ecl_unit_enum ecl_grid_get_unit_system(const ecl_grid_type *grid) {
@@ -1132,38 +1215,103 @@ static void ecl_cell_install_lgr(ecl_cell_type *cell,
     cell->lgr = lgr_grid;
 }
 
-static double C(double *r, int f1, int f2, int f3) {
-    if (f1 == 0) {
-        if (f2 == 0) {
-            if (f3 == 0)
-                return r[0]; // 000
-            else
-                return r[4] - r[0]; // 001
-        } else {
-            if (f3 == 0)
-                return r[2] - r[0]; // 010
-            else
-                return r[6] + r[0] - r[4] - r[2]; // 011
-        }
-    } else {
-        if (f2 == 0) {
-            if (f3 == 0)
-                return r[1] - r[0]; // 100
-            else
-                return r[5] + r[0] - r[4] - r[1]; // 101
-        } else {
-            if (f3 == 0)
-                return r[3] + r[0] - r[2] - r[1]; // 110
-            else
-                return r[7] + r[4] + r[2] + r[1] - r[6] - r[5] - r[3] -
-                       r[0]; // 111
-        }
+#define ECL_CELL_VOLUME_BLOCK 64
+
+/*
+  The corner point cell volume is a sum of 64 terms, each a combination
+  of the coefficients
+
+     C(r, f1, f2, f3)  with f1, f2, f3 in {0, 1}
+
+  evaluated for the x, y and z corner coordinates r[0..7]. The
+  coefficient for the flags (f1, f2, f3) is stored at index
+  f1 + 2*f2 + 4*f3 in the output array @coef, and coefficient c of cell
+  i is at coef[c * ECL_CELL_VOLUME_BLOCK + i]. Corner c of cell i is
+  read from r[c * stride + i].
+*/
+
+static void ecl_cell_volume_coefficients(int count, int stride,
+                                         const double *r, double *coef) {
+#pragma omp simd
+    for (int i = 0; i < count; i++) {
+        const double r0 = r[i];
+        const double r1 = r[stride + i];
+        const double r2 = r[2 * stride + i];
+        const double r3 = r[3 * stride + i];
+        const double r4 = r[4 * stride + i];
+        const double r5 = r[5 * stride + i];
+        const double r6 = r[6 * stride + i];
+        const double r7 = r[7 * stride + i];
+
+        coef[0 * ECL_CELL_VOLUME_BLOCK + i] = r0;                     // 000
+        coef[1 * ECL_CELL_VOLUME_BLOCK + i] = r1 - r0;                // 100
+        coef[2 * ECL_CELL_VOLUME_BLOCK + i] = r2 - r0;                // 010
+        coef[3 * ECL_CELL_VOLUME_BLOCK + i] = r3 + r0 - r2 - r1;      // 110
+        coef[4 * ECL_CELL_VOLUME_BLOCK + i] = r4 - r0;                // 001
+        coef[5 * ECL_CELL_VOLUME_BLOCK + i] = r5 + r0 - r4 - r1;      // 101
+        coef[6 * ECL_CELL_VOLUME_BLOCK + i] = r6 + r0 - r4 - r2;      // 011
+        coef[7 * ECL_CELL_VOLUME_BLOCK + i] =
+            r7 + r4 + r2 + r1 - r6 - r5 - r3 - r0; // 111
     }
 }
 
+/*
+  Computes the volume of @count <= ECL_CELL_VOLUME_BLOCK cells; corner c
+  of cell i is found at index c * stride + i in the x, y and z arrays.
+  The terms are summed in the same order for every cell, with the inner
+  loop running over the cells, so the compiler can evaluate several
+  cells per instruction.
+*/
+
+static void ecl_cell_volume_block(int count, int stride, const double *x,
+                                  const double *y, const double *z,
+                                  double *volume) {
+    double CX[8 * ECL_CELL_VOLUME_BLOCK];
+    double CY[8 * ECL_CELL_VOLUME_BLOCK];
+    double CZ[8 * ECL_CELL_VOLUME_BLOCK];
+
+    ecl_cell_volume_coefficients(count, stride, x, CX);
+    ecl_cell_volume_coefficients(count, stride, y, CY);
+    ecl_cell_volume_coefficients(count, stride, z, CZ);
+
+    for (int i = 0; i < count; i++)
+        volume[i] = 0;
+
+    for (int pb = 0; pb <= 1; pb++)
+        for (int pg = 0; pg <= 1; pg++)
+            for (int qa = 0; qa <= 1; qa++)
+                for (int qg = 0; qg <= 1; qg++)
+                    for (int ra = 0; ra <= 1; ra++)
+                        for (int rb = 0; rb <= 1; rb++) {
+                            const int divisor =
+                                (qa + ra + 1) * (pb + rb + 1) * (pg + qg + 1);
+                            /* C(r,1,pb,pg), C(r,qa,1,qg) and C(r,ra,rb,1) */
+                            const int a = (1 + 2 * pb + 4 * pg) *
+                                          ECL_CELL_VOLUME_BLOCK;
+                            const int b = (qa + 2 + 4 * qg) *
+                                          ECL_CELL_VOLUME_BLOCK;
+                            const int c = (ra + 2 * rb + 4) *
+                                          ECL_CELL_VOLUME_BLOCK;
+
+#pragma omp simd
+                            for (int i = 0; i < count; i++) {
+                                double dV =
+                                    CX[a + i] * CY[b + i] * CZ[c + i] -
+                                    CX[a + i] * CZ[b + i] * CY[c + i] -
+                                    CY[a + i] * CX[b + i] * CZ[c + i] +
+                                    CY[a + i] * CZ[b + i] * CX[c + i] +
+                                    CZ[a + i] * CX[b + i] * CY[c + i] -
+                                    CZ[a + i] * CY[b + i] * CX[c + i];
+                                volume[i] += dV / divisor;
+                            }
+                        }
+
+    for (int i = 0; i < count; i++)
+        volume[i] = fabs(volume[i]);
+}
+
 static double ecl_cell_get_volume(ecl_cell_type *cell) {
-    double volume = 0;
-    int pb, pg, qa, qg, ra, rb;
+    double volume;
     double X[8];
     double Y[8];
     double Z[8];
@@ -1176,31 +1324,8 @@ static double ecl_cell_get_volume(ecl_cell_type *cell) {
         }
     }
 
-    for (pb = 0; pb <= 1; pb++)
-        for (pg = 0; pg <= 1; pg++)
-            for (qa = 0; qa <= 1; qa++)
-                for (qg = 0; qg <= 1; qg++)
-                    for (ra = 0; ra <= 1; ra++)
-                        for (rb = 0; rb <= 1; rb++) {
-                            int divisor =
-                                (qa + ra + 1) * (pb + rb + 1) * (pg + qg + 1);
-                            double dV = C(X, 1, pb, pg) * C(Y, qa, 1, qg) *
-                                            C(Z, ra, rb, 1) -
-                                        C(X, 1, pb, pg) * C(Z, qa, 1, qg) *
-                                            C(Y, ra, rb, 1) -
-                                        C(Y, 1, pb, pg) * C(X, qa, 1, qg) *
-                                            C(Z, ra, rb, 1) +
-                                        C(Y, 1, pb, pg) * C(Z, qa, 1, qg) *
-                                            C(X, ra, rb, 1) +
-                                        C(Z, 1, pb, pg) * C(X, qa, 1, qg) *
-                                            C(Y, ra, rb, 1) -
-                                        C(Z, 1, pb, pg) * C(Y, qa, 1, qg) *
-                                            C(X, ra, rb, 1);
-
-                            volume += dV / divisor;
-                        }
-
-    return fabs(volume);
+    ecl_cell_volume_block(1, 1, X, Y, Z, &volume);
+    return volume;
 }
 
 typedef struct tetrahedron_struct tetrahedron_type;
@@ -1512,7 +1637,6 @@ static ecl_grid_type *ecl_grid_alloc_empty(ecl_grid_type *global_grid,
 
     grid->dualp_flag = dualp_flag;
     grid->coord_kw = NULL;
-    grid->visited = NULL;
     grid->inv_index_map = NULL;
     grid->index_map = NULL;
     grid->fracture_index_map = NULL;
@@ -2156,16 +2280,12 @@ static void ecl_grid_install_lgr_GRID(ecl_grid_type *host_grid,
 */
 
 static void ecl_grid_set_lgr_name_EGRID(ecl_grid_type *lgr_grid,
-                                        const ecl_file_type *ecl_file,
-                                        int grid_nr) {
-    ecl_kw_type *lgrname_kw =
-        ecl_file_iget_named_kw(ecl_file, LGR_KW, grid_nr - 1);
+                                        const ecl_kw_type *lgrname_kw,
+                                        const ecl_kw_type *parent_kw) {
     lgr_grid->name =
         (char *)util_alloc_strip_copy((const char *)ecl_kw_iget_ptr(
             lgrname_kw, 0)); /* trailing zeros are stripped away. */
-    if (ecl_file_has_kw(ecl_file, LGR_PARENT_KW)) {
-        ecl_kw_type *parent_kw =
-            ecl_file_iget_named_kw(ecl_file, LGR_PARENT_KW, grid_nr - 1);
+    if (parent_kw) {
         char *parent = (char *)util_alloc_strip_copy(
             (const char *)ecl_kw_iget_ptr(parent_kw, 0));
 
@@ -2513,6 +2633,9 @@ static void ecl_grid_copy_content(ecl_grid_type *target_grid,
         if (src_cell->nnc_info)
             target_cell->nnc_info = nnc_info_alloc_copy(src_cell->nnc_info);
     }
+    if (src_grid->nnc_store)
+        target_grid->nnc_store =
+            std::make_unique<ecl_grid_nnc_store_type>(*src_grid->nnc_store);
     ecl_grid_copy_mapaxes(target_grid, src_grid);
 
     target_grid->parent_name = util_alloc_string_copy(src_grid->parent_name);
@@ -2527,7 +2650,7 @@ static ecl_grid_type *ecl_grid_alloc_copy__(const ecl_grid_type *src_grid,
     ecl_grid_type *copy_grid = ecl_grid_alloc_empty(
         main_grid, src_grid->unit_system, src_grid->dualp_flag,
         ecl_grid_get_nx(src_grid), ecl_grid_get_ny(src_grid),
-        ecl_grid_get_nz(src_grid), 0, false);
+        ecl_grid_get_nz(src_grid), src_grid->lgr_nr, false);
     if (copy_grid) {
         ecl_grid_copy_content(
             copy_grid,
@@ -2747,10 +2870,17 @@ ecl_grid_alloc_GRDECL_kw(int nx, int ny, int nz, const ecl_kw_type *zcorn_kw,
     return ecl_grid;
 }
 
+static void ecl_grid_release_nnc_store(ecl_grid_type *grid);
+static nnc_info_type *ecl_grid_alloc_cell_nnc_info(const ecl_grid_type *grid,
+                                                   int global_index);
+
 static void ecl_grid_init_cell_nnc_info(ecl_grid_type *ecl_grid,
                                         int global_index) {
     ecl_cell_type *grid_cell = ecl_grid_get_cell(ecl_grid, global_index);
 
+    if (ecl_grid->nnc_store)
+        ecl_grid_release_nnc_store(ecl_grid);
+
     if (!grid_cell->nnc_info)
         grid_cell->nnc_info = nnc_info_alloc(ecl_grid->lgr_nr);
 }
@@ -2818,6 +2948,58 @@ void ecl_grid_add_self_nnc_list(ecl_grid_type *grid, const int *g1_list,
         ecl_grid_add_self_nnc(grid, g1_list[i], g2_list[i], i);
 }
 
+/*
+  One block of non neighbour connections from an EGRID file, i.e. the
+  content of a NNC1/NNC2, NNCG/NNCL or NNA1/NNA2 keyword pair. The
+  connections are added to the cells of grid1, see
+  ecl_grid_init_nnc_blocks().
+*/
+typedef struct {
+    ecl_grid_type *grid1;
+    ecl_grid_type *grid2;
+    const int *grid1_nnc_cells;
+    const int *grid2_nnc_cells;
+    int nnc_count;
+} ecl_grid_nnc_block_type;
+
+/*
+  In the ECLIPSE output format grids with dual porosity are (to some
+  extent ...) modeled as two independent grids stacked on top of
+  eachother, where the fracture cells have global index in the range
+  [nx*ny*nz, 2*nx*ny*nz).
+
+  The physical connection between the matrix and the fractures in
+  cell nr c is modelled as an nnc: cell[c] -> cell[c + nx*ny*nz]. In
+  the ert ecl library we only have cells in the range [0,nx*ny*nz),
+  and fracture is a property of a cell. We therefore do not include
+  nnc connections involving fracture cells (i.e. cell_index >=
+  nx*ny*nz); the block is truncated at the first such connection.
+*/
+static ecl_grid_nnc_block_type
+ecl_grid_alloc_nnc_block(ecl_grid_type *grid1, ecl_grid_type *grid2,
+                         const ecl_kw_type *keyword1,
+                         const ecl_kw_type *keyword2) {
+    ecl_grid_nnc_block_type block;
+    block.grid1 = grid1;
+    block.grid2 = grid2;
+    block.grid1_nnc_cells = ecl_kw_get_int_ptr(keyword1);
+    block.grid2_nnc_cells = ecl_kw_get_int_ptr(keyword2);
+    block.nnc_count = ecl_kw_get_size(keyword2);
+
+    if (FILEHEAD_SINGLE_POROSITY != grid1->dualp_flag) {
+        for (int nnc_index = 0; nnc_index < block.nnc_count; nnc_index++) {
+            if ((block.grid1_nnc_cells[nnc_index] - 1 >= grid1->size) ||
+                (block.grid2_nnc_cells[nnc_index] - 1 >= grid2->size)) {
+                block.nnc_count = nnc_index;
+                break;
+            }
+        }
+    }
+    return block;
+}
+
+#define NNC_CELL_BUCKETS 256
+
 /*
   This function populates nnc_info for cells with non neighbour
   connections. For cells C1 and C2 the function will only add the directed link:
@@ -2830,56 +3012,67 @@ void ecl_grid_add_self_nnc_list(ecl_grid_type *grid, const int *g1_list,
     NNC1 -> NNC2   For nnc between cells in the same grid.
     NNCG -> NNCL   For global -> lgr connection
     NNA1 -> NNA2   For links between different LGRs
-*/
 
-static void ecl_grid_init_nnc_cells(ecl_grid_type *grid1, ecl_grid_type *grid2,
-                                    const ecl_kw_type *keyword1,
-                                    const ecl_kw_type *keyword2) {
+  The connections are distributed in buckets based on the cell index
+  in grid1, and the buckets are processed in parallel. All the
+  connections of one cell end up in the same bucket, in the order given
+  by @blocks, i.e. the resulting nnc_info structures are the same as
+  when adding the connections one by one.
+*/
+static void
+ecl_grid_init_nnc_blocks(const std::vector<ecl_grid_nnc_block_type> &blocks) {
+    std::vector<int> bucket_offset(NNC_CELL_BUCKETS + 1, 0);
+    for (const auto &block : blocks)
+        for (int nnc_index = 0; nnc_index < block.nnc_count; nnc_index++) {
+            unsigned cell_index = block.grid1_nnc_cells[nnc_index] - 1;
+            bucket_offset[cell_index % NNC_CELL_BUCKETS + 1]++;
+        }
 
-    int *grid1_nnc_cells = ecl_kw_get_int_ptr(keyword1);
-    int *grid2_nnc_cells = ecl_kw_get_int_ptr(keyword2);
-    int nnc_count = ecl_kw_get_size(keyword2);
+    for (int bucket = 0; bucket < NNC_CELL_BUCKETS; bucket++)
+        bucket_offset[bucket + 1] += bucket_offset[bucket];
 
-    int nnc_index;
-    for (nnc_index = 0; nnc_index < nnc_count; nnc_index++) {
-        int grid1_cell_index = grid1_nnc_cells[nnc_index] - 1;
-        int grid2_cell_index = grid2_nnc_cells[nnc_index] - 1;
+    /* (block, nnc_index) pairs sorted by bucket. */
+    std::vector<std::pair<int, int>> bucket_nnc(bucket_offset.back());
+    {
+        std::vector<int> pos(bucket_offset.begin(), bucket_offset.end() - 1);
+        for (int block_nr = 0; block_nr < (int)blocks.size(); block_nr++) {
+            const auto &block = blocks[block_nr];
+            for (int nnc_index = 0; nnc_index < block.nnc_count; nnc_index++) {
+                unsigned cell_index = block.grid1_nnc_cells[nnc_index] - 1;
+                int bucket = cell_index % NNC_CELL_BUCKETS;
+                bucket_nnc[pos[bucket]++] = {block_nr, nnc_index};
+            }
+        }
+    }
 
-        /*
-    In the ECLIPSE output format grids with dual porosity are (to some
-    extent ...) modeled as two independent grids stacked on top of
-    eachother, where the fracture cells have global index in the range
-    [nx*ny*nz, 2*nx*ny*nz).
-
-    The physical connection between the matrix and the fractures in
-    cell nr c is modelled as an nnc: cell[c] -> cell[c + nx*ny*nz]. In
-    the ert ecl library we only have cells in the range [0,nx*ny*nz),
-    and fracture is a property of a cell. We therefore do not include
-    nnc connections involving fracture cells (i.e. cell_index >=
-    nx*ny*nz).
-  */
-        if ((FILEHEAD_SINGLE_POROSITY != grid1->dualp_flag) &&
-            ((grid1_cell_index >= grid1->size) ||
-             (grid2_cell_index >= grid2->size)))
-            break;
+#pragma omp parallel for schedule(dynamic)
+    for (int bucket = 0; bucket < NNC_CELL_BUCKETS; bucket++) {
+        for (int i = bucket_offset[bucket]; i < bucket_offset[bucket + 1];
+             i++) {
+            const auto &block = blocks[bucket_nnc[i].first];
+            int nnc_index = bucket_nnc[i].second;
+            int grid1_cell_index = block.grid1_nnc_cells[nnc_index] - 1;
+            int grid2_cell_index = block.grid2_nnc_cells[nnc_index] - 1;
 
-        {
             ecl_cell_type *grid1_cell =
-                ecl_grid_get_cell(grid1, grid1_cell_index);
-            ecl_grid_init_cell_nnc_info(grid1, grid1_cell_index);
-            nnc_info_add_nnc(grid1_cell->nnc_info, grid2->lgr_nr,
+                ecl_grid_get_cell(block.grid1, grid1_cell_index);
+            ecl_grid_init_cell_nnc_info(block.grid1, grid1_cell_index);
+            nnc_info_add_nnc(grid1_cell->nnc_info, block.grid2->lgr_nr,
                              grid2_cell_index, nnc_index);
         }
     }
 }
 
 /*
-  This function reads the non-neighbour connection data from file and initializes the grid structure with the the nnc data
+  This function reads the non-neighbour connection data from file and
+  initializes the grid structure with the the nnc data. The keywords
+  are loaded serially, whereas the nnc_info structures are populated
+  in parallel by ecl_grid_init_nnc_blocks().
 */
 static void ecl_grid_init_nnc(ecl_grid_type *main_grid,
                               ecl_file_type *ecl_file) {
     int num_nnchead_kw = ecl_file_get_num_named_kw(ecl_file, NNCHEAD_KW);
-    int i;
+    std::vector<ecl_grid_nnc_block_type> blocks;
 
     /*
     NB: There is a bug in Eclipse version 2015.1, for MPI runs with
@@ -2892,26 +3085,22 @@ static void ecl_grid_init_nnc(ecl_grid_type *main_grid,
            return;
   */
 
-    for (i = 0; i < num_nnchead_kw; i++) {
+    for (int i = 0; i < num_nnchead_kw; i++) {
         ecl_file_view_type *lgr_view =
             ecl_file_alloc_global_blockview(ecl_file, NNCHEAD_KW, i);
         ecl_kw_type *nnchead_kw =
             ecl_file_view_iget_named_kw(lgr_view, NNCHEAD_KW, 0);
         int lgr_nr = ecl_kw_iget_int(nnchead_kw, NNCHEAD_LGR_INDEX);
+        ecl_grid_type *grid =
+            (lgr_nr > 0) ? ecl_grid_get_lgr_from_lgr_nr(main_grid, lgr_nr)
+                         : main_grid;
 
         if (ecl_file_view_has_kw(lgr_view, NNC1_KW)) {
             const ecl_kw_type *nnc1 =
                 ecl_file_view_iget_named_kw(lgr_view, NNC1_KW, 0);
             const ecl_kw_type *nnc2 =
                 ecl_file_view_iget_named_kw(lgr_view, NNC2_KW, 0);
-
-            {
-                ecl_grid_type *grid =
-                    (lgr_nr > 0)
-                        ? ecl_grid_get_lgr_from_lgr_nr(main_grid, lgr_nr)
-                        : main_grid;
-                ecl_grid_init_nnc_cells(grid, grid, nnc1, nnc2);
-            }
+            blocks.push_back(ecl_grid_alloc_nnc_block(grid, grid, nnc1, nnc2));
         }
 
         if (ecl_file_view_has_kw(lgr_view, NNCL_KW)) {
@@ -2919,30 +3108,20 @@ static void ecl_grid_init_nnc(ecl_grid_type *main_grid,
                 ecl_file_view_iget_named_kw(lgr_view, NNCL_KW, 0);
             const ecl_kw_type *nncg =
                 ecl_file_view_iget_named_kw(lgr_view, NNCG_KW, 0);
-            {
-                ecl_grid_type *grid =
-                    (lgr_nr > 0)
-                        ? ecl_grid_get_lgr_from_lgr_nr(main_grid, lgr_nr)
-                        : main_grid;
-                ecl_grid_init_nnc_cells(main_grid, grid, nncg, nncl);
-            }
+            blocks.push_back(
+                ecl_grid_alloc_nnc_block(main_grid, grid, nncg, nncl));
         }
 
+        /* The keywords are owned by the ecl_file instance. */
         ecl_file_view_free(lgr_view);
     }
-}
 
-/*
-  This function reads the non-neighbour connection data for
-  amalgamated LGRs (that is, non-neighbour connections between two
-  LGRs) and initializes the grid structure with the nnc data.
-*/
-static void ecl_grid_init_nnc_amalgamated(ecl_grid_type *main_grid,
-                                          ecl_file_type *ecl_file) {
+    /*
+      The non-neighbour connection data for amalgamated LGRs (that is,
+      non-neighbour connections between two LGRs).
+    */
     int num_nncheada_kw = ecl_file_get_num_named_kw(ecl_file, NNCHEADA_KW);
-
-    int i;
-    for (i = 0; i < num_nncheada_kw; i++) {
+    for (int i = 0; i < num_nncheada_kw; i++) {
         ecl_kw_type *nncheada_kw =
             ecl_file_iget_named_kw(ecl_file, NNCHEADA_KW, i);
         int lgr_nr1 = ecl_kw_iget_int(nncheada_kw, NNCHEADA_ILOC1_INDEX);
@@ -2956,7 +3135,75 @@ static void ecl_grid_init_nnc_amalgamated(ecl_grid_type *main_grid,
         ecl_kw_type *nna1_kw = ecl_file_iget_named_kw(ecl_file, NNA1_KW, i);
         ecl_kw_type *nna2_kw = ecl_file_iget_named_kw(ecl_file, NNA2_KW, i);
 
-        ecl_grid_init_nnc_cells(lgr_grid1, lgr_grid2, nna1_kw, nna2_kw);
+        blocks.push_back(
+            ecl_grid_alloc_nnc_block(lgr_grid1, lgr_grid2, nna1_kw, nna2_kw));
+    }
+
+    ecl_grid_init_nnc_blocks(blocks);
+}
+
+/*
+  The keywords needed to create one grid from an EGRID file. All the
+  keywords are looked up, and thereby loaded, up front; the ecl_file
+  lookup is not thread safe, whereas creating the grids from the
+  keywords is - i.e. the LGRs can then be created in parallel.
+*/
+typedef struct {
+    const ecl_kw_type *filehead_kw; /* Main grid only */
+    const ecl_kw_type *gridhead_kw;
+    const ecl_kw_type *zcorn_kw;
+    const ecl_kw_type *coord_kw;
+    const ecl_kw_type *actnum_kw;   /* Can be NULL */
+    const ecl_kw_type *mapaxes_kw;  /* Can be NULL */
+    const ecl_kw_type *corsnum_kw;  /* Can be NULL */
+    const ecl_kw_type *gridunit_kw; /* Can be NULL */
+    const ecl_kw_type *lgrname_kw;  /* LGR only */
+    const ecl_kw_type *parent_kw;   /* LGR only - can be NULL */
+    const ecl_kw_type *hostnum_kw;  /* LGR only */
+} ecl_grid_egrid_kw_type;
+
+/*
+  If ext_actnum is present that is used as ACTNUM, and the file is not
+  checked for an ACTNUM keyword at all.
+*/
+static void ecl_grid_egrid_kw_init(ecl_grid_egrid_kw_type *egrid_kw,
+                                   const ecl_file_type *ecl_file, int grid_nr,
+                                   const int *ext_actnum) {
+    memset(egrid_kw, 0, sizeof *egrid_kw);
+    egrid_kw->gridhead_kw =
+        ecl_file_iget_named_kw(ecl_file, GRIDHEAD_KW, grid_nr);
+    egrid_kw->zcorn_kw = ecl_file_iget_named_kw(ecl_file, ZCORN_KW, grid_nr);
+    egrid_kw->coord_kw = ecl_file_iget_named_kw(ecl_file, COORD_KW, grid_nr);
+
+    if (!ext_actnum &&
+        ecl_file_get_num_named_kw(ecl_file, ACTNUM_KW) > grid_nr)
+        egrid_kw->actnum_kw =
+            ecl_file_iget_named_kw(ecl_file, ACTNUM_KW, grid_nr);
+
+    if (grid_nr == 0) {
+        egrid_kw->filehead_kw =
+            ecl_file_iget_named_kw(ecl_file, FILEHEAD_KW, grid_nr);
+
+        /* MAPAXES and COARSENING only apply to the global grid. */
+        if (ecl_file_has_kw(ecl_file, MAPAXES_KW))
+            egrid_kw->mapaxes_kw =
+                ecl_file_iget_named_kw(ecl_file, MAPAXES_KW, 0);
+
+        if (ecl_file_has_kw(ecl_file, CORSNUM_KW))
+            egrid_kw->corsnum_kw =
+                ecl_file_iget_named_kw(ecl_file, CORSNUM_KW, 0);
+
+        if (ecl_file_has_kw(ecl_file, GRIDUNIT_KW))
+            egrid_kw->gridunit_kw =
+                ecl_file_iget_named_kw(ecl_file, GRIDUNIT_KW, 0);
+    } else {
+        egrid_kw->lgrname_kw =
+            ecl_file_iget_named_kw(ecl_file, LGR_KW, grid_nr - 1);
+        if (ecl_file_has_kw(ecl_file, LGR_PARENT_KW))
+            egrid_kw->parent_kw =
+                ecl_file_iget_named_kw(ecl_file, LGR_PARENT_KW, grid_nr - 1);
+        egrid_kw->hostnum_kw =
+            ecl_file_iget_named_kw(ecl_file, HOSTNUM_KW, grid_nr - 1);
     }
 }
 
@@ -2974,63 +3221,35 @@ static void ecl_grid_init_nnc_amalgamated(ecl_grid_type *main_grid,
    support LGRs.
 */
 
-static ecl_grid_type *ecl_grid_alloc_EGRID__(ecl_grid_type *main_grid,
-                                             const ecl_file_type *ecl_file,
-                                             int grid_nr, bool apply_mapaxes,
-                                             const int *ext_actnum) {
-    ecl_kw_type *gridhead_kw =
-        ecl_file_iget_named_kw(ecl_file, GRIDHEAD_KW, grid_nr);
-    ecl_kw_type *zcorn_kw = ecl_file_iget_named_kw(ecl_file, ZCORN_KW, grid_nr);
-    ecl_kw_type *coord_kw = ecl_file_iget_named_kw(ecl_file, COORD_KW, grid_nr);
-    ecl_kw_type *corsnum_kw = NULL;
-    ecl_kw_type *actnum_kw = NULL;
-    ecl_kw_type *gridunit_kw = NULL;
-    ecl_kw_type *mapaxes_kw = NULL;
+static ecl_grid_type *
+ecl_grid_alloc_EGRID__(ecl_grid_type *main_grid,
+                       const ecl_grid_egrid_kw_type *egrid_kw,
+                       bool apply_mapaxes, const int *ext_actnum) {
     int dualp_flag;
     int eclipse_version;
-    if (grid_nr == 0) {
-        ecl_kw_type *filehead_kw =
-            ecl_file_iget_named_kw(ecl_file, FILEHEAD_KW, grid_nr);
-        dualp_flag = ecl_kw_iget_int(filehead_kw, FILEHEAD_DUALP_INDEX);
-        eclipse_version = ecl_kw_iget_int(filehead_kw, FILEHEAD_YEAR_INDEX);
+    if (main_grid == NULL) {
+        dualp_flag =
+            ecl_kw_iget_int(egrid_kw->filehead_kw, FILEHEAD_DUALP_INDEX);
+        eclipse_version =
+            ecl_kw_iget_int(egrid_kw->filehead_kw, FILEHEAD_YEAR_INDEX);
     } else {
         dualp_flag = main_grid->dualp_flag;
         eclipse_version = main_grid->eclipse_version;
     }
 
-    /*
-    If ext_actnum is present that is used as ACTNUM, and the file is not checked
-    for an ACTNUM keyword at all.
-  */
-    const int *actnum_data = NULL;
-    if (ext_actnum)
-        actnum_data = ext_actnum;
-    else {
-        if (ecl_file_get_num_named_kw(ecl_file, ACTNUM_KW) > grid_nr) {
-            actnum_kw = ecl_file_iget_named_kw(ecl_file, ACTNUM_KW, grid_nr);
-            actnum_data = ecl_kw_get_int_ptr(actnum_kw);
-        }
-    }
-
-    if (grid_nr == 0) {
-        /* MAPAXES and COARSENING only apply to the global grid. */
-        if (ecl_file_has_kw(ecl_file, MAPAXES_KW))
-            mapaxes_kw = ecl_file_iget_named_kw(ecl_file, MAPAXES_KW, 0);
-
-        if (ecl_file_has_kw(ecl_file, CORSNUM_KW))
-            corsnum_kw = ecl_file_iget_named_kw(ecl_file, CORSNUM_KW, 0);
-
-        if (ecl_file_has_kw(ecl_file, GRIDUNIT_KW))
-            gridunit_kw = ecl_file_iget_named_kw(ecl_file, GRIDUNIT_KW, 0);
-    }
+    const int *actnum_data = ext_actnum;
+    if (egrid_kw->actnum_kw)
+        actnum_data = ecl_kw_get_int_ptr(egrid_kw->actnum_kw);
 
     {
         ecl_grid_type *ecl_grid = ecl_grid_alloc_GRDECL_kw__(
-            main_grid, dualp_flag, apply_mapaxes, gridhead_kw, zcorn_kw,
-            coord_kw, gridunit_kw, mapaxes_kw, corsnum_kw, actnum_data);
+            main_grid, dualp_flag, apply_mapaxes, egrid_kw->gridhead_kw,
+            egrid_kw->zcorn_kw, egrid_kw->coord_kw, egrid_kw->gridunit_kw,
+            egrid_kw->mapaxes_kw, egrid_kw->corsnum_kw, actnum_data);
 
-        if (ECL_GRID_MAINGRID_LGR_NR != grid_nr)
-            ecl_grid_set_lgr_name_EGRID(ecl_grid, ecl_file, grid_nr);
+        if (main_grid != NULL)
+            ecl_grid_set_lgr_name_EGRID(ecl_grid, egrid_kw->lgrname_kw,
+                                        egrid_kw->parent_kw);
         ecl_grid->eclipse_version = eclipse_version;
         return ecl_grid;
     }
@@ -3054,33 +3273,47 @@ static ecl_grid_type *ecl_grid_alloc_EGRID_all_grids(const char *grid_file,
         ecl_file_type *ecl_file = ecl_file_open(grid_file, 0);
         if (ecl_file) {
             int num_grid = ecl_file_get_num_named_kw(ecl_file, GRIDHEAD_KW);
+            std::vector<ecl_grid_egrid_kw_type> egrid_kw(num_grid);
+            for (int grid_nr = 0; grid_nr < num_grid; grid_nr++)
+                ecl_grid_egrid_kw_init(&egrid_kw[grid_nr], ecl_file, grid_nr,
+                                       (grid_nr == 0) ? ext_actnum : NULL);
+
             ecl_grid_type *main_grid = ecl_grid_alloc_EGRID__(
-                NULL, ecl_file, 0, apply_mapaxes, ext_actnum);
-            int grid_nr;
+                NULL, &egrid_kw[0], apply_mapaxes, ext_actnum);
 
-            for (grid_nr = 1; grid_nr < num_grid; grid_nr++) {
+            /*
+              The LGRs only depend on the main grid and their own
+              keywords, and are created in parallel; they are then added
+              to the main grid and installed in their host grids in file
+              order, which guarantees that a parent LGR is installed
+              before its children.
+            */
+            std::vector<ecl_grid_type *> lgr_grids(num_grid);
+#pragma omp parallel for schedule(dynamic)
+            for (int grid_nr = 1; grid_nr < num_grid; grid_nr++)
                 // The apply_mapaxes argument is ignored for LGR -
                 //   it inherits from parent anyway.
-                ecl_grid_type *lgr_grid = ecl_grid_alloc_EGRID__(
-                    main_grid, ecl_file, grid_nr, false, NULL);
+                lgr_grids[grid_nr] = ecl_grid_alloc_EGRID__(
+                    main_grid, &egrid_kw[grid_nr], false, NULL);
+
+            for (int grid_nr = 1; grid_nr < num_grid; grid_nr++) {
+                ecl_grid_type *lgr_grid = lgr_grids[grid_nr];
                 ecl_grid_add_lgr(main_grid, lgr_grid);
                 {
                     ecl_grid_type *host_grid;
-                    ecl_kw_type *hostnum_kw = ecl_file_iget_named_kw(
-                        ecl_file, HOSTNUM_KW, grid_nr - 1);
                     if (lgr_grid->parent_name == NULL)
                         host_grid = main_grid;
                     else
                         host_grid =
                             ecl_grid_get_lgr(main_grid, lgr_grid->parent_name);
 
-                    ecl_grid_install_lgr_EGRID(host_grid, lgr_grid,
-                                               ecl_kw_get_int_ptr(hostnum_kw));
+                    ecl_grid_install_lgr_EGRID(
+                        host_grid, lgr_grid,
+                        ecl_kw_get_int_ptr(egrid_kw[grid_nr].hostnum_kw));
                 }
             }
             main_grid->name = util_alloc_string_copy(grid_file);
             ecl_grid_init_nnc(main_grid, ecl_file);
-            ecl_grid_init_nnc_amalgamated(main_grid, ecl_file);
 
             ecl_file_close(ecl_file);
             return main_grid;
@@ -3920,7 +4153,22 @@ static bool ecl_grid_compare_cells(const ecl_grid_type *g1,
         bool this_equal = true;
         ecl_cell_type *c1 = ecl_grid_get_cell(g1, g);
         ecl_cell_type *c2 = ecl_grid_get_cell(g2, g);
-        ecl_cell_compare(c1, c2, include_nnc, &this_equal);
+        /*
+          With CSR NNC storage the nnc_info is built for the comparison
+          and freed again, instead of being cached on the cell.
+        */
+        nnc_info_type *tmp1 = NULL;
+        nnc_info_type *tmp2 = NULL;
+        const nnc_info_type *nnc_info1 = c1->nnc_info;
+        const nnc_info_type *nnc_info2 = c2->nnc_info;
+        if (g1->nnc_store && !nnc_info1)
+            nnc_info1 = tmp1 = ecl_grid_alloc_cell_nnc_info(g1, g);
+        if (g2->nnc_store && !nnc_info2)
+            nnc_info2 = tmp2 = ecl_grid_alloc_cell_nnc_info(g2, g);
+
+        ecl_cell_compare(c1, c2, false, &this_equal);
+        if (include_nnc && this_equal)
+            this_equal = nnc_info_equal(nnc_info1, nnc_info2);
 
         if (!this_equal) {
             if (verbose) {
@@ -3929,7 +4177,7 @@ static bool ecl_grid_compare_cells(const ecl_grid_type *g1,
 
                 printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d "
                        "Volume:%g \n",
-                       g, i, j, k, nnc_info_equal(c1->nnc_info, c2->nnc_info),
+                       g, i, j, k, nnc_info_equal(nnc_info1, nnc_info2),
                        ecl_cell_get_volume(c1));
                 printf("-------------------------------------------------------"
                        "----------\n");
@@ -3941,8 +4189,15 @@ static bool ecl_grid_compare_cells(const ecl_grid_type *g1,
                        "----------\n");
             }
             equal = false;
-            break;
         }
+
+        if (tmp1)
+            nnc_info_free(tmp1);
+        if (tmp2)
+            nnc_info_free(tmp2);
+
+        if (!equal)
+            break;
     }
     return equal;
 }
@@ -4373,64 +4628,178 @@ int ecl_grid_get_global_index_from_xy_bottom(const ecl_grid_type *ecl_grid,
     return ecl_grid_get_global_index_from_xy(ecl_grid, 0, true, x, y);
 }
 
-static void ecl_grid_clear_visited(ecl_grid_type *grid) {
-    if (grid->visited == NULL)
-        grid->visited = (bool *)util_calloc(grid->size, sizeof *grid->visited);
+static void ecl_grid_search_node_init_leaf(ecl_grid_search_node_type &node,
+                                           const ecl_grid_type *grid,
+                                           const int *cells) {
+    for (int d = 0; d < 3; d++) {
+        node.min[d] = INFINITY;
+        node.max[d] = -INFINITY;
+    }
+    node.min_index = INT_MAX;
+
+    for (int c = 0; c < node.count; c++) {
+        const ecl_cell_type *cell = ecl_grid_get_cell(grid, cells[c]);
+        for (int corner = 0; corner < 8; corner++) {
+            const point_type &p = cell->corner_list[corner];
+            node.min[0] = util_double_min(node.min[0], p.x);
+            node.max[0] = util_double_max(node.max[0], p.x);
+            node.min[1] = util_double_min(node.min[1], p.y);
+            node.max[1] = util_double_max(node.max[1], p.y);
+            node.min[2] = util_double_min(node.min[2], p.z);
+            node.max[2] = util_double_max(node.max[2], p.z);
+        }
+        node.min_index = util_int_min(node.min_index, cells[c]);
+    }
+}
+
+/*
+  Will build the subtree of node @node_index by splitting the cells at
+  the median cell center along the longest axis of the cell centers.
+*/
+static void ecl_grid_search_tree_build(ecl_grid_search_tree_type *tree,
+                                       const ecl_grid_type *grid,
+                                       const std::vector<float> &centers,
+                                       int node_index) {
+    int first = tree->nodes[node_index].first;
+    int count = tree->nodes[node_index].count;
+    int *cells = &tree->cells[first];
+
+    if (count <= SEARCH_TREE_LEAF_SIZE) {
+        ecl_grid_search_node_init_leaf(tree->nodes[node_index], grid, cells);
+        return;
+    }
 
+    int axis = 0;
     {
-        int i;
-        for (i = 0; i < grid->size; i++)
-            grid->visited[i] = false;
+        float min[3] = {INFINITY, INFINITY, INFINITY};
+        float max[3] = {-INFINITY, -INFINITY, -INFINITY};
+        for (int c = 0; c < count; c++) {
+            for (int d = 0; d < 3; d++) {
+                min[d] = std::min(min[d], centers[3 * (size_t)cells[c] + d]);
+                max[d] = std::max(max[d], centers[3 * (size_t)cells[c] + d]);
+            }
+        }
+        for (int d = 1; d < 3; d++) {
+            if (max[d] - min[d] > max[axis] - min[axis])
+                axis = d;
+        }
+    }
+
+    int half = count / 2;
+    std::nth_element(cells, cells + half, cells + count,
+                     [&centers, axis](int g1, int g2) {
+                         return centers[3 * (size_t)g1 + axis] <
+                                centers[3 * (size_t)g2 + axis];
+                     });
+
+    int child = static_cast<int>(tree->nodes.size());
+    tree->nodes.resize(tree->nodes.size() + 2);
+    tree->nodes[child] = {{0, 0, 0}, {0, 0, 0}, first, half, -1, INT_MAX};
+    tree->nodes[child + 1] = {
+        {0, 0, 0}, {0, 0, 0}, first + half, count - half, -1, INT_MAX};
+    ecl_grid_search_tree_build(tree, grid, centers, child);
+    ecl_grid_search_tree_build(tree, grid, centers, child + 1);
+
+    ecl_grid_search_node_type &node = tree->nodes[node_index];
+    const ecl_grid_search_node_type &left = tree->nodes[child];
+    const ecl_grid_search_node_type &right = tree->nodes[child + 1];
+    for (int d = 0; d < 3; d++) {
+        node.min[d] = util_double_min(left.min[d], right.min[d]);
+        node.max[d] = util_double_max(left.max[d], right.max[d]);
+    }
+    node.child = child;
+    node.min_index = util_int_min(left.min_index, right.min_index);
+}
+
+static ecl_grid_search_tree_type *
+ecl_grid_alloc_search_tree(const ecl_grid_type *grid) {
+    auto *tree = new ecl_grid_search_tree_type();
+    std::vector<float> centers(3 * (size_t)grid->size);
+
+    for (int global_index = 0; global_index < grid->size; global_index++) {
+        ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
+        if (GET_CELL_FLAG(cell, CELL_FLAG_TAINTED))
+            continue;
+
+        ecl_cell_assert_center(cell);
+        centers[3 * (size_t)global_index] = cell->center.x;
+        centers[3 * (size_t)global_index + 1] = cell->center.y;
+        centers[3 * (size_t)global_index + 2] = cell->center.z;
+        tree->cells.push_back(global_index);
+    }
+
+    if (!tree->cells.empty()) {
+        tree->nodes.reserve(4 * tree->cells.size() / SEARCH_TREE_LEAF_SIZE +
+                            1);
+        tree->nodes.push_back({{0, 0, 0},
+                               {0, 0, 0},
+                               0,
+                               static_cast<int>(tree->cells.size()),
+                               -1,
+                               INT_MAX});
+        ecl_grid_search_tree_build(tree, grid, centers, 0);
     }
+    return tree;
 }
 
 /*
-   Box coordinates are not inclusive, i.e. [i1,i2)
+  The search tree is built on first use; std::call_once() ensures that
+  concurrent searches in a grid without a tree build it only once.
 */
-static int ecl_grid_box_contains_xyz(const ecl_grid_type *grid, int i1, int i2,
-                                     int j1, int j2, int k1, int k2,
-                                     const point_type *p) {
+static const ecl_grid_search_tree_type *
+ecl_grid_get_search_tree(ecl_grid_type *grid) {
+    std::call_once(grid->search_tree_once, [grid]() {
+        grid->search_tree.reset(ecl_grid_alloc_search_tree(grid));
+    });
+    return grid->search_tree.get();
+}
 
-    int i, j, k;
-    int global_index = -1;
-    for (k = k1; k < k2; k++)
-        for (j = j1; j < j2; j++)
-            for (i = i1; i < i2; i++) {
-                global_index = ecl_grid_get_global_index3(grid, i, j, k);
-                if (!grid->visited[global_index]) {
-                    grid->visited[global_index] = true;
-                    if (ecl_grid_cell_contains_xyz1(grid, global_index, p->x,
-                                                    p->y, p->z)) {
-                        return global_index;
-                    }
-                }
-            }
-    return -1; /* Returning -1; did not find xyz. */
+static bool
+ecl_grid_search_node_contains(const ecl_grid_search_node_type &node,
+                              double x, double y, double z) {
+    return (x >= node.min[0] && x <= node.max[0] && y >= node.min[1] &&
+            y <= node.max[1] && z >= node.min[2] && z <= node.max[2]);
 }
 
-/**
- * Search for given xyz coordinate around global start_index in a box of size bx
- */
-static int ecl_grid_get_global_index_from_xyz_around_box(
-    ecl_grid_type *grid, double x, double y, double z, int start_index, int bx,
-    point_type *p) {
-    /* Try neighbours */
-    int i, j, k;
-    int i1, i2, j1, j2, k1, k2;
-    int nx, ny, nz;
-    ecl_grid_get_dims(grid, &nx, &ny, &nz, NULL);
-    ecl_grid_get_ijk1(grid, start_index, &i, &j, &k);
+/*
+  Will return the lowest global index of the cells containing the point
+  (x,y,z), i.e. the same cell as a linear scan through the grid would
+  find, or -1 if no cell contains the point.
+*/
+static int ecl_grid_search_tree_find(const ecl_grid_type *grid,
+                                     const ecl_grid_search_tree_type *tree,
+                                     double x, double y, double z) {
+    int global_index = -1;
+    std::vector<int> stack;
+
+    if (!tree->nodes.empty())
+        stack.push_back(0);
+
+    while (!stack.empty()) {
+        const ecl_grid_search_node_type &node = tree->nodes[stack.back()];
+        stack.pop_back();
 
-    i1 = util_int_max(0, i - bx);
-    j1 = util_int_max(0, j - bx);
-    k1 = util_int_max(0, k - bx);
+        if (global_index >= 0 && node.min_index > global_index)
+            continue;
+
+        if (!ecl_grid_search_node_contains(node, x, y, z))
+            continue;
+
+        if (node.child >= 0) {
+            stack.push_back(node.child);
+            stack.push_back(node.child + 1);
+            continue;
+        }
 
-    i2 = util_int_min(nx, i + bx);
-    j2 = util_int_min(ny, j + bx);
-    k2 = util_int_min(nz, k + bx);
+        for (int c = node.first; c < node.first + node.count; c++) {
+            int index = tree->cells[c];
+            if (global_index >= 0 && index > global_index)
+                continue;
 
-    int global_index =
-        ecl_grid_box_contains_xyz(grid, i1, i2, j1, j2, k1, k2, p);
+            if (ecl_grid_cell_contains_xyz1(grid, index, x, y, z))
+                global_index = index;
+        }
+    }
     return global_index;
 }
 
@@ -4439,58 +4808,110 @@ static int ecl_grid_get_global_index_from_xyz_around_box(
    world coordinates (x,y,z), if no cell can be found the function
    will return -1.
 
-   The function is basically based on scanning through the cells in
-   natural (i fastest) order and querying whether the cell[i,j,k]
-   contains the (x,y,z) point; not very elegant :-(
+   The search is based on a bounding volume hierarchy over the cell
+   bounding boxes, which is built the first time the function is
+   called for the grid. If several cells contain the point - which can
+   happen for distorted cells - the cell with the lowest global index
+   is returned, i.e. the same cell a linear scan in natural (i fastest)
+   order would find.
 
    The last argument - 'start_index' - can be used to speed things up
    a bit if you have reasonable guess of where the the (x,y,z) is
-   located. The start_index value is used as this:
-
-
-     start_index == 0: I do not have a clue, start from the beginning
-        and scan through the grid linearly.
-
-
-     start_index != 0:
-        1. Check the cell 'start_index'.
-        2. Check the neighbours (i +/- 1, j +/- 1, k +/- 1 ).
-        3. Give up and do a linear search starting from start_index.
-
+   located; if start_index >= 0 and the cell 'start_index' contains the
+   point, start_index is returned without consulting the search tree.
 */
 int ecl_grid_get_global_index_from_xyz(ecl_grid_type *grid, double x, double y,
                                        double z, int start_index) {
-    int global_index;
-    point_type p;
-    point_set(&p, x, y, z);
-    ecl_grid_clear_visited(grid);
+    if (start_index >= 0 &&
+        ecl_grid_cell_contains_xyz1(grid, start_index, x, y, z))
+        return start_index;
 
-    if (start_index >= 0) {
-        /* Try start index */
-        if (ecl_grid_cell_contains_xyz1(grid, start_index, x, y, z))
-            return start_index;
-        else {
-            /* Try boxes 2, 4, 8, ..., 64  */
-            for (int bx = 1; bx <= 6; bx++) {
-                global_index = ecl_grid_get_global_index_from_xyz_around_box(
-                    grid, x, y, z, start_index, 1 << bx, &p);
-                if (global_index >= 0)
-                    return global_index;
-            }
+    return ecl_grid_search_tree_find(grid, ecl_grid_get_search_tree(grid), x,
+                                     y, z);
+}
+
+/*
+  Will locate the @num_points points (x[i], y[i], z[i]) in the grid,
+  and store the global index of the containing cell, or -1, in
+  global_index[i]. The points are split in contiguous blocks across
+  threads, and within a block the cell found for one point is checked
+  first for the next point; i.e. the function is fastest when
+  consecutive points are close, as is the case for points along a well
+  trajectory.
+
+  The search itself does not modify the grid, so this function can be
+  called concurrently on the same grid; see ecl_grid_freeze().
+*/
+void ecl_grid_get_global_index_from_xyz_batch(ecl_grid_type *grid,
+                                              int num_points, const double *x,
+                                              const double *y, const double *z,
+                                              int *global_index) {
+    const ecl_grid_search_tree_type *tree = ecl_grid_get_search_tree(grid);
+#pragma omp parallel
+    {
+        int start_index = -1;
+
+#pragma omp for schedule(static)
+        for (int i = 0; i < num_points; i++) {
+            int index = -1;
+            if (start_index >= 0 &&
+                ecl_grid_cell_contains_xyz1(grid, start_index, x[i], y[i],
+                                            z[i]))
+                index = start_index;
+            else
+                index = ecl_grid_search_tree_find(grid, tree, x[i], y[i], z[i]);
+
+            global_index[i] = index;
+            if (index >= 0)
+                start_index = index;
         }
     }
+}
 
-    /*
-    OK - the attempted shortcuts did not pay off. Perform full linear search.
-  */
+/*
+  About threads
+  -------------
+
+  Several of the read only queries on a grid fill caches on first use:
+  the cell centers are calculated when a center is first needed, and
+  the search tree used by ecl_grid_get_global_index_from_xyz() is built
+  on the first search. Concurrent queries can therefore write to the
+  same cell from different threads.
+
+  ecl_grid_freeze() calculates all the cell centers and builds the
+  search tree, for the grid and all its LGRs. After that the queries
+  below only read the grid, and one grid instance can be shared by all
+  threads:
+
+    - ijk / global / active index lookups.
+    - Cell centers, corners, dimensions, depth, thickness and volume.
+    - ecl_grid_cell_contains_xyz1/3(), ecl_grid_get_global_index_from_xyz()
+      and ecl_grid_get_global_index_from_xyz_batch(). The 'start_index'
+      hint is passed in by the caller, so each thread keeps its own.
+    - ecl_grid_get_cell_nnc_info1(); with CSR NNC storage the nnc_info
+      is created under a lock.
+
+  Functions which modify the grid, like ecl_grid_add_self_nnc(), the
+  ecl_grid_init_compact_xxx() functions and the blocking functions
+  ecl_grid_init_blocking() / ecl_grid_block_value_3d(), must not be
+  called concurrently with anything else.
+*/
+
+void ecl_grid_freeze(ecl_grid_type *grid) {
+#pragma omp parallel for schedule(static)
+    for (int global_index = 0; global_index < grid->size; global_index++)
+        ecl_cell_assert_center(ecl_grid_get_cell(grid, global_index));
 
-    global_index = -1;
+    ecl_grid_get_search_tree(grid);
 
-    for (int index = 0; index < grid->size; index++) {
-        if (ecl_grid_cell_contains_xyz1(grid, index, x, y, z))
-            return index;
+    if (grid->LGR_list) {
+        for (int lgr_index = 0; lgr_index < vector_get_size(grid->LGR_list);
+             lgr_index++) {
+            ecl_grid_type *lgr =
+                (ecl_grid_type *)vector_iget(grid->LGR_list, lgr_index);
+            ecl_grid_freeze(lgr);
+        }
     }
-    return -1;
 }
 
 bool ecl_grid_get_ijk_from_xyz(ecl_grid_type *grid, double x, double y,
@@ -4676,7 +5097,6 @@ void ecl_grid_free(ecl_grid_type *grid) {
 
     vector_free(grid->coarse_cells);
     free(grid->parent_name);
-    free(grid->visited);
     free(grid->name);
     delete grid;
 }
@@ -4686,9 +5106,234 @@ void ecl_grid_free__(void *arg) {
     ecl_grid_free(ecl_grid);
 }
 
+/*
+  Will build a compact structure-of-arrays copy of the cell geometry:
+  the corners as separate x, y and z arrays, and the precomputed cell
+  centers and volumes. When present the geometry accessors like
+  ecl_grid_get_xyz1(), ecl_grid_get_cell_corner_xyz1() and
+  ecl_grid_get_cell_volume1() are served from the compact store, so a
+  sweep over the whole grid reads contiguous memory instead of the full
+  ecl_cell_type records. The store is built for the LGRs as well.
+
+  The cells keep their own copy of the geometry, so the store costs
+  roughly 28 doubles per cell on top of the ecl_cell_type records; call
+  ecl_grid_free_compact_geometry() when the sweeps are done.
+*/
+
+void ecl_grid_init_compact_geometry(ecl_grid_type *grid) {
+    auto geometry = std::make_unique<ecl_grid_geometry_type>();
+    size_t size = grid->size;
+
+    geometry->corner_x.resize(8 * size);
+    geometry->corner_y.resize(8 * size);
+    geometry->corner_z.resize(8 * size);
+    geometry->center_x.resize(size);
+    geometry->center_y.resize(size);
+    geometry->center_z.resize(size);
+    geometry->volume.resize(size);
+
+    for (int global_index = 0; global_index < grid->size; global_index++) {
+        ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
+        size_t offset = 8 * (size_t)global_index;
+
+        for (int c = 0; c < 8; c++) {
+            geometry->corner_x[offset + c] = cell->corner_list[c].x;
+            geometry->corner_y[offset + c] = cell->corner_list[c].y;
+            geometry->corner_z[offset + c] = cell->corner_list[c].z;
+        }
+
+        ecl_cell_assert_center(cell);
+        geometry->center_x[global_index] = cell->center.x;
+        geometry->center_y[global_index] = cell->center.y;
+        geometry->center_z[global_index] = cell->center.z;
+    }
+    ecl_grid_compute_cell_volumes(grid, false, geometry->volume.data());
+    grid->geometry = std::move(geometry);
+
+    if (grid->LGR_list) {
+        for (int lgr_index = 0; lgr_index < vector_get_size(grid->LGR_list);
+             lgr_index++) {
+            ecl_grid_type *lgr =
+                (ecl_grid_type *)vector_iget(grid->LGR_list, lgr_index);
+            ecl_grid_init_compact_geometry(lgr);
+        }
+    }
+}
+
+void ecl_grid_free_compact_geometry(ecl_grid_type *grid) {
+    grid->geometry.reset();
+    if (grid->LGR_list) {
+        for (int lgr_index = 0; lgr_index < vector_get_size(grid->LGR_list);
+             lgr_index++) {
+            ecl_grid_type *lgr =
+                (ecl_grid_type *)vector_iget(grid->LGR_list, lgr_index);
+            ecl_grid_free_compact_geometry(lgr);
+        }
+    }
+}
+
+bool ecl_grid_has_compact_geometry(const ecl_grid_type *grid) {
+    return (grid->geometry != nullptr);
+}
+
+/*
+  Creates the nnc_info structure of one cell from the CSR storage; will
+  return NULL if the cell has no NNC connections.
+*/
+
+static nnc_info_type *ecl_grid_alloc_cell_nnc_info(const ecl_grid_type *grid,
+                                                   int global_index) {
+    const ecl_grid_nnc_store_type *store = grid->nnc_store.get();
+    int first = store->row_offset[global_index];
+    int last = store->row_offset[global_index + 1];
+    if (first == last)
+        return NULL;
+
+    nnc_info_type *nnc_info = nnc_info_alloc(grid->lgr_nr);
+    for (int i = first; i < last; i++)
+        nnc_info_add_nnc(nnc_info, store->lgr_nr[i], store->global_index[i],
+                         store->nnc_index[i]);
+    return nnc_info;
+}
+
+/*
+  Will move the NNC connections of the grid from the per cell nnc_info
+  structures to compressed sparse row storage: one row offset per cell,
+  and flat arrays with the lgr_nr, global_index and nnc_index of all the
+  connections. This replaces a large number of small heap allocations
+  with four arrays, and lets ecl_nnc_export() and
+  ecl_nnc_geometry_alloc() visit all connections with a linear scan.
+
+  The nnc_info structures are released. When ecl_grid_get_cell_nnc_info1()
+  is called for a cell, its nnc_info is recreated from the CSR storage
+  and kept until the grid is freed. The storage is built for the LGRs
+  as well.
+*/
+
+void ecl_grid_init_compact_nnc(ecl_grid_type *grid) {
+    if (!grid->nnc_store) {
+        auto store = std::make_unique<ecl_grid_nnc_store_type>();
+        int num_nnc = 0;
+
+        store->row_offset.resize(grid->size + 1);
+        for (int global_index = 0; global_index < grid->size; global_index++) {
+            const ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
+            store->row_offset[global_index] = num_nnc;
+            if (cell->nnc_info)
+                num_nnc += nnc_info_get_total_size(cell->nnc_info);
+        }
+        store->row_offset[grid->size] = num_nnc;
+
+        store->lgr_nr.reserve(num_nnc);
+        store->global_index.reserve(num_nnc);
+        store->nnc_index.reserve(num_nnc);
+        for (int global_index = 0; global_index < grid->size; global_index++) {
+            const ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
+            if (!cell->nnc_info)
+                continue;
+
+            for (int lgr_index = 0;
+                 lgr_index < nnc_info_get_size(cell->nnc_info); lgr_index++) {
+                const nnc_vector_type *nnc_vector =
+                    nnc_info_iget_vector(cell->nnc_info, lgr_index);
+                const std::vector<int> &grid_index_list =
+                    nnc_vector_get_grid_index_list(nnc_vector);
+                const std::vector<int> &nnc_index_list =
+                    nnc_vector_get_nnc_index_list(nnc_vector);
+                int lgr_nr = nnc_vector_get_lgr_nr(nnc_vector);
+
+                store->lgr_nr.insert(store->lgr_nr.end(),
+                                     grid_index_list.size(), lgr_nr);
+                store->global_index.insert(store->global_index.end(),
+                                           grid_index_list.begin(),
+                                           grid_index_list.end());
+                store->nnc_index.insert(store->nnc_index.end(),
+                                        nnc_index_list.begin(),
+                                        nnc_index_list.end());
+            }
+        }
+        grid->nnc_store = std::move(store);
+    }
+
+    for (int global_index = 0; global_index < grid->size; global_index++) {
+        ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
+        if (cell->nnc_info) {
+            nnc_info_free(cell->nnc_info);
+            cell->nnc_info = NULL;
+        }
+    }
+
+    if (grid->LGR_list) {
+        for (int lgr_index = 0; lgr_index < vector_get_size(grid->LGR_list);
+             lgr_index++) {
+            ecl_grid_type *lgr =
+                (ecl_grid_type *)vector_iget(grid->LGR_list, lgr_index);
+            ecl_grid_init_compact_nnc(lgr);
+        }
+    }
+}
+
+/*
+  Recreates the nnc_info structures of all cells from the CSR storage
+  and drops the storage.
+*/
+
+static void ecl_grid_release_nnc_store(ecl_grid_type *grid) {
+    if (!grid->nnc_store)
+        return;
+
+    for (int global_index = 0; global_index < grid->size; global_index++) {
+        ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
+        if (!cell->nnc_info)
+            cell->nnc_info = ecl_grid_alloc_cell_nnc_info(grid, global_index);
+    }
+    grid->nnc_store.reset();
+}
+
+void ecl_grid_free_compact_nnc(ecl_grid_type *grid) {
+    ecl_grid_release_nnc_store(grid);
+    if (grid->LGR_list) {
+        for (int lgr_index = 0; lgr_index < vector_get_size(grid->LGR_list);
+             lgr_index++) {
+            ecl_grid_type *lgr =
+                (ecl_grid_type *)vector_iget(grid->LGR_list, lgr_index);
+            ecl_grid_free_compact_nnc(lgr);
+        }
+    }
+}
+
+bool ecl_grid_has_compact_nnc(const ecl_grid_type *grid) {
+    return (grid->nnc_store != nullptr);
+}
+
+bool ecl_grid_get_compact_nnc(const ecl_grid_type *grid,
+                              ecl_grid_nnc_csr_type *csr) {
+    const ecl_grid_nnc_store_type *store = grid->nnc_store.get();
+    if (!store)
+        return false;
+
+    csr->size = grid->size;
+    csr->row_offset = store->row_offset.data();
+    csr->lgr_nr = store->lgr_nr.data();
+    csr->global_index = store->global_index.data();
+    csr->nnc_index = store->nnc_index.data();
+    return true;
+}
+
 void ecl_grid_get_distance(const ecl_grid_type *grid, int global_index1,
                            int global_index2, double *dx, double *dy,
                            double *dz) {
+    if (grid->geometry) {
+        const ecl_grid_geometry_type *geometry = grid->geometry.get();
+        *dx = geometry->center_x[global_index1] -
+              geometry->center_x[global_index2];
+        *dy = geometry->center_y[global_index1] -
+              geometry->center_y[global_index2];
+        *dz = geometry->center_z[global_index1] -
+              geometry->center_z[global_index2];
+        return;
+    }
+
     ecl_cell_type *cell1 = ecl_grid_get_cell(grid, global_index1);
     ecl_cell_type *cell2 = ecl_grid_get_cell(grid, global_index2);
 
@@ -4892,6 +5537,13 @@ void ecl_grid_get_ijk1A(const ecl_grid_type *ecl_grid, int active_index, int *i,
 
 void ecl_grid_get_xyz1(const ecl_grid_type *grid, int global_index,
                        double *xpos, double *ypos, double *zpos) {
+    if (grid->geometry) {
+        *xpos = grid->geometry->center_x[global_index];
+        *ypos = grid->geometry->center_y[global_index];
+        *zpos = grid->geometry->center_z[global_index];
+        return;
+    }
+
     ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
     ecl_cell_assert_center(cell);
     {
@@ -4917,6 +5569,14 @@ void ecl_grid_get_cell_corner_xyz1(const ecl_grid_type *grid, int global_index,
                                    int corner_nr, double *xpos, double *ypos,
                                    double *zpos) {
     if ((corner_nr >= 0) && (corner_nr <= 7)) {
+        if (grid->geometry) {
+            size_t corner_index = 8 * (size_t)global_index + corner_nr;
+            *xpos = grid->geometry->corner_x[corner_index];
+            *ypos = grid->geometry->corner_y[corner_index];
+            *zpos = grid->geometry->corner_z[corner_index];
+            return;
+        }
+
         const ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
         const point_type point = cell->corner_list[corner_nr];
         *xpos = point.x;
@@ -4927,6 +5587,14 @@ void ecl_grid_get_cell_corner_xyz1(const ecl_grid_type *grid, int global_index,
 
 void ecl_grid_export_cell_corners1(const ecl_grid_type *grid, int global_index,
                                    double *x, double *y, double *z) {
+    if (grid->geometry) {
+        size_t offset = 8 * (size_t)global_index;
+        memcpy(x, &grid->geometry->corner_x[offset], 8 * sizeof *x);
+        memcpy(y, &grid->geometry->corner_y[offset], 8 * sizeof *y);
+        memcpy(z, &grid->geometry->corner_z[offset], 8 * sizeof *z);
+        return;
+    }
+
     const ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
     for (int i = 0; i < 8; i++) {
         const point_type point = cell->corner_list[i];
@@ -5194,7 +5862,12 @@ double ecl_grid_get_cell_dy1A(const ecl_grid_type *grid, int active_index) {
 
 const nnc_info_type *ecl_grid_get_cell_nnc_info1(const ecl_grid_type *grid,
                                                  int global_index) {
-    const ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
+    ecl_cell_type *cell = ecl_grid_get_cell(grid, global_index);
+    if (grid->nnc_store) {
+        std::lock_guard<std::mutex> lock(grid->nnc_info_mutex);
+        if (!cell->nnc_info)
+            cell->nnc_info = ecl_grid_alloc_cell_nnc_info(grid, global_index);
+    }
     return cell->nnc_info;
 }
 
@@ -5510,9 +6183,10 @@ int ecl_grid_get_cell_twist3(const ecl_grid_type *ecl_grid, int i, int j,
 
 double ecl_grid_get_cell_volume1(const ecl_grid_type *ecl_grid,
                                  int global_index) {
+    if (ecl_grid->geometry)
+        return ecl_grid->geometry->volume[global_index];
+
     ecl_cell_type *cell = ecl_grid_get_cell(ecl_grid, global_index);
-    int i, j, k;
-    ecl_grid_get_ijk1(ecl_grid, global_index, &i, &j, &k);
     return ecl_cell_get_volume(cell);
 }
 
@@ -6739,19 +7413,33 @@ static void ecl_grid_fwrite_self_nnc(const ecl_grid_type *grid,
     int_vector_type *g1 = int_vector_alloc(0, default_index);
     int_vector_type *g2 = int_vector_alloc(0, default_index);
     int g;
-
-    for (g = 0; g < ecl_grid_get_global_size(grid); g++) {
-        ecl_cell_type *cell = ecl_grid_get_cell(grid, g);
-        const nnc_info_type *nnc_info = cell->nnc_info;
-        if (nnc_info) {
-            const nnc_vector_type *nnc_vector =
-                nnc_info_get_self_vector(nnc_info);
-            int i;
-            for (i = 0; i < nnc_vector_get_size(nnc_vector); i++) {
-                int nnc_index = nnc_vector_iget_nnc_index(nnc_vector, i);
-                int_vector_iset(g1, nnc_index, 1 + g);
-                int_vector_iset(g2, nnc_index,
-                                1 + nnc_vector_iget_grid_index(nnc_vector, i));
+    ecl_grid_nnc_csr_type csr;
+
+    if (ecl_grid_get_compact_nnc(grid, &csr)) {
+        for (g = 0; g < csr.size; g++) {
+            for (int i = csr.row_offset[g]; i < csr.row_offset[g + 1]; i++) {
+                if (csr.lgr_nr[i] == grid->lgr_nr) {
+                    int_vector_iset(g1, csr.nnc_index[i], 1 + g);
+                    int_vector_iset(g2, csr.nnc_index[i],
+                                    1 + csr.global_index[i]);
+                }
+            }
+        }
+    } else {
+        for (g = 0; g < ecl_grid_get_global_size(grid); g++) {
+            ecl_cell_type *cell = ecl_grid_get_cell(grid, g);
+            const nnc_info_type *nnc_info = cell->nnc_info;
+            if (nnc_info) {
+                const nnc_vector_type *nnc_vector =
+                    nnc_info_get_self_vector(nnc_info);
+                int i;
+                for (i = 0; i < nnc_vector_get_size(nnc_vector); i++) {
+                    int nnc_index = nnc_vector_iget_nnc_index(nnc_vector, i);
+                    int_vector_iset(g1, nnc_index, 1 + g);
+                    int_vector_iset(
+                        g2, nnc_index,
+                        1 + nnc_vector_iget_grid_index(nnc_vector, i));
+                }
             }
         }
     }
@@ -7044,6 +7732,9 @@ bool ecl_grid_dual_grid(const ecl_grid_type *ecl_grid) {
 static int ecl_grid_get_num_nnc__(const ecl_grid_type *grid) {
     int g;
     int num_nnc = 0;
+    if (grid->nnc_store)
+        return grid->nnc_store->row_offset[grid->size];
+
     for (g = 0; g < grid->size; g++) {
         const nnc_info_type *nnc_info = ecl_grid_get_cell_nnc_info1(grid, g);
         if (nnc_info)
@@ -7066,33 +7757,78 @@ int ecl_grid_get_num_nnc(const ecl_grid_type *grid) {
     return num_nnc;
 }
 
+/*
+  Computes the volume of all the cells in the grid; with @active_size
+  == true the volume of active cell a is stored in volume[a], otherwise
+  the volume of cell g is stored in volume[g]. The cells are processed
+  in blocks of ECL_CELL_VOLUME_BLOCK cells, which are copied to local
+  corner arrays and evaluated by ecl_cell_volume_block(), and the k
+  layers are distributed over the OpenMP threads.
+*/
+
+static void ecl_grid_compute_cell_volumes(const ecl_grid_type *grid,
+                                          bool active_size, double *volume) {
+    const int layer_size = grid->nx * grid->ny;
+
+#pragma omp parallel for schedule(static)
+    for (int k = 0; k < grid->nz; k++) {
+        double x[8 * ECL_CELL_VOLUME_BLOCK];
+        double y[8 * ECL_CELL_VOLUME_BLOCK];
+        double z[8 * ECL_CELL_VOLUME_BLOCK];
+        double block_volume[ECL_CELL_VOLUME_BLOCK];
+        const int layer_end = (k + 1) * layer_size;
+
+        for (int first = k * layer_size; first < layer_end;
+             first += ECL_CELL_VOLUME_BLOCK) {
+            int count = util_int_min(ECL_CELL_VOLUME_BLOCK, layer_end - first);
+
+            if (grid->geometry) {
+                for (int i = 0; i < count; i++)
+                    block_volume[i] = grid->geometry->volume[first + i];
+            } else {
+                for (int i = 0; i < count; i++) {
+                    const ecl_cell_type *cell =
+                        ecl_grid_get_cell(grid, first + i);
+                    for (int c = 0; c < 8; c++) {
+                        x[c * ECL_CELL_VOLUME_BLOCK + i] =
+                            cell->corner_list[c].x;
+                        y[c * ECL_CELL_VOLUME_BLOCK + i] =
+                            cell->corner_list[c].y;
+                        z[c * ECL_CELL_VOLUME_BLOCK + i] =
+                            cell->corner_list[c].z;
+                    }
+                }
+                ecl_cell_volume_block(count, ECL_CELL_VOLUME_BLOCK, x, y, z,
+                                      block_volume);
+            }
+
+            for (int i = 0; i < count; i++) {
+                int global_index = first + i;
+                if (active_size) {
+                    int active_index =
+                        ecl_grid_get_active_index1(grid, global_index);
+                    if (active_index >= 0)
+                        volume[active_index] = block_volume[i];
+                } else
+                    volume[global_index] = block_volume[i];
+            }
+        }
+    }
+}
+
 static ecl_kw_type *ecl_grid_alloc_volume_kw_active(const ecl_grid_type *grid) {
     ecl_kw_type *volume_kw =
         ecl_kw_alloc("VOLUME", ecl_grid_get_active_size(grid), ECL_DOUBLE);
-    {
-        double *volume_data = (double *)ecl_kw_get_ptr(volume_kw);
-        int active_index;
-        for (active_index = 0; active_index < ecl_grid_get_active_size(grid);
-             active_index++) {
-            double cell_volume = ecl_grid_get_cell_volume1A(grid, active_index);
-            volume_data[active_index] = cell_volume;
-        }
-    }
+    ecl_grid_compute_cell_volumes(grid, true,
+                                  (double *)ecl_kw_get_ptr(volume_kw));
     return volume_kw;
 }
 
 static ecl_kw_type *ecl_grid_alloc_volume_kw_global(const ecl_grid_type *grid) {
     ecl_kw_type *volume_kw =
         ecl_kw_alloc("VOLUME", ecl_grid_get_global_size(grid), ECL_DOUBLE);
-    {
-        double *volume_data = (double *)ecl_kw_get_ptr(volume_kw);
-        int global_index;
-        for (global_index = 0; global_index < ecl_grid_get_global_size(grid);
-             global_index++) {
-            double cell_volume = ecl_grid_get_cell_volume1(grid, global_index);
-            volume_data[global_index] = cell_volume;
-        }
-    }
+    ecl_grid_compute_cell_volumes(grid, false,
+                                  (double *)ecl_kw_get_ptr(volume_kw));
     return volume_kw;
 }
 
@@ -55,9 +55,10 @@ ecl_grid_cache::ecl_grid_cache(const ecl_grid_type *grid) : grid(grid) {
 
 const std::vector<double> &ecl_grid_cache::volume() const {
     if (this->v.empty()) {
-        for (int active_index = 0; active_index < this->size(); active_index++)
-            this->v.push_back(
-                ecl_grid_get_cell_volume1A(this->grid, active_index));
+        ecl_kw_type *volume_kw = ecl_grid_alloc_volume_kw(this->grid, true);
+        const double *volume = ecl_kw_get_double_ptr(volume_kw);
+        this->v.assign(volume, volume + this->size());
+        ecl_kw_free(volume_kw);
     }
     return this->v;
 }
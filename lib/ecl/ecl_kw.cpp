@@ -16,12 +16,18 @@
    for more details.
 */
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
 
+#include <charconv>
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include <ert/util/util.h>
 #include <ert/util/buffer.hpp>
 #include <ert/util/int_vector.hpp>
@@ -32,6 +38,8 @@
 #include <ert/ecl/ecl_endian_flip.hpp>
 #include <ert/ecl/ecl_type.hpp>
 
+#include "detail/util/number_parser.hpp"
+
 #define ECL_KW_TYPE_ID 6111098
 
 struct ecl_kw_struct {
@@ -77,37 +85,29 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw, ECL_KW_TYPE_ID)
 /* Format string used when writing a formatted header. */
 #define WRITE_HEADER_FMT " '%-8s' %11d '%-4s'\n"
 
-/* Format string used when reading and writing formatted
-   files. Observe the following about these format strings:
+/* Observe the following about the formatted files:
 
-    1. The format string for reading double contains two '%'
-       identifiers, that is because doubles are read by parsing a
-       prefix and power separately.
+    1. Float values are written as 0.ddddddddE+03 and double values as
+       0.ddddddddddddddD+03; i.e. the values are split in a prefix and
+       a power prior to writing - see the function
+       ecl_kw_fmt_append_scientific(). When reading, the 'D' exponent
+       is replaced with 'E' before the value is parsed.
 
-    2. For both double and float the write format contains two '%'
-       characters - that is because the values are split in a prefix
-       and a power prior to writing - see the function
-       __fprintf_scientific().
+    2. The logical type involves converting back and forth between 'T'
+       and 'F' and internal logical representation.
 
-    3. The logical type involves converting back and forth between 'T'
-       and 'F' and internal logical representation. The format strings
-       are therefore for reading/writing a character.
+    3. Character data is written as quoted strings padded with spaces,
+       i.e. 'ABC     ' for an eight character string.
 
+   The formatted data is not read and written with fscanf() / fprintf()
+   on every element; the ecl_kw_fmt_xxx() functions below read complete
+   lines and parse the elements with ecl::util::parse_number(), and the
+   output for a complete block is assembled in memory and written with
+   one fwrite().
 */
 
-#define READ_FMT_CHAR "%8c"
-#define READ_FMT_FLOAT "%gE"
-#define READ_FMT_INT "%d"
-#define READ_FMT_MESS "%8c"
-#define READ_FMT_BOOL "  %c"
-#define READ_FMT_DOUBLE "%lgD%d"
-
-#define WRITE_FMT_CHAR " '%-8s'"
-#define WRITE_FMT_INT " %11d"
-#define WRITE_FMT_FLOAT "  %11.8fE%+03d"
-#define WRITE_FMT_DOUBLE "  %17.14fD%+03d"
-#define WRITE_FMT_MESS "%s"
-#define WRITE_FMT_BOOL "  %c"
+#define FMT_DECIMALS_FLOAT 8
+#define FMT_DECIMALS_DOUBLE 14
 
 /* The boolean type is not a native type which can be uniquely
    identified between Fortran (ECLIPSE), C, formatted and unformatted
@@ -137,61 +137,6 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw, ECL_KW_TYPE_ID)
 ecl_type_enum ecl_kw_get_type(const ecl_kw_type *);
 void ecl_kw_set_data_type(ecl_kw_type *ecl_kw, ecl_data_type data_type);
 
-static char *alloc_read_fmt_string(const ecl_data_type ecl_type) {
-    return util_alloc_sprintf("%%%dc", ecl_type_get_sizeof_iotype(ecl_type));
-}
-
-static char *alloc_read_fmt(const ecl_data_type data_type) {
-    switch (ecl_type_get_type(data_type)) {
-    case (ECL_CHAR_TYPE):
-        return util_alloc_string_copy(READ_FMT_CHAR);
-    case (ECL_INT_TYPE):
-        return util_alloc_string_copy(READ_FMT_INT);
-    case (ECL_FLOAT_TYPE):
-        return util_alloc_string_copy(READ_FMT_FLOAT);
-    case (ECL_DOUBLE_TYPE):
-        return util_alloc_string_copy(READ_FMT_DOUBLE);
-    case (ECL_BOOL_TYPE):
-        return util_alloc_string_copy(READ_FMT_BOOL);
-    case (ECL_MESS_TYPE):
-        return util_alloc_string_copy(READ_FMT_MESS);
-    case (ECL_STRING_TYPE):
-        return alloc_read_fmt_string(data_type);
-    default:
-        util_abort("%s: invalid ecl_type:%s \n", __func__,
-                   ecl_type_alloc_name(data_type));
-        return NULL;
-    }
-}
-
-static char *alloc_write_fmt_string(const ecl_data_type ecl_type) {
-    return util_alloc_sprintf(" '%%-%ds'",
-                              ecl_type_get_sizeof_iotype(ecl_type));
-}
-
-static char *alloc_write_fmt(const ecl_data_type data_type) {
-    switch (ecl_type_get_type(data_type)) {
-    case (ECL_CHAR_TYPE):
-        return util_alloc_string_copy(WRITE_FMT_CHAR);
-    case (ECL_INT_TYPE):
-        return util_alloc_string_copy(WRITE_FMT_INT);
-    case (ECL_FLOAT_TYPE):
-        return util_alloc_string_copy(WRITE_FMT_FLOAT);
-    case (ECL_DOUBLE_TYPE):
-        return util_alloc_string_copy(WRITE_FMT_DOUBLE);
-    case (ECL_BOOL_TYPE):
-        return util_alloc_string_copy(WRITE_FMT_BOOL);
-    case (ECL_MESS_TYPE):
-        return util_alloc_string_copy(WRITE_FMT_MESS);
-    case (ECL_STRING_TYPE):
-        return alloc_write_fmt_string(data_type);
-    default:
-        util_abort("%s: invalid ecl_type: %s\n", __func__,
-                   ecl_type_alloc_name(data_type));
-        return NULL;
-    }
-}
-
 static int get_blocksize(ecl_data_type data_type) {
     if (ecl_type_is_alpha(data_type))
         return BLOCKSIZE_CHAR;
@@ -271,10 +216,9 @@ static char *ecl_kw_alloc_output_buffer(const ecl_kw_type *ecl_kw) {
     if (ecl_type_is_mess(ecl_kw->data_type))
         return buffer;
 
-    if (ecl_kw->data) {
-        memcpy(buffer, ecl_kw->data, buffer_size);
-        util_endian_flip_vector(buffer, sizeof_iotype, ecl_kw->size);
-    }
+    if (ecl_kw->data)
+        util_endian_flip_copy_vector(buffer, ecl_kw->data, sizeof_iotype,
+                                     ecl_kw->size);
 
     return buffer;
 }
@@ -291,25 +235,23 @@ static void ecl_kw_load_from_input_buffer(ecl_kw_type *ecl_kw, char *buffer) {
     size_t sizeof_iotype = ecl_type_get_sizeof_iotype(ecl_kw->data_type);
     size_t sizeof_ctype = ecl_type_get_sizeof_ctype(ecl_kw->data_type);
     size_t buffer_size = ecl_kw->size * sizeof_iotype;
-    if (ECL_ENDIAN_FLIP) {
-        if (ecl_type_is_numeric(ecl_kw->data_type) ||
-            ecl_type_is_bool(ecl_kw->data_type))
-            util_endian_flip_vector(buffer, sizeof_iotype, ecl_kw->size);
-    }
 
     /*
     Special case bool: Return Eclipse integer representation of bool to native bool.
+    Instead of byte swapping the buffer we compare with a byte swapped
+    ECL_BOOL_TRUE_INT.
   */
     if (ecl_type_is_bool(ecl_kw->data_type)) {
-        int *int_data = (int *)buffer;
+        const int *int_data = (const int *)buffer;
         bool *bool_data = (bool *)ecl_kw->data;
+        int true_int = ECL_BOOL_TRUE_INT;
+
+        if (ECL_ENDIAN_FLIP)
+            util_endian_flip_vector(&true_int, sizeof true_int, 1);
+
+        for (int i = 0; i < ecl_kw->size; i++)
+            bool_data[i] = (int_data[i] == true_int);
 
-        for (int i = 0; i < ecl_kw->size; i++) {
-            if (int_data[i] == ECL_BOOL_TRUE_INT)
-                bool_data[i] = true;
-            else
-                bool_data[i] = false;
-        }
         return;
     }
 
@@ -335,9 +277,14 @@ static void ecl_kw_load_from_input_buffer(ecl_kw_type *ecl_kw, char *buffer) {
         return;
 
     /*
-    Plain int, double, float data - that can be copied straight over to the ->data field.
+    Plain int, double, float data - that can be copied straight over to the
+    ->data field; when endian flipping is needed that is done on the fly.
   */
-    memcpy(ecl_kw->data, buffer, buffer_size);
+    if (ECL_ENDIAN_FLIP)
+        util_endian_flip_copy_vector(ecl_kw->data, buffer, sizeof_iotype,
+                                     ecl_kw->size);
+    else
+        memcpy(ecl_kw->data, buffer, buffer_size);
 }
 
 const char *ecl_kw_get_header8(const ecl_kw_type *ecl_kw) {
@@ -1065,162 +1012,224 @@ void ecl_kw_iset(ecl_kw_type *ecl_kw, int i, const void *iptr) {
     ecl_kw_iset_static(ecl_kw, i, iptr);
 }
 
-static bool ecl_kw_qskip(FILE *stream) {
-    const char sep = '\'';
-    const char space = ' ';
-    const char newline = '\n';
-    const char tab = '\t';
-    bool OK = true;
-    char c;
-    bool cont = true;
-    while (cont) {
-        c = fgetc(stream);
-        if (c == EOF) {
-            cont = false;
-            OK = false;
-        } else {
-            if (c == space || c == newline || c == tab)
-                cont = true;
-            else if (c == sep)
-                cont = false;
+/*
+  The formatted data is read one line at a time with fgets(), and the
+  elements are parsed straight from the line buffer.
+*/
+typedef struct {
+    FILE *stream;
+    std::vector<char> line;
+    char *pos;
+} ecl_kw_fmt_reader_type;
+
+/* Plain inline test; isspace() is a library call for every character. */
+static inline bool ecl_kw_fmt_is_space(char c) {
+    return (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' ||
+            c == '\v');
+}
+
+static void ecl_kw_fmt_reader_init(ecl_kw_fmt_reader_type *reader,
+                                   FILE *stream) {
+    reader->stream = stream;
+    reader->line.resize(256);
+    reader->line[0] = '\0';
+    reader->pos = reader->line.data();
+}
+
+/*
+  Will read the next line, including the trailing newline, into the
+  line buffer; the buffer is grown as needed. Returns false on EOF.
+*/
+static bool ecl_kw_fmt_reader_next_line(ecl_kw_fmt_reader_type *reader) {
+    size_t length = 0;
+    while (true) {
+        if (reader->line.size() - length < 2)
+            reader->line.resize(2 * reader->line.size());
+
+        char *start = &reader->line[length];
+        if (!fgets(start, reader->line.size() - length, reader->stream)) {
+            if (length == 0)
+                return false;
+            break;
         }
+
+        length += strlen(start);
+        if (length > 0 && reader->line[length - 1] == '\n')
+            break;
     }
-    return OK;
+    reader->pos = reader->line.data();
+    return true;
 }
 
-static bool ecl_kw_fscanf_qstring(char *s, const char *fmt, int len,
-                                  FILE *stream) {
-    const char null_char = '\0';
-    char last_sep;
-    bool OK;
-    OK = ecl_kw_qskip(stream);
-    if (OK) {
-        int read_count = 0;
-        read_count += fscanf(stream, fmt, s);
-        s[len] = null_char;
-        read_count += fscanf(stream, "%c", &last_sep);
-
-        if (read_count != 2)
-            util_abort("%s: reading \'xxxxxxxx\' formatted string failed \n",
-                       __func__);
+/*
+  Will skip whitespace, continuing on the following lines if
+  necessary, and return a pointer to the start of the next token - or
+  NULL on EOF.
+*/
+static char *ecl_kw_fmt_reader_skip_space(ecl_kw_fmt_reader_type *reader) {
+    while (true) {
+        while (ecl_kw_fmt_is_space(*reader->pos))
+            reader->pos++;
+
+        if (*reader->pos != '\0')
+            return reader->pos;
+
+        if (!ecl_kw_fmt_reader_next_line(reader))
+            return NULL;
     }
-    return OK;
 }
 
 /*
-  This rather painful parsing is because formatted eclipse double
-  format : 0.ddddD+01 - difficult to parse the 'D';
+  Will return the next whitespace separated token as a '\0' terminated
+  string; the token is terminated in place in the line buffer. Returns
+  NULL on EOF.
 */
-/** Should be: NESTED */
-
-static double __fscanf_ECL_double(FILE *stream, const char *fmt) {
-    int read_count, power;
-    double value, arg;
-    read_count = fscanf(stream, fmt, &arg, &power);
-    if (read_count == 2)
-        value = arg * pow(10, power);
-    else {
-        util_abort("%s: read failed \n", __func__);
-        value = -1;
+static char *ecl_kw_fmt_read_token(ecl_kw_fmt_reader_type *reader) {
+    char *token = ecl_kw_fmt_reader_skip_space(reader);
+    if (!token)
+        return NULL;
+
+    char *end = token;
+    while (*end != '\0' && !ecl_kw_fmt_is_space(*end))
+        end++;
+
+    if (*end != '\0') {
+        *end = '\0';
+        end++;
+    }
+    reader->pos = end;
+    return token;
+}
+
+/*
+  Will read a quoted string like 'ABCDEFGH' into @s: everything up to
+  the opening quote is skipped, then exactly @len characters are read,
+  followed by the closing quote. Returns false if EOF is reached before
+  the opening quote.
+*/
+static bool ecl_kw_fmt_read_qstring(ecl_kw_fmt_reader_type *reader, char *s,
+                                    int len) {
+    while (true) {
+        char *quote = strchr(reader->pos, '\'');
+        if (quote) {
+            reader->pos = quote + 1;
+            break;
+        }
+
+        if (!ecl_kw_fmt_reader_next_line(reader))
+            return false;
+    }
+
+    if (strnlen(reader->pos, len + 1) < (size_t)(len + 1))
+        util_abort("%s: reading \'xxxxxxxx\' formatted string failed \n",
+                   __func__);
+
+    memcpy(s, reader->pos, len);
+    s[len] = '\0';
+    reader->pos += len + 1;
+    return true;
+}
+
+/*
+  Formatted eclipse double values use a 'D' for the exponent, i.e.
+  0.ddddD+01; it is replaced with an 'E' before the value is parsed.
+*/
+static bool ecl_kw_fmt_parse_double(char *token, double *value) {
+    char *exponent = strpbrk(token, "Dd");
+    if (exponent)
+        *exponent = 'E';
+
+    return ecl::util::parse_number(token, value) != NULL;
+}
+
+/*
+  The data is consumed up to, and including, the newline ending the
+  last line of data.
+*/
+static void ecl_kw_fread_data_formatted(ecl_kw_type *ecl_kw,
+                                        fortio_type *fortio) {
+    const int sizeof_ctype = ecl_type_get_sizeof_ctype(ecl_kw->data_type);
+    const int sizeof_iotype = ecl_type_get_sizeof_iotype(ecl_kw->data_type);
+    ecl_kw_fmt_reader_type reader;
+    ecl_kw_fmt_reader_init(&reader, fortio_get_FILE(fortio));
+
+    for (int index = 0; index < ecl_kw->size; index++) {
+        char *data = &ecl_kw->data[index * sizeof_ctype];
+        bool read_ok = true;
+
+        switch (ecl_kw_get_type(ecl_kw)) {
+        case (ECL_CHAR_TYPE):
+        case (ECL_MESS_TYPE):
+            ecl_kw_fmt_read_qstring(&reader, data, ECL_STRING8_LENGTH);
+            break;
+        case (ECL_STRING_TYPE):
+            ecl_kw_fmt_read_qstring(&reader, data, sizeof_iotype);
+            break;
+        case (ECL_INT_TYPE): {
+            const char *token = ecl_kw_fmt_read_token(&reader);
+            read_ok = token && ecl::util::parse_number(token, (int *)data);
+        } break;
+        case (ECL_FLOAT_TYPE): {
+            const char *token = ecl_kw_fmt_read_token(&reader);
+            read_ok = token && ecl::util::parse_number(token, (float *)data);
+        } break;
+        case (ECL_DOUBLE_TYPE): {
+            char *token = ecl_kw_fmt_read_token(&reader);
+            read_ok = token && ecl_kw_fmt_parse_double(token, (double *)data);
+        } break;
+        case (ECL_BOOL_TYPE): {
+            const char *token = ecl_kw_fmt_read_token(&reader);
+            if (!token)
+                util_abort("%s: read failed - premature file end? \n",
+                           __func__);
+
+            if (token[0] == BOOL_TRUE_CHAR)
+                ecl_kw_iset_bool(ecl_kw, index, true);
+            else if (token[0] == BOOL_FALSE_CHAR)
+                ecl_kw_iset_bool(ecl_kw, index, false);
+            else
+                util_abort("%s: Logical value: [%c] not "
+                           "recogniced - aborting \n",
+                           __func__, token[0]);
+        } break;
+        default:
+            util_abort("%s: Internal error: internal eclipse_type: "
+                       "%d not recognized - aborting \n",
+                       __func__, ecl_kw_get_type(ecl_kw));
+        }
+
+        if (!read_ok)
+            util_abort("%s: after reading %d values reading of "
+                       "keyword:%s from:%s failed - aborting \n",
+                       __func__, index, ecl_kw->header8,
+                       fortio_filename_ref(fortio));
     }
-    return value;
 }
 
 bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
     bool fmt_file = fortio_fmt_file(fortio);
     if (ecl_kw->size > 0) {
-        const int blocksize = get_blocksize(ecl_kw->data_type);
         if (fmt_file) {
-            const int blocks = ecl_kw->size / blocksize +
-                               (ecl_kw->size % blocksize == 0 ? 0 : 1);
-            char *read_fmt = alloc_read_fmt(ecl_kw->data_type);
-            FILE *stream = fortio_get_FILE(fortio);
-            int offset = 0;
-            int index = 0;
-            int ib, ir;
-            for (ib = 0; ib < blocks; ib++) {
-                int read_elm =
-                    util_int_min((ib + 1) * blocksize, ecl_kw->size) -
-                    ib * blocksize;
-                for (ir = 0; ir < read_elm; ir++) {
-                    switch (ecl_kw_get_type(ecl_kw)) {
-                    case (ECL_CHAR_TYPE):
-                        ecl_kw_fscanf_qstring(&ecl_kw->data[offset], read_fmt,
-                                              8, stream);
-                        break;
-                    case (ECL_STRING_TYPE):
-                        ecl_kw_fscanf_qstring(&ecl_kw->data[offset], read_fmt,
-                                              ecl_type_get_sizeof_iotype(
-                                                  ecl_kw_get_data_type(ecl_kw)),
-                                              stream);
-                        break;
-                    case (ECL_INT_TYPE): {
-                        int iread = fscanf(stream, read_fmt,
-                                           (int *)&ecl_kw->data[offset]);
-                        if (iread != 1)
-                            util_abort(
-                                "%s: after reading %d values reading of "
-                                "keyword:%s from:%s failed - aborting \n",
-                                __func__,
-                                offset / ecl_type_get_sizeof_ctype(
-                                             ecl_kw->data_type),
-                                ecl_kw->header8, fortio_filename_ref(fortio));
-                    } break;
-                    case (ECL_FLOAT_TYPE): {
-                        int iread = fscanf(stream, read_fmt,
-                                           (float *)&ecl_kw->data[offset]);
-                        if (iread != 1) {
-                            util_abort(
-                                "%s: after reading %d values reading of "
-                                "keyword:%s from:%s failed - aborting \n",
-                                __func__,
-                                offset / ecl_type_get_sizeof_ctype(
-                                             ecl_kw->data_type),
-                                ecl_kw->header8, fortio_filename_ref(fortio));
-                        }
-                    } break;
-                    case (ECL_DOUBLE_TYPE): {
-                        double value = __fscanf_ECL_double(stream, read_fmt);
-                        ecl_kw_iset(ecl_kw, index, &value);
-                    } break;
-                    case (ECL_BOOL_TYPE): {
-                        char bool_char;
-                        if (fscanf(stream, read_fmt, &bool_char) == 1) {
-                            if (bool_char == BOOL_TRUE_CHAR)
-                                ecl_kw_iset_bool(ecl_kw, index, true);
-                            else if (bool_char == BOOL_FALSE_CHAR)
-                                ecl_kw_iset_bool(ecl_kw, index, false);
-                            else
-                                util_abort("%s: Logical value: [%c] not "
-                                           "recogniced - aborting \n",
-                                           __func__, bool_char);
-                        } else
-                            util_abort(
-                                "%s: read failed - premature file end? \n",
-                                __func__);
-                    } break;
-                    case (ECL_MESS_TYPE):
-                        ecl_kw_fscanf_qstring(&ecl_kw->data[offset], read_fmt,
-                                              8, stream);
-                        break;
-                    default:
-                        util_abort("%s: Internal error: internal eclipse_type: "
-                                   "%d not recognized - aborting \n",
-                                   __func__, ecl_kw_get_type(ecl_kw));
-                    }
-                    offset += ecl_type_get_sizeof_ctype(ecl_kw->data_type);
-                    index++;
-                }
-            }
-
-            /* Skip the trailing newline */
-            fortio_fseek(fortio, 1, SEEK_CUR);
-            free(read_fmt);
+            ecl_kw_fread_data_formatted(ecl_kw, fortio);
             return true;
         } else {
-            char *buffer = ecl_kw_alloc_input_buffer(ecl_kw);
             const int sizeof_iotype =
                 ecl_type_get_sizeof_iotype(ecl_kw->data_type);
+
+            /*
+              Plain numeric data is read straight into the ->data storage
+              and byte swapped in place, without an intermediate buffer.
+            */
+            if (ecl_type_is_numeric(ecl_kw->data_type)) {
+                bool read_ok = fortio_fread_buffer(
+                    fortio, ecl_kw->data, ecl_kw->size * sizeof_iotype);
+                if (read_ok && ECL_ENDIAN_FLIP)
+                    util_endian_flip_vector(ecl_kw->data, sizeof_iotype,
+                                            ecl_kw->size);
+                return read_ok;
+            }
+
+            char *buffer = ecl_kw_alloc_input_buffer(ecl_kw);
             bool read_ok = fortio_fread_buffer(fortio, buffer,
                                                ecl_kw->size * sizeof_iotype);
 
@@ -1235,6 +1244,48 @@ bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
         return true;
 }
 
+/**
+   Will load the data section of the keyword from the file offset
+   @data_offset, i.e. the offset immediately after the header, using
+   the positional fortio_pread_buffer() function. The ecl_kw instance
+   must already have been initialized with header, size and type and
+   have allocated storage.
+
+   For the plain numeric types the data is read straight into the
+   ->data storage of the keyword and byte swapped in place, i.e. no
+   temporary input buffer is involved.
+*/
+
+bool ecl_kw_pread_data(ecl_kw_type *ecl_kw, const fortio_type *fortio,
+                       offset_type data_offset) {
+    if (ecl_kw->size == 0)
+        return true;
+
+    const int sizeof_iotype = ecl_type_get_sizeof_iotype(ecl_kw->data_type);
+    const int buffer_size = ecl_kw->size * sizeof_iotype;
+
+    if (ecl_type_is_numeric(ecl_kw->data_type)) {
+        bool read_ok = fortio_pread_buffer(fortio, data_offset, ecl_kw->data,
+                                           buffer_size);
+        if (read_ok && ECL_ENDIAN_FLIP)
+            util_endian_flip_vector(ecl_kw->data, sizeof_iotype,
+                                    ecl_kw->size);
+        return read_ok;
+    }
+
+    {
+        char *buffer = ecl_kw_alloc_input_buffer(ecl_kw);
+        bool read_ok =
+            fortio_pread_buffer(fortio, data_offset, buffer, buffer_size);
+
+        if (read_ok)
+            ecl_kw_load_from_input_buffer(ecl_kw, buffer);
+
+        free(buffer);
+        return read_ok;
+    }
+}
+
 void ecl_kw_fread_indexed_data(fortio_type *fortio, offset_type data_offset,
                                ecl_data_type data_type, int element_count,
                                const int_vector_type *index_map,
@@ -1335,17 +1386,19 @@ ecl_read_status_enum ecl_kw_fread_header(ecl_kw_type *ecl_kw,
     int size;
 
     if (fmt_file) {
-        if (!ecl_kw_fscanf_qstring(header, "%8c", 8, stream))
-            return ECL_KW_READ_FAIL;
-
-        int read_count = fscanf(stream, "%d", &size);
-        if (read_count != 1)
-            return ECL_KW_READ_FAIL;
-
-        if (!ecl_kw_fscanf_qstring(ecl_type_str, "%4c", 4, stream))
+        ecl_kw_fmt_reader_type reader;
+        ecl_kw_fmt_reader_init(&reader, stream);
+
+        /* The header line is consumed including the trailing newline. */
+        const char *token;
+        bool read_ok =
+            ecl_kw_fmt_read_qstring(&reader, header, ECL_STRING8_LENGTH) &&
+            (token = ecl_kw_fmt_read_token(&reader)) &&
+            ecl::util::parse_number(token, &size) &&
+            ecl_kw_fmt_read_qstring(&reader, ecl_type_str, ECL_TYPE_LENGTH);
+
+        if (!read_ok)
             return ECL_KW_READ_FAIL;
-
-        fgetc(stream); /* Reading the trailing newline ... */
     } else {
         header[ECL_STRING8_LENGTH] = null_char;
         ecl_type_str[ECL_TYPE_LENGTH] = null_char;
@@ -1578,27 +1631,78 @@ static void ecl_kw_fwrite_data_unformatted(const ecl_kw_type *ecl_kw,
     free(iobuffer);
 }
 
+static const uint64_t ecl_kw_fmt_pow10[] = {
+    1ULL,           10ULL,           100ULL,           1000ULL,
+    10000ULL,       100000ULL,       1000000ULL,       10000000ULL,
+    100000000ULL,   1000000000ULL,   10000000000ULL,   100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL};
+
+/*
+  Appends @x to @line formatted like printf("%*.*f", width, decimals, x).
+
+  When 128 bit integers are available the decimal digits of the values
+  in the range [0.001, 2) are computed exactly from the binary
+  representation of @x, with the same round-half-even rule as
+  printf(), at a fraction of the cost; this covers all the 0.dddd
+  prefixes created by ecl_kw_fmt_append_scientific(). Everything else
+  goes through snprintf().
+*/
+static void ecl_kw_fmt_append_fixed(std::string &line, double x, int width,
+                                    int decimals) {
+    char buffer[64];
+    int length = -1;
+
+#ifdef __SIZEOF_INT128__
+    const double abs_x = fabs(x);
+    if (decimals > 0 && decimals <= FMT_DECIMALS_DOUBLE && abs_x < 2 &&
+        (abs_x >= 0.001 || abs_x == 0)) {
+        typedef unsigned __int128 uint128;
+        int exp2;
+        const uint64_t mantissa = (uint64_t)ldexp(frexp(abs_x, &exp2), 53);
+        const int shift = 53 - exp2;
+        const uint128 scaled = (uint128)mantissa * ecl_kw_fmt_pow10[decimals];
+        uint64_t digits = (uint64_t)(scaled >> shift);
+        const uint128 rest = scaled - ((uint128)digits << shift);
+        const uint128 half = (uint128)1 << (shift - 1);
+        if (rest > half || (rest == half && (digits & 1)))
+            digits++;
+
+        uint64_t fraction = digits % ecl_kw_fmt_pow10[decimals];
+        char *p = buffer;
+        if (std::signbit(x))
+            *p++ = '-';
+        *p++ = '0' + (char)(digits / ecl_kw_fmt_pow10[decimals]);
+        *p++ = '.';
+        for (int i = decimals - 1; i >= 0; i--) {
+            p[i] = '0' + (char)(fraction % 10);
+            fraction /= 10;
+        }
+        length = (int)(p + decimals - buffer);
+    }
+#endif
+
+    if (length < 0)
+        length = snprintf(buffer, sizeof buffer, "%.*f", decimals, x);
+
+    if (length < width)
+        line.append(width - length, ' ');
+    line.append(buffer, length);
+}
+
 /**
-     The point of this awkward function is that I have not managed to
-     use C fprintf() syntax to reproduce the ECLIPSE
-     formatting. ECLIPSE expects the following formatting for float
-     and double values:
+     ECLIPSE expects the following formatting for float and double
+     values:
 
         0.ddddddddE+03       (float)
         0.ddddddddddddddD+03 (double)
 
-     The problem with printf have been:
-
-        1. To force the radix part to start with 0.
-        2. To use 'D' as the exponent start for double values.
-
-     If you are more proficient with C fprintf() format strings than I
-     am, the __fprintf_scientific() function should be removed, and
-     the WRITE_FMT_DOUBLE and WRITE_FMT_FLOAT format specifiers
-     updated accordingly.
+     i.e. the radix part starts with 0, and double values use 'D' as
+     the exponent start; this is not possible to achieve with plain
+     printf() format strings.
   */
 
-static void __fprintf_scientific(FILE *stream, const char *fmt, double x) {
+static void ecl_kw_fmt_append_scientific(std::string &line, double x,
+                                         int decimals, char exponent_char) {
     double pow_x = ceil(log10(fabs(x)));
     double arg_x = x / pow(10.0, pow_x);
     if (x != 0.0) {
@@ -1610,76 +1714,98 @@ static void __fprintf_scientific(FILE *stream, const char *fmt, double x) {
         arg_x = 0.0;
         pow_x = 0.0;
     }
-    fprintf(stream, fmt, arg_x, (int)pow_x);
-}
 
-static void ecl_kw_fwrite_data_formatted(ecl_kw_type *ecl_kw,
-                                         fortio_type *fortio) {
+    line.append(2, ' ');
+    ecl_kw_fmt_append_fixed(line, arg_x, decimals + 3, decimals);
 
-    {
+    int power = (int)pow_x;
+    line += exponent_char;
+    line += (power < 0) ? '-' : '+';
+    if (power < 0)
+        power = -power;
+    if (power < 10)
+        line += '0';
 
-        FILE *stream = fortio_get_FILE(fortio);
-        const int blocksize = get_blocksize(ecl_kw->data_type);
-        const int columns = get_columns(ecl_kw->data_type);
-        char *write_fmt = alloc_write_fmt(ecl_kw->data_type);
-        const int num_blocks =
-            ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
-        int block_nr;
+    char buffer[16];
+    char *end = std::to_chars(buffer, buffer + sizeof buffer, power).ptr;
+    line.append(buffer, end);
+}
 
-        for (block_nr = 0; block_nr < num_blocks; block_nr++) {
-            int this_blocksize =
-                util_int_min((block_nr + 1) * blocksize, ecl_kw->size) -
-                block_nr * blocksize;
-            int num_lines = this_blocksize / columns +
-                            (this_blocksize % columns == 0 ? 0 : 1);
-            int line_nr;
-            for (line_nr = 0; line_nr < num_lines; line_nr++) {
-                int num_columns =
-                    util_int_min((line_nr + 1) * columns, this_blocksize) -
-                    columns * line_nr;
-                int col_nr;
-                for (col_nr = 0; col_nr < num_columns; col_nr++) {
-                    int data_index =
-                        block_nr * blocksize + line_nr * columns + col_nr;
-                    void *data_ptr = ecl_kw_iget_ptr_static(ecl_kw, data_index);
-                    switch (ecl_kw_get_type(ecl_kw)) {
-                    case (ECL_CHAR_TYPE):
-                        fprintf(stream, write_fmt, data_ptr);
-                        break;
-                    case (ECL_STRING_TYPE):
-                        fprintf(stream, write_fmt, data_ptr);
-                        break;
-                    case (ECL_INT_TYPE): {
-                        int int_value = ((int *)data_ptr)[0];
-                        fprintf(stream, write_fmt, int_value);
-                    } break;
-                    case (ECL_BOOL_TYPE): {
-                        bool bool_value = ((bool *)data_ptr)[0];
-                        if (bool_value)
-                            fprintf(stream, write_fmt, BOOL_TRUE_CHAR);
-                        else
-                            fprintf(stream, write_fmt, BOOL_FALSE_CHAR);
-                    } break;
-                    case (ECL_FLOAT_TYPE): {
-                        float float_value = ((float *)data_ptr)[0];
-                        __fprintf_scientific(stream, write_fmt, float_value);
-                    } break;
-                    case (ECL_DOUBLE_TYPE): {
-                        double double_value = ((double *)data_ptr)[0];
-                        __fprintf_scientific(stream, write_fmt, double_value);
-                    } break;
-                    case (ECL_MESS_TYPE):
-                        util_abort("%s: Internal inconsistency : message type "
-                                   "keywords should not have data\n",
-                                   __func__);
-                        break;
-                    }
-                }
-                fprintf(stream, "\n");
+/* Appends @value formatted like printf(" %11d", value). */
+static void ecl_kw_fmt_append_int(std::string &line, int value) {
+    char buffer[16];
+    int length =
+        (int)(std::to_chars(buffer, buffer + sizeof buffer, value).ptr - buffer);
+    line.append(util_int_max(1, 12 - length), ' ');
+    line.append(buffer, length);
+}
+
+/* Appends @s formatted like printf(" '%-*s'", width, s). */
+static void ecl_kw_fmt_append_qstring(std::string &line, const char *s,
+                                      int width) {
+    int length = strlen(s);
+    line += " '";
+    line.append(s, length);
+    if (length < width)
+        line.append(width - length, ' ');
+    line += '\'';
+}
+
+static void ecl_kw_fwrite_data_formatted(ecl_kw_type *ecl_kw,
+                                         fortio_type *fortio) {
+    FILE *stream = fortio_get_FILE(fortio);
+    const int blocksize = get_blocksize(ecl_kw->data_type);
+    const int columns = get_columns(ecl_kw->data_type);
+    const int sizeof_iotype = ecl_type_get_sizeof_iotype(ecl_kw->data_type);
+    const int num_blocks =
+        ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+    std::string block;
+
+    for (int block_nr = 0; block_nr < num_blocks; block_nr++) {
+        int this_blocksize =
+            util_int_min((block_nr + 1) * blocksize, ecl_kw->size) -
+            block_nr * blocksize;
+
+        block.clear();
+        for (int i = 0; i < this_blocksize; i++) {
+            int data_index = block_nr * blocksize + i;
+            void *data_ptr = ecl_kw_iget_ptr_static(ecl_kw, data_index);
+            switch (ecl_kw_get_type(ecl_kw)) {
+            case (ECL_CHAR_TYPE):
+                ecl_kw_fmt_append_qstring(block, (const char *)data_ptr,
+                                          ECL_STRING8_LENGTH);
+                break;
+            case (ECL_STRING_TYPE):
+                ecl_kw_fmt_append_qstring(block, (const char *)data_ptr,
+                                          sizeof_iotype);
+                break;
+            case (ECL_INT_TYPE):
+                ecl_kw_fmt_append_int(block, ((int *)data_ptr)[0]);
+                break;
+            case (ECL_BOOL_TYPE): {
+                bool bool_value = ((bool *)data_ptr)[0];
+                block.append(2, ' ');
+                block += bool_value ? BOOL_TRUE_CHAR : BOOL_FALSE_CHAR;
+            } break;
+            case (ECL_FLOAT_TYPE):
+                ecl_kw_fmt_append_scientific(block, ((float *)data_ptr)[0],
+                                             FMT_DECIMALS_FLOAT, 'E');
+                break;
+            case (ECL_DOUBLE_TYPE):
+                ecl_kw_fmt_append_scientific(block, ((double *)data_ptr)[0],
+                                             FMT_DECIMALS_DOUBLE, 'D');
+                break;
+            case (ECL_MESS_TYPE):
+                util_abort("%s: Internal inconsistency : message type "
+                           "keywords should not have data\n",
+                           __func__);
+                break;
             }
-        }
 
-        free(write_fmt);
+            if ((i + 1) % columns == 0 || (i + 1) == this_blocksize)
+                block += '\n';
+        }
+        fwrite(block.data(), 1, block.size(), stream);
     }
 }
 
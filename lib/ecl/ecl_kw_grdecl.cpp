@@ -19,12 +19,17 @@
 #include <string.h>
 #include <ctype.h>
 
+#include <vector>
+
+#include <ert/util/build_config.h>
 #include <ert/util/util.h>
 
 #include <ert/ecl/ecl_kw.hpp>
 #include <ert/ecl/ecl_type.hpp>
 #include <ert/ecl/ecl_util.hpp>
 
+#include "detail/util/number_parser.hpp"
+
 #define MAX_GRDECL_HEADER_SIZE 512
 
 /*
@@ -246,125 +251,164 @@ static void iset_range(char *data, int data_index, int sizeof_ctype,
    Observe that no-spaces-are-allowed-around-the-*
 */
 
+#ifdef HAVE_GETC_UNLOCKED
+#define GRDECL_GETC(stream) getc_unlocked(stream)
+#else
+#define GRDECL_GETC(stream) getc(stream)
+#endif
+
+/*
+  Will read the next whitespace separated token from @stream into
+  @token as a '\0' terminated string, and leave the stream positioned
+  right after the token - like fscanf("%s"). Returns false if EOF is
+  reached before a token is found.
+  Observe that the caller must hold the lock on @stream.
+*/
+
+static bool grdecl_read_token(FILE *stream, std::vector<char> &token) {
+    int c;
+    token.clear();
+
+    do {
+        c = GRDECL_GETC(stream);
+    } while (c != EOF && isspace(c));
+
+    while (c != EOF && !isspace(c)) {
+        token.push_back(c);
+        c = GRDECL_GETC(stream);
+    }
+    if (c != EOF)
+        ungetc(c, stream);
+
+    token.push_back('\0');
+    return token.size() > 1;
+}
+
+/*
+  Will parse a token of the form "value" or "multiplier*value"; the
+  multiplier form requires that there are no spaces around the '*'.
+*/
+template <typename T>
+static bool grdecl_parse_token(const char *token, int *multiplier, T *value) {
+    const char *end = ecl::util::parse_number(token, multiplier);
+    if (end && *end == '*' && ecl::util::parse_number(end + 1, value))
+        return true;
+
+    *multiplier = 1;
+    return ecl::util::parse_number(token, value) != NULL;
+}
+
+/*
+  The tokens are read with a plain getc() loop and the numbers are
+  parsed with ecl::util::parse_number(); the old implementation
+  based on fscanf("%32s") and repeated sscanf() calls was very slow for
+  large GRDECL files. If the number of elements is known up front, i.e.
+  @size > 0, the data buffer is allocated with the correct size
+  immediately.
+*/
+
 static char *fscanf_alloc_grdecl_data(const char *header, bool strict,
-                                      ecl_data_type data_type, int *kw_size,
-                                      FILE *stream) {
-    char newline = '\n';
-    bool atEOF = false;
-    size_t init_size = 32;
-    size_t buffer_size = 64;
+                                      ecl_data_type data_type, int size,
+                                      int *kw_size, FILE *stream) {
+    size_t init_size = (size > 0) ? size : 32;
     size_t data_index = 0;
     int sizeof_ctype = ecl_type_get_sizeof_ctype(data_type);
     size_t data_size = init_size;
-    char *buffer = (char *)util_calloc((buffer_size + 1), sizeof *buffer);
     char *data = (char *)util_calloc(sizeof_ctype * data_size, sizeof *data);
-
-    while (true) {
-        if (fscanf(stream, "%32s", buffer) == 1) {
-            if (strcmp(buffer, ECL_COMMENT_STRING) == 0) {
-                // We have read a comment marker - just read up to the end of line.
-                char c;
-                while (true) {
-                    c = fgetc(stream);
-                    if (c == newline)
-                        break;
-                    if (c == EOF) {
-                        atEOF = true;
-                        break;
-                    }
-                }
-            } else if (strcmp(buffer, ECL_DATA_TERMINATION) == 0)
+    std::vector<char> token;
+
+    if (!ecl_type_is_int(data_type) && !ecl_type_is_float(data_type) &&
+        !ecl_type_is_double(data_type))
+        util_abort("%s: sorry type:%s not supported \n", __func__,
+                   ecl_type_alloc_name(data_type));
+
+#ifdef HAVE_GETC_UNLOCKED
+    flockfile(stream);
+#endif
+    while (grdecl_read_token(stream, token)) {
+        const char *buffer = token.data();
+
+        if (strcmp(buffer, ECL_COMMENT_STRING) == 0) {
+            // We have read a comment marker - just read up to the end of line.
+            int c;
+            do {
+                c = GRDECL_GETC(stream);
+            } while (c != '\n' && c != EOF);
+
+            if (c == EOF)
                 break;
-            else {
-                // We have read a valid input string; scan numerical input values from it.
-                // The multiplier algorithm will fail hard if there are spaces on either side
-                // of the '*'.
-                union {
-                    int i;
-                    float f;
-                    double d;
-                } value;
-
-                int multiplier;
-                bool char_input = false;
-
-                if (ecl_type_is_int(data_type)) {
-                    if (sscanf(buffer, "%d*%d", &multiplier, &value.i) == 2) {
-                    } else if (sscanf(buffer, "%d", &value.i) == 1)
-                        multiplier = 1;
-                    else {
-                        char_input = true;
-                        if (strict)
-                            util_abort("%s: Malformed content:\"%s\" when "
-                                       "reading keyword:%s \n",
-                                       __func__, buffer, header);
-                    }
-                } else if (ecl_type_is_float(data_type)) {
-                    if (sscanf(buffer, "%d*%g", &multiplier, &value.f) == 2) {
-                    } else if (sscanf(buffer, "%g", &value.f) == 1)
-                        multiplier = 1;
-                    else {
-                        char_input = true;
-                        if (strict)
-                            util_abort("%s: Malformed content:\"%s\" when "
-                                       "reading keyword:%s \n",
-                                       __func__, buffer, header);
-                    }
-                } else if (ecl_type_is_double(data_type)) {
-                    if (sscanf(buffer, "%d*%lg", &multiplier, &value.d) == 2) {
-                    } else if (sscanf(buffer, "%lg", &value.d) == 1)
-                        multiplier = 1;
-                    else {
-                        char_input = true;
-                        if (strict)
-                            util_abort("%s: Malformed content:\"%s\" when "
-                                       "reading keyword:%s \n",
-                                       __func__, buffer, header);
-                    }
-                } else
-                    util_abort("%s: sorry type:%s not supported \n", __func__,
-                               ecl_type_alloc_name(data_type));
-
-                /*
+        } else if (strcmp(buffer, ECL_DATA_TERMINATION) == 0)
+            break;
+        else {
+            // We have read a valid input string; scan numerical input values from it.
+            // The multiplier algorithm will fail hard if there are spaces on either side
+            // of the '*'.
+            union {
+                int i;
+                float f;
+                double d;
+            } value;
+
+            int multiplier;
+            bool valid_input;
+
+            if (ecl_type_is_int(data_type))
+                valid_input = grdecl_parse_token(buffer, &multiplier, &value.i);
+            else if (ecl_type_is_float(data_type))
+                valid_input = grdecl_parse_token(buffer, &multiplier, &value.f);
+            else
+                valid_input = grdecl_parse_token(buffer, &multiplier, &value.d);
+
+            /*
           Removing this warning on user request:
-          if (char_input)
+          if (!valid_input)
           fprintf(stderr,"Warning: character string: \'%s\' ignored when reading keyword:%s \n",buffer , header);
         */
-                if (!char_input) {
-                    size_t min_size = data_index + multiplier;
-                    if (min_size >= data_size) {
-                        if (min_size <= ECL_KW_MAX_SIZE) {
-                            size_t byte_size = sizeof_ctype * sizeof *data;
-
-                            data_size = util_size_t_min(
-                                ECL_KW_MAX_SIZE, 2 * (data_index + multiplier));
-                            byte_size *= data_size;
-
-                            data = (char *)util_realloc(data, byte_size);
-                        } else {
-                            /*
+            if (!valid_input) {
+                if (strict) {
+#ifdef HAVE_GETC_UNLOCKED
+                    funlockfile(stream);
+#endif
+                    util_abort("%s: Malformed content:\"%s\" when "
+                               "reading keyword:%s \n",
+                               __func__, buffer, header);
+                }
+                continue;
+            }
+
+            size_t min_size = data_index + multiplier;
+            if (min_size > data_size) {
+                if (min_size <= ECL_KW_MAX_SIZE) {
+                    size_t byte_size = sizeof_ctype * sizeof *data;
+
+                    data_size = util_size_t_min(ECL_KW_MAX_SIZE,
+                                                2 * (data_index + multiplier));
+                    byte_size *= data_size;
+
+                    data = (char *)util_realloc(data, byte_size);
+                } else {
+                    /*
                 We are asking for more elements than can possible be adressed in
                 an integer. Return NULL - and data size == 0; let calling scope
                 try to handle it.
               */
-                            data_index = 0;
-                            break;
-                        }
-                    }
-
-                    iset_range(data, data_index, sizeof_ctype, &value,
-                               multiplier);
-                    data_index += multiplier;
+                    data_index = 0;
+                    break;
                 }
             }
-            if (atEOF)
-                break;
-        } else
-            break;
+
+            iset_range(data, data_index, sizeof_ctype, &value, multiplier);
+            data_index += multiplier;
+        }
     }
-    free(buffer);
+#ifdef HAVE_GETC_UNLOCKED
+    funlockfile(stream);
+#endif
+
     *kw_size = data_index;
-    data = (char *)util_realloc(data, sizeof_ctype * data_index * sizeof *data);
+    if (data_index != data_size)
+        data = (char *)util_realloc(data,
+                                    sizeof_ctype * data_index * sizeof *data);
     return data;
 }
 
@@ -378,9 +422,8 @@ static char *fscanf_alloc_grdecl_data(const char *header, bool strict,
    loading of ecl_kw instances from a grdecl file can go wrong in many
    ways; if the loading fails the function returns NULL.
 
-   The main loop is extremely simple - it is just repeated calls to
-   fscanf() to read one-number-at-atime; when that reading fails that
-   is interpreted as the end of the keyword.
+   The main loop is extremely simple - it just reads one token at a
+   time until the terminating '/' is found, or reading fails at EOF.
 
    Currently ONLY integer and float types are supported in ecl_type -
    any other types will lead to a hard failure.
@@ -448,8 +491,8 @@ static ecl_kw_type *__ecl_kw_fscanf_alloc_grdecl__(FILE *stream,
         char file_header[MAX_GRDECL_HEADER_SIZE];
         if (fscanf(stream, "%s", file_header) == 1) {
             int kw_size;
-            char *data = fscanf_alloc_grdecl_data(file_header, strict,
-                                                  data_type, &kw_size, stream);
+            char *data = fscanf_alloc_grdecl_data(
+                file_header, strict, data_type, size, &kw_size, stream);
 
             // Verify size
             if (size > 0)
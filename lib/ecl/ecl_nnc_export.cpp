@@ -17,6 +17,7 @@
 */
 #include <stdlib.h>
 
+#include <unordered_map>
 #include <vector>
 
 #include <ert/ecl/ecl_file.hpp>
@@ -73,6 +74,57 @@ static int ecl_nnc_export_intersect__(const ecl_file_type *init_file,
     return ecl_kw_get_size(tran_kw); // Assume all valid
 }
 
+/*
+  Export from a grid with CSR NNC storage, see ecl_grid_init_compact_nnc().
+  This is a linear scan over the connection arrays; the transmissibility
+  keyword is looked up once per (lgr_nr1, lgr_nr2) pair instead of once
+  per cell.
+*/
+static int ecl_nnc_export_compact__(const ecl_grid_type *grid,
+                                    const ecl_grid_type *global_grid,
+                                    const ecl_grid_nnc_csr_type *csr,
+                                    const ecl_file_type *init_file,
+                                    ecl_nnc_type *nnc_data, int *nnc_offset) {
+    int nnc_index = *nnc_offset;
+    int lgr_nr1 = ecl_grid_get_lgr_nr(grid);
+    int valid_trans = 0;
+    std::unordered_map<int, const ecl_kw_type *> tran_kw_map;
+
+    for (int global_index1 = 0; global_index1 < csr->size; global_index1++) {
+        for (int i = csr->row_offset[global_index1];
+             i < csr->row_offset[global_index1 + 1]; i++) {
+            int lgr_nr2 = csr->lgr_nr[i];
+            auto tran_iter = tran_kw_map.find(lgr_nr2);
+            if (tran_iter == tran_kw_map.end())
+                tran_iter =
+                    tran_kw_map
+                        .emplace(lgr_nr2, ecl_nnc_export_get_tranx_kw(
+                                              global_grid, init_file, lgr_nr1,
+                                              lgr_nr2))
+                        .first;
+            const ecl_kw_type *tran_kw = tran_iter->second;
+
+            ecl_nnc_type nnc;
+            nnc.grid_nr1 = lgr_nr1;
+            nnc.grid_nr2 = lgr_nr2;
+            nnc.global_index1 = global_index1;
+            nnc.global_index2 = csr->global_index[i];
+            nnc.input_index = csr->nnc_index[i];
+            if (tran_kw) {
+                nnc.trans = ecl_kw_iget_as_double(tran_kw, nnc.input_index);
+                valid_trans++;
+            } else {
+                nnc.trans = ERT_ECL_DEFAULT_NNC_TRANS;
+            }
+
+            nnc_data[nnc_index] = nnc;
+            nnc_index++;
+        }
+    }
+    *nnc_offset = nnc_index;
+    return valid_trans;
+}
+
 static int ecl_nnc_export__(const ecl_grid_type *grid, int lgr_index1,
                             const ecl_file_type *init_file,
                             ecl_nnc_type *nnc_data, int *nnc_offset) {
@@ -81,10 +133,15 @@ static int ecl_nnc_export__(const ecl_grid_type *grid, int lgr_index1,
     int global_index1;
     int valid_trans = 0;
     const ecl_grid_type *global_grid = ecl_grid_get_global_grid(grid);
+    ecl_grid_nnc_csr_type csr;
 
     if (!global_grid)
         global_grid = grid;
 
+    if (ecl_grid_get_compact_nnc(grid, &csr))
+        return ecl_nnc_export_compact__(grid, global_grid, &csr, init_file,
+                                        nnc_data, nnc_offset);
+
     for (global_index1 = 0; global_index1 < ecl_grid_get_global_size(grid);
          global_index1++) {
         const nnc_info_type *nnc_info =
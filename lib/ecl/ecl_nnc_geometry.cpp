@@ -52,6 +52,25 @@ static void ecl_nnc_geometry_add_pairs(const ecl_nnc_geometry_type *nnc_geo,
     if (!global_grid)
         global_grid = grid;
 
+    ecl_grid_nnc_csr_type csr;
+    if (ecl_grid_get_compact_nnc(grid, &csr)) {
+        nnc_geo->data->reserve(nnc_geo->data->size() +
+                               csr.row_offset[csr.size]);
+        for (int global_index1 = 0; global_index1 < csr.size; global_index1++) {
+            for (int i = csr.row_offset[global_index1];
+                 i < csr.row_offset[global_index1 + 1]; i++) {
+                ecl_nnc_pair_type pair;
+                pair.grid_nr1 = lgr_nr1;
+                pair.global_index1 = global_index1;
+                pair.grid_nr2 = csr.lgr_nr[i];
+                pair.global_index2 = csr.global_index[i];
+                pair.input_index = csr.nnc_index[i];
+                nnc_geo->data->push_back(pair);
+            }
+        }
+        return;
+    }
+
     for (int global_index1 = 0; global_index1 < ecl_grid_get_global_size(grid);
          global_index1++) {
         const nnc_info_type *nnc_info =
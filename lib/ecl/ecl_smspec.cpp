@@ -36,6 +36,8 @@
 #include <ert/util/float_vector.hpp>
 #include <ert/util/stringlist.hpp>
 #include "detail/util/path.hpp"
+#include "detail/ecl/smspec_key_index.hpp"
+#include "detail/ecl/smspec_key_matcher.hpp"
 
 #include <ert/ecl/ecl_smspec.hpp>
 #include <ert/ecl/ecl_file.hpp>
@@ -111,7 +113,7 @@ struct ecl_smspec_struct {
   */
     node_map field_var_index;
     node_map misc_var_index; /* Variables like 'TCPU' and 'NEWTON'. */
-    node_map
+    ecl::smspec_key_index
         gen_var_index /* This is "everything" - things can either be found as gen_var("WWCT:OP_X") or as well_var("WWCT" , "OP_X") */
         ;
 
@@ -283,6 +285,7 @@ ecl_smspec_type *ecl_smspec_alloc_empty(bool write_mode,
 
     ecl_smspec->sim_start_time = -1;
     ecl_smspec->key_join_string = key_join_string;
+    ecl_smspec->gen_var_index = ecl::smspec_key_index(key_join_string);
     ecl_smspec->header_file = "";
 
     ecl_smspec->time_index = -1;
@@ -698,14 +701,14 @@ static void ecl_smspec_install_gen_keys(ecl_smspec_type *smspec,
     {
         const char *gen_key1 = smspec_node.get_gen_key1();
         if (gen_key1)
-            smspec->gen_var_index[gen_key1] = &smspec_node;
+            smspec->gen_var_index.insert(gen_key1, &smspec_node);
     }
 
     /* Insert the (optional) extra mapping for block related variables and region_2_region variables: */
     {
         const char *gen_key2 = smspec_node.get_gen_key2();
         if (gen_key2)
-            smspec->gen_var_index[gen_key2] = &smspec_node;
+            smspec->gen_var_index.insert(gen_key2, &smspec_node);
     }
 }
 
@@ -875,6 +878,56 @@ bool ecl_smspec_equal(const ecl_smspec_type *self,
     return true;
 }
 
+/**
+   Stricter than ecl_smspec_equal(): in addition to the list of nodes
+   this requires the same PARAMS layout, units, start time and restart
+   information. When this returns true the two headers are
+   interchangeable, and one instance can be used to load the data files
+   of both cases - this is used by the ecl_sum_ensemble loader.
+
+   The header_file field is not compared.
+*/
+bool ecl_smspec_shareable(const ecl_smspec_type *self,
+                          const ecl_smspec_type *other) {
+    if (!ecl_smspec_equal(self, other))
+        return false;
+
+    for (size_t i = 0; i < self->smspec_nodes.size(); i++) {
+        const ecl::smspec_node *node1 = self->smspec_nodes[i].get();
+        const ecl::smspec_node *node2 = other->smspec_nodes[i].get();
+
+        if (node1->get_params_index() != node2->get_params_index())
+            return false;
+
+        if (!util_string_equal(node1->get_unit(), node2->get_unit()))
+            return false;
+    }
+
+    if (self->index_map != other->index_map ||
+        self->params_size != other->params_size ||
+        self->params_default != other->params_default)
+        return false;
+
+    if (self->time_index != other->time_index ||
+        self->day_index != other->day_index ||
+        self->month_index != other->month_index ||
+        self->year_index != other->year_index ||
+        self->time_seconds != other->time_seconds)
+        return false;
+
+    for (int i = 0; i < 3; i++)
+        if (self->grid_dims[i] != other->grid_dims[i])
+            return false;
+
+    return self->sim_start_time == other->sim_start_time &&
+           self->formatted == other->formatted &&
+           self->unit_system == other->unit_system &&
+           self->has_lgr == other->has_lgr &&
+           self->key_join_string == other->key_join_string &&
+           self->restart_case == other->restart_case &&
+           self->restart_step == other->restart_step;
+}
+
 static void ecl_smspec_load_restart(ecl_smspec_type *ecl_smspec,
                                     const ecl_file_type *header) {
     if (ecl_file_has_kw(header, RESTART_KW)) {
@@ -1568,8 +1621,7 @@ int ecl_smspec_get_well_completion_var_params_index(
 const ecl::smspec_node &
 ecl_smspec_get_general_var_node(const ecl_smspec_type *smspec,
                                 const char *lookup_kw) {
-    const auto node_ptr =
-        ecl_smspec_get_var_node(smspec->gen_var_index, lookup_kw);
+    const auto node_ptr = smspec->gen_var_index.find(lookup_kw);
     if (!node_ptr)
         throw std::out_of_range("No such variable: " + std::string(lookup_kw));
 
@@ -1578,26 +1630,69 @@ ecl_smspec_get_general_var_node(const ecl_smspec_type *smspec,
 
 int ecl_smspec_get_general_var_params_index(const ecl_smspec_type *ecl_smspec,
                                             const char *lookup_kw) {
-    const auto node_ptr =
-        ecl_smspec_get_var_node(ecl_smspec->gen_var_index, lookup_kw);
+    const auto node_ptr = ecl_smspec->gen_var_index.find(lookup_kw);
     return node_valid_index(node_ptr);
 }
 
 bool ecl_smspec_has_general_var(const ecl_smspec_type *ecl_smspec,
                                 const char *lookup_kw) {
-    const auto node_ptr =
-        ecl_smspec_get_var_node(ecl_smspec->gen_var_index, lookup_kw);
+    const auto node_ptr = ecl_smspec->gen_var_index.find(lookup_kw);
     return node_exists(node_ptr);
 }
 
 /** DIES if the lookup_kw is not present. */
 const char *ecl_smspec_get_general_var_unit(const ecl_smspec_type *ecl_smspec,
                                             const char *lookup_kw) {
-    const auto smspec_node =
+    const auto &smspec_node =
         ecl_smspec_get_general_var_node(ecl_smspec, lookup_kw);
     return smspec_node_get_unit(&smspec_node);
 }
 
+/**
+   The ecl_smspec_key type holds a general key along with its hash
+   value. When the same key is looked up in many ecl_smspec instances,
+   e.g. all the cases in an ensemble, the hashing is done only once.
+   The key instance is independent of the ecl_smspec instances.
+*/
+
+#define ECL_SMSPEC_KEY_ID 806648
+
+struct ecl_smspec_key_struct {
+    UTIL_TYPE_ID_DECLARATION;
+    std::string key;
+    uint64_t hash;
+};
+
+ecl_smspec_key_type *ecl_smspec_key_alloc(const char *gen_key) {
+    ecl_smspec_key_type *key = new ecl_smspec_key_type();
+    UTIL_TYPE_ID_INIT(key, ECL_SMSPEC_KEY_ID);
+    key->key = gen_key;
+    key->hash = ecl::smspec_key_index::hash(gen_key);
+    return key;
+}
+
+void ecl_smspec_key_free(ecl_smspec_key_type *key) { delete key; }
+
+const char *ecl_smspec_key_get_key(const ecl_smspec_key_type *key) {
+    return key->key.c_str();
+}
+
+/** Returns NULL if the key is not present. */
+const ecl::smspec_node *ecl_smspec_get_key_node(const ecl_smspec_type *smspec,
+                                                const ecl_smspec_key_type *key) {
+    return smspec->gen_var_index.find(key->key.c_str(), key->hash);
+}
+
+/** Returns -1 if the key is not present. */
+int ecl_smspec_get_key_params_index(const ecl_smspec_type *smspec,
+                                    const ecl_smspec_key_type *key) {
+    const ecl::smspec_node *node = ecl_smspec_get_key_node(smspec, key);
+    if (!node)
+        return -1;
+
+    return node->get_params_index();
+}
+
 int ecl_smspec_get_time_seconds(const ecl_smspec_type *ecl_smspec) {
     return ecl_smspec->time_seconds;
 }
@@ -1673,6 +1768,29 @@ bool ecl_smspec_general_is_total(const ecl_smspec_type *smspec,
     return smspec_node_is_total(&smspec_node);
 }
 
+/*
+  Appends the keys selected by @matcher which are not already in @keys,
+  and sorts the list.
+*/
+
+static void
+ecl_smspec_select_matching_keys__(const ecl_smspec_type *smspec,
+                                  const ecl::smspec_key_matcher &matcher,
+                                  stringlist_type *keys) {
+    std::set<std::string> ex_keys;
+    for (int i = 0; i < stringlist_get_size(keys); i++)
+        ex_keys.insert(stringlist_iget(keys, i));
+
+    const auto &entries = smspec->gen_var_index.entries();
+    for (size_t entry : matcher.select(smspec->gen_var_index)) {
+        const std::string &key = entries[entry].first;
+        if (ex_keys.find(key) == ex_keys.end())
+            stringlist_append_copy(keys, key.c_str());
+    }
+
+    stringlist_sort(keys, (string_cmp_ftype *)util_strcmp_int);
+}
+
 /**
    Fills a stringlist instance with all the gen_key string matching
    the supplied pattern. I.e.
@@ -1693,31 +1811,9 @@ bool ecl_smspec_general_is_total(const ecl_smspec_type *smspec,
 void ecl_smspec_select_matching_general_var_list(const ecl_smspec_type *smspec,
                                                  const char *pattern,
                                                  stringlist_type *keys) {
-    std::set<std::string> ex_keys;
-    for (int i = 0; i < stringlist_get_size(keys); i++)
-        ex_keys.insert(stringlist_iget(keys, i));
-
-    {
-        for (const auto &pair : smspec->gen_var_index) {
-            const char *key = pair.first.c_str();
-
-            /*
-         The TIME is typically special cased by output and will not
-         match the 'all keys' wildcard.
-      */
-            if (util_string_equal(key, "TIME")) {
-                if ((pattern == NULL) || (util_string_equal(pattern, "*")))
-                    continue;
-            }
-
-            if ((pattern == NULL) || (util_fnmatch(pattern, key) == 0)) {
-                if (ex_keys.find(key) == ex_keys.end())
-                    stringlist_append_copy(keys, key);
-            }
-        }
-    }
-
-    stringlist_sort(keys, (string_cmp_ftype *)util_strcmp_int);
+    ecl::smspec_key_matcher matcher({pattern ? pattern : "*"},
+                                    smspec->key_join_string);
+    ecl_smspec_select_matching_keys__(smspec, matcher, keys);
 }
 
 /**
@@ -1733,6 +1829,51 @@ ecl_smspec_alloc_matching_general_var_list(const ecl_smspec_type *smspec,
     return keys;
 }
 
+/**
+   The ecl_smspec_matcher type is a precompiled set of key patterns,
+   which can be used to select the matching keys from many ecl_smspec
+   instances. All the patterns are matched in one pass, and patterns
+   like "WOPR:*" only look at the keys starting with "WOPR:" - the
+   key_join_string should be the same as for the smspec instances.
+*/
+
+#define ECL_SMSPEC_MATCHER_ID 806649
+
+struct ecl_smspec_matcher_struct {
+    UTIL_TYPE_ID_DECLARATION;
+    std::unique_ptr<ecl::smspec_key_matcher> matcher;
+};
+
+ecl_smspec_matcher_type *
+ecl_smspec_matcher_alloc(const stringlist_type *patterns,
+                         const char *key_join_string) {
+    std::vector<std::string> pattern_list;
+    for (int i = 0; i < stringlist_get_size(patterns); i++)
+        pattern_list.push_back(stringlist_iget(patterns, i));
+
+    ecl_smspec_matcher_type *matcher = new ecl_smspec_matcher_type();
+    UTIL_TYPE_ID_INIT(matcher, ECL_SMSPEC_MATCHER_ID);
+    matcher->matcher.reset(
+        new ecl::smspec_key_matcher(pattern_list, key_join_string));
+    return matcher;
+}
+
+void ecl_smspec_matcher_free(ecl_smspec_matcher_type *matcher) {
+    delete matcher;
+}
+
+/**
+   Works as ecl_smspec_select_matching_general_var_list() for all the
+   patterns in the matcher; a key matching several patterns is only
+   added once.
+*/
+
+void ecl_smspec_select_matching_keys(const ecl_smspec_type *smspec,
+                                     const ecl_smspec_matcher_type *matcher,
+                                     stringlist_type *keys) {
+    ecl_smspec_select_matching_keys__(smspec, *matcher->matcher, keys);
+}
+
 const char *ecl_smspec_get_join_string(const ecl_smspec_type *smspec) {
     return smspec->key_join_string.c_str();
 }
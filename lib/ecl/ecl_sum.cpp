@@ -16,7 +16,11 @@
    for more details.
 */
 
+#include <algorithm>
+#include <charconv>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <string.h>
 #include <stdbool.h>
@@ -24,6 +28,7 @@
 #include <time.h>
 #include <locale.h>
 
+#include <ert/util/build_config.h>
 #include <ert/util/hash.hpp>
 #include <ert/util/util.h>
 #include <ert/util/util.h>
@@ -42,6 +47,12 @@
 #include <ert/ecl/smspec_node.hpp>
 
 #include "detail/util/path.hpp"
+#include "detail/ecl/ecl_sum_shared_smspec.hpp"
+#include "detail/ecl/ecl_sum_columns_format.hpp"
+
+#ifdef ERT_HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 /**
    The ECLIPSE summary data is organised in a header file (.SMSPEC)
@@ -92,9 +103,13 @@
 struct ecl_sum_struct {
     UTIL_TYPE_ID_DECLARATION;
     ecl_smspec_type *smspec; /* Internalized version of the SMSPEC file. */
+    bool shared_smspec; /* The smspec is owned by someone else. */
+    char *
+        header_file; /* The SMSPEC file of this case - with a shared smspec the header file of the smspec can belong to another case. */
     ecl_sum_data_type *data; /* The data - can be NULL. */
     ecl_sum_type *restart_case;
 
+    bool stream_writer; /* See ecl_sum_alloc_stream_writer(). */
     bool fmt_case;
     bool unified;
     char *key_join_string;
@@ -171,8 +186,11 @@ static ecl_sum_type *ecl_sum_alloc__(const char *input_arg,
     ecl_sum->key_join_string = util_alloc_string_copy(key_join_string);
 
     ecl_sum->smspec = NULL;
+    ecl_sum->shared_smspec = false;
+    ecl_sum->header_file = NULL;
     ecl_sum->data = NULL;
     ecl_sum->restart_case = NULL;
+    ecl_sum->stream_writer = false;
 
     return ecl_sum;
 }
@@ -185,6 +203,7 @@ static bool ecl_sum_fread_data(ecl_sum_type *ecl_sum,
         ecl_sum_free_data(ecl_sum);
 
     ecl_sum->data = ecl_sum_data_alloc(ecl_sum->smspec);
+    ecl_sum_data_set_header_file(ecl_sum->data, ecl_sum->header_file);
     return ecl_sum_data_fread(ecl_sum->data, data_files, lazy_load,
                               file_options);
 }
@@ -203,14 +222,21 @@ static void ecl_sum_fread_history(ecl_sum_type *ecl_sum, bool lazy_load,
     free(restart_header);
 }
 
-static bool ecl_sum_fread(ecl_sum_type *ecl_sum, const char *header_file,
-                          const stringlist_type *data_files,
-                          bool include_restart, bool lazy_load,
-                          int file_options) {
+static bool
+ecl_sum_fread(ecl_sum_type *ecl_sum, const char *header_file,
+              const stringlist_type *data_files, bool include_restart,
+              bool lazy_load, int file_options,
+              const ecl::share_smspec_ftype *share_smspec = nullptr) {
     ecl_sum->smspec = ecl_smspec_fread_alloc(
         header_file, ecl_sum->key_join_string, include_restart);
     if (ecl_sum->smspec) {
+        free(ecl_sum->header_file);
+        ecl_sum->header_file = util_alloc_string_copy(header_file);
         bool fmt_file;
+        if (share_smspec) {
+            ecl_sum->smspec = (*share_smspec)(ecl_sum->smspec);
+            ecl_sum->shared_smspec = true;
+        }
         ecl_util_get_file_type(header_file, &fmt_file, NULL);
         ecl_sum_set_fmt_case(ecl_sum, fmt_file);
     } else
@@ -238,8 +264,10 @@ static bool ecl_sum_fread(ecl_sum_type *ecl_sum, const char *header_file,
     return true;
 }
 
-static bool ecl_sum_fread_case(ecl_sum_type *ecl_sum, bool include_restart,
-                               bool lazy_load, int file_options) {
+static bool
+ecl_sum_fread_case(ecl_sum_type *ecl_sum, bool include_restart, bool lazy_load,
+                   int file_options,
+                   const ecl::share_smspec_ftype *share_smspec = nullptr) {
     char *header_file;
     stringlist_type *summary_file_list = stringlist_alloc_new();
 
@@ -249,7 +277,8 @@ static bool ecl_sum_fread_case(ecl_sum_type *ecl_sum, bool include_restart,
                                  &header_file, summary_file_list);
     if ((header_file != NULL) && (stringlist_get_size(summary_file_list) > 0)) {
         caseOK = ecl_sum_fread(ecl_sum, header_file, summary_file_list,
-                               include_restart, lazy_load, file_options);
+                               include_restart, lazy_load, file_options,
+                               share_smspec);
     }
     free(header_file);
     stringlist_free(summary_file_list);
@@ -322,6 +351,13 @@ const ecl::smspec_node *ecl_sum_add_smspec_node(ecl_sum_type *ecl_sum,
 
 ecl_sum_tstep_type *ecl_sum_add_tstep(ecl_sum_type *ecl_sum, int report_step,
                                       double sim_seconds) {
+    /*
+      For a streaming writer the smspec is complete when the first
+      timestep is added, and must be on disk before the data.
+    */
+    if (ecl_sum->stream_writer && ecl_sum_data_get_length(ecl_sum->data) == 0)
+        ecl_sum_fwrite_smspec(ecl_sum);
+
     ecl_sum_tstep_type *new_tstep =
         ecl_sum_data_add_new_tstep(ecl_sum->data, report_step, sim_seconds);
     return new_tstep;
@@ -387,12 +423,62 @@ ecl_sum_type *ecl_sum_alloc_writer(const char *ecl_case, bool fmt_output,
                                   ny, nz);
 }
 
+/**
+   Allocates a writer, like ecl_sum_alloc_restart_writer2() -
+   @restart_case can be NULL, which writes the data as it is produced
+   instead of keeping everything in memory until ecl_sum_fwrite():
+
+   - The SMSPEC file is written when the first timestep is added, all
+     the variables must have been added before that.
+
+   - When a timestep with a new report step is added the timesteps of
+     the previous report step(s) are written to the summary file(s)
+     through a large buffer, and released. The timesteps must be added
+     in order, and a tstep pointer is only valid until a timestep with
+     a new report step has been added.
+
+   - ecl_sum_fwrite() writes the pending timesteps and flushes the
+     file; the file is closed by ecl_sum_free().
+
+   The time axis is kept in memory, but the values of the timesteps
+   which have been written can not be queried from the writer.
+*/
+
+ecl_sum_type *
+ecl_sum_alloc_stream_writer(const char *ecl_case, const char *restart_case,
+                            int restart_step, bool fmt_output, bool unified,
+                            const char *key_join_string, time_t sim_start,
+                            bool time_in_days, int nx, int ny, int nz) {
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer__(
+        ecl_case, restart_case, restart_step, fmt_output, unified,
+        key_join_string, sim_start, time_in_days, nx, ny, nz);
+    if (ecl_sum) {
+        ecl_sum->stream_writer = true;
+        ecl_sum_data_stream_open(ecl_sum->data, ecl_sum->ecl_case,
+                                 ecl_sum->fmt_case, ecl_sum->unified);
+    }
+    return ecl_sum;
+}
+
 void ecl_sum_fwrite(const ecl_sum_type *ecl_sum) {
     ecl_sum_fwrite_smspec(ecl_sum);
     ecl_sum_data_fwrite(ecl_sum->data, ecl_sum->ecl_case, ecl_sum->fmt_case,
                         ecl_sum->unified);
 }
 
+/**
+   Will load the timesteps which have been added to the summary file(s)
+   since the ecl_sum instance was loaded, e.g. while the simulation is
+   still running; this is much cheaper than loading the case again. Only
+   unified summary files are followed; a partially written timestep at
+   the end of the file is picked up by a later refresh when it is
+   complete. Returns the number of new timesteps.
+*/
+
+int ecl_sum_refresh(ecl_sum_type *ecl_sum) {
+    return ecl_sum_data_refresh(ecl_sum->data);
+}
+
 bool ecl_sum_can_write(const ecl_sum_type *ecl_sum) {
     return ecl_sum_data_can_write(ecl_sum->data);
 }
@@ -419,7 +505,7 @@ void ecl_sum_free(ecl_sum_type *ecl_sum) {
     if (ecl_sum->data)
         ecl_sum_free_data(ecl_sum);
 
-    if (ecl_sum->smspec)
+    if (ecl_sum->smspec && !ecl_sum->shared_smspec)
         ecl_smspec_free(ecl_sum->smspec);
 
     free(ecl_sum->path);
@@ -430,6 +516,7 @@ void ecl_sum_free(ecl_sum_type *ecl_sum) {
     free(ecl_sum->ecl_case);
 
     free(ecl_sum->key_join_string);
+    free(ecl_sum->header_file);
     free(ecl_sum);
 }
 
@@ -477,6 +564,31 @@ ecl_sum_type *ecl_sum_fread_alloc_case2__(const char *input_file,
     }
 }
 
+/**
+   As ecl_sum_fread_alloc_case2__(), but the SMSPEC header is passed
+   through the @share_smspec callback after it has been loaded, so that
+   several cases can use the same ecl_smspec instance. The returned
+   ecl_sum instance does not own its smspec. Restarted history is loaded
+   with separate headers.
+*/
+ecl_sum_type *
+ecl_sum_fread_alloc_case_shared(const char *input_file,
+                                const char *key_join_string,
+                                bool include_restart, bool lazy_load,
+                                int file_options,
+                                const ecl::share_smspec_ftype &share_smspec) {
+    ecl_sum_type *ecl_sum = ecl_sum_alloc__(input_file, key_join_string);
+    if (!ecl_sum)
+        return NULL;
+
+    if (ecl_sum_fread_case(ecl_sum, include_restart, lazy_load, file_options,
+                           &share_smspec))
+        return ecl_sum;
+
+    ecl_sum_free(ecl_sum);
+    return NULL;
+}
+
 ecl_sum_type *ecl_sum_fread_alloc_case__(const char *input_file,
                                          const char *key_join_string,
                                          bool include_restart) {
@@ -749,6 +861,22 @@ bool ecl_sum_has_key(const ecl_sum_type *ecl_sum, const char *lookup_kw) {
     return ecl_sum_has_general_var(ecl_sum, lookup_kw);
 }
 
+/**
+   Lookup with a key prepared with ecl_smspec_key_alloc(); the node is
+   NULL and the params index -1 if the key is not present. The params
+   index can be used with ecl_sum_iget() and related functions.
+*/
+
+const ecl::smspec_node *ecl_sum_get_key_node(const ecl_sum_type *ecl_sum,
+                                             const ecl_smspec_key_type *key) {
+    return ecl_smspec_get_key_node(ecl_sum->smspec, key);
+}
+
+int ecl_sum_get_key_params_index(const ecl_sum_type *ecl_sum,
+                                 const ecl_smspec_key_type *key) {
+    return ecl_smspec_get_key_params_index(ecl_sum->smspec, key);
+}
+
 double ecl_sum_get_general_var(const ecl_sum_type *ecl_sum, int time_index,
                                const char *lookup_kw) {
     int params_index = ecl_sum_get_general_var_params_index(ecl_sum, lookup_kw);
@@ -842,53 +970,32 @@ ecl_sum_type *ecl_sum_alloc_resample(const ecl_sum_type *ecl_sum,
 
   */
     ecl_sum_vector_type *ecl_sum_vector = ecl_sum_vector_alloc(ecl_sum, true);
-    double_vector_type *data =
-        double_vector_alloc(ecl_sum_vector_get_size(ecl_sum_vector), 0);
+    int num_keys = ecl_sum_vector_get_size(ecl_sum_vector);
+    std::vector<double> data(time_t_vector_size(times) * num_keys);
+
+    /*
+      All the vectors are interpolated in one go; for t < start_time the
+      first value is used, and for t > end_time the last value - or zero
+      if the vector is a rate.
+    */
+    ecl_sum_init_double_frame_interp(ecl_sum, ecl_sum_vector, times,
+                                     data.data());
 
     for (int report_step = 0; report_step < time_t_vector_size(times);
          report_step++) {
         time_t input_t = time_t_vector_iget(times, report_step);
-        if (input_t < start_time) {
-            //clamping to the first value for t < start_time or if it is a rate than derivative is 0
-            for (int i = 1; i < ecl_smspec_num_nodes(ecl_sum->smspec); i++) {
-                double value = 0;
-                const ecl::smspec_node &node =
-                    ecl_smspec_iget_node_w_node_index(ecl_sum->smspec, i);
-                if (!node.is_rate())
-                    value = ecl_sum_iget_first_value(ecl_sum,
-                                                     node.get_params_index());
-                double_vector_iset(data, i - 1, value);
-            }
-        } else if (input_t > end_time) {
-            //clamping to the last value for t > end_time or if it is a rate than derivative is 0
-            for (int i = 1; i < ecl_smspec_num_nodes(ecl_sum->smspec); i++) {
-                double value = 0;
-                const ecl::smspec_node &node =
-                    ecl_smspec_iget_node_w_node_index(ecl_sum->smspec, i);
-                if (!node.is_rate())
-                    value = ecl_sum_iget_last_value(ecl_sum,
-                                                    node.get_params_index());
-                double_vector_iset(data, i - 1, value);
-            }
-        } else {
-            /* Look up interpolated data in the original case. */
-            ecl_sum_get_interp_vector(ecl_sum, input_t, ecl_sum_vector, data);
-        }
 
         /* Add timestep corresponding to the interpolated data in the resampled case. */
         ecl_sum_tstep_type *tstep = ecl_sum_add_tstep(
             ecl_sum_resampled, report_step, input_t - input_start);
-        for (int data_index = 0;
-             data_index < ecl_sum_vector_get_size(ecl_sum_vector);
-             data_index++) {
-            double value = double_vector_iget(data, data_index);
+        for (int data_index = 0; data_index < num_keys; data_index++) {
+            double value = data[report_step * num_keys + data_index];
             int params_index =
                 data_index +
                 1; // The +1 shift is because the first element in the tstep is time value.
             ecl_sum_tstep_iset(tstep, params_index, value);
         }
     }
-    double_vector_free(data);
     ecl_sum_vector_free(ecl_sum_vector);
     return ecl_sum_resampled;
 }
@@ -1134,37 +1241,137 @@ void ecl_sum_fmt_init_summary_x(const ecl_sum_type *ecl_sum,
 #define DATE_HEADER "-- Days   dd/mm/yyyy   "
 #define DATE_STRING_LENGTH 128
 
-static void __ecl_sum_fprintf_line(const ecl_sum_type *ecl_sum, FILE *stream,
-                                   int internal_index,
-                                   const bool_vector_type *has_var,
-                                   const int_vector_type *var_index,
-                                   char *date_string,
-                                   const ecl_sum_fmt_type *fmt) {
-    fprintf(stream, fmt->days_fmt,
-            ecl_sum_iget_sim_days(ecl_sum, internal_index));
-    fprintf(stream, "%s", fmt->sep);
+/*
+  The rows are fetched and formatted in blocks holding at most this
+  many values.
+*/
+#define ECL_SUM_FPRINTF_BLOCK_SIZE (1 << 20)
 
-    {
-        struct tm ts;
-        time_t sim_time = ecl_sum_iget_sim_time(ecl_sum, internal_index);
-        util_time_utc(&sim_time, &ts);
-        strftime(date_string, DATE_STRING_LENGTH - 1, fmt->date_fmt, &ts);
-        fprintf(stream, "%s", date_string);
+/*
+  Whether the strftime() format @date_fmt only depends on the date, so
+  that the formatted string can be reused for all the ministeps of one
+  day.
+*/
+static bool ecl_sum_date_fmt_daily(const char *date_fmt) {
+    for (const char *c = date_fmt; *c; c++) {
+        if (*c != '%')
+            continue;
+
+        c++;
+        while (*c && strchr("EO_-0^#", *c))
+            c++;
+        if (!*c)
+            break;
+
+        if (strchr("cHIklMpPrRsSTX+", *c))
+            return false;
     }
+    return true;
+}
 
-    {
-        int ivar;
-        for (ivar = 0; ivar < int_vector_size(var_index); ivar++) {
-            if (bool_vector_iget(has_var, ivar)) {
-                fprintf(stream, "%s", fmt->sep);
-                fprintf(stream, fmt->value_fmt,
-                        ecl_sum_iget(ecl_sum, internal_index,
-                                     int_vector_iget(var_index, ivar)));
-            }
+static void ecl_sum_append_value(std::string &line, const char *value_fmt,
+                                 double value) {
+    char buffer[64];
+    int length;
+
+    if (value_fmt) {
+        length = snprintf(buffer, sizeof buffer, value_fmt, value);
+        if (length >= (int)sizeof buffer) {
+            char *value_string = util_alloc_sprintf(value_fmt, value);
+            line += value_string;
+            free(value_string);
+            return;
         }
+    } else {
+        /*
+          The summary data are stored in single precision, so the
+          shortest representation which reads back to the same float
+          is an exact representation of the value.
+        */
+#ifdef HAVE_FLOAT_TO_CHARS
+        std::to_chars_result result =
+            std::to_chars(buffer, buffer + sizeof buffer, (float)value);
+        length = result.ptr - buffer;
+#else
+        length = snprintf(buffer, sizeof buffer, "%.9g", value);
+#endif
     }
+    line.append(buffer, length);
+}
 
-    fprintf(stream, "%s", fmt->newline);
+/*
+  Writes the lines for the ministeps @time_indices, with the values for
+  @var_index; a negative entry in @var_index gives an empty field. The
+  values are fetched and formatted a block of rows at a time, and the
+  date string is only formatted again when the date changes. When
+  @fmt->value_fmt is NULL the values are written with the shortest
+  representation which reads back to the same value.
+*/
+static void ecl_sum_fprintf_rows(const ecl_sum_type *ecl_sum, FILE *stream,
+                                 const std::vector<int> &time_indices,
+                                 const std::vector<int> &var_index,
+                                 const ecl_sum_fmt_type *fmt) {
+    const int num_vars = var_index.size();
+    const int num_rows = time_indices.size();
+    const int block_rows = std::max(
+        1, std::min(num_rows,
+                    ECL_SUM_FPRINTF_BLOCK_SIZE / std::max(num_vars, 1)));
+    const bool daily_date = ecl_sum_date_fmt_daily(fmt->date_fmt);
+    const size_t sep_length = strlen(fmt->sep);
+
+    std::vector<double> values((size_t)block_rows * num_vars);
+    std::vector<std::string> lines(block_rows);
+    std::string date_string;
+    time_t date_day = -1;
+
+    for (int block_start = 0; block_start < num_rows;
+         block_start += block_rows) {
+        int block_size = std::min(block_rows, num_rows - block_start);
+        ecl_sum_data_init_double_frame_rows(
+            ecl_sum->data, &time_indices[block_start], block_size,
+            var_index.data(), num_vars, values.data());
+
+        for (int row = 0; row < block_size; row++) {
+            int time_index = time_indices[block_start + row];
+            std::string &line = lines[row];
+            char buffer[DATE_STRING_LENGTH];
+
+            line.clear();
+            snprintf(buffer, sizeof buffer, fmt->days_fmt,
+                     ecl_sum_iget_sim_days(ecl_sum, time_index));
+            line += buffer;
+            line += fmt->sep;
+
+            time_t sim_time = ecl_sum_iget_sim_time(ecl_sum, time_index);
+            time_t day = sim_time / 86400 - (sim_time % 86400 < 0);
+            if (!daily_date || day != date_day) {
+                struct tm ts;
+                util_time_utc(&sim_time, &ts);
+                strftime(buffer, DATE_STRING_LENGTH - 1, fmt->date_fmt, &ts);
+                date_string = buffer;
+                date_day = day;
+            }
+            line += date_string;
+        }
+
+#pragma omp parallel for schedule(static)
+        for (int row = 0; row < block_size; row++) {
+            std::string &line = lines[row];
+            const double *row_values = &values[(size_t)row * num_vars];
+
+            line.reserve(line.size() + num_vars * (sep_length + 16));
+            for (int ivar = 0; ivar < num_vars; ivar++) {
+                line.append(fmt->sep, sep_length);
+                if (var_index[ivar] >= 0)
+                    ecl_sum_append_value(line, fmt->value_fmt,
+                                         row_values[ivar]);
+            }
+            line += fmt->newline;
+        }
+
+        for (int row = 0; row < block_size; row++)
+            fwrite(lines[row].data(), 1, lines[row].size(), stream);
+    }
 }
 
 static void ecl_sum_fprintf_header(const ecl_sum_type *ecl_sum,
@@ -1195,15 +1402,32 @@ static void ecl_sum_fprintf_header(const ecl_sum_type *ecl_sum,
     }
 }
 
+static std::vector<int>
+ecl_sum_fprintf_time_indices(const ecl_sum_type *ecl_sum, bool report_only) {
+    std::vector<int> time_indices;
+    if (report_only) {
+        int first_report = ecl_sum_get_first_report_step(ecl_sum);
+        int last_report = ecl_sum_get_last_report_step(ecl_sum);
+
+        for (int report = first_report; report <= last_report; report++) {
+            if (ecl_sum_data_has_report_step(ecl_sum->data, report))
+                time_indices.push_back(
+                    ecl_sum_data_iget_report_end(ecl_sum->data, report));
+        }
+    } else {
+        for (int time_index = 0; time_index < ecl_sum_get_data_length(ecl_sum);
+             time_index++)
+            time_indices.push_back(time_index);
+    }
+    return time_indices;
+}
+
 void ecl_sum_fprintf(const ecl_sum_type *ecl_sum, FILE *stream,
                      const stringlist_type *var_list, bool report_only,
                      const ecl_sum_fmt_type *fmt) {
     bool_vector_type *has_var =
         bool_vector_alloc(stringlist_get_size(var_list), false);
-    int_vector_type *var_index =
-        int_vector_alloc(stringlist_get_size(var_list), -1);
-    char *date_string =
-        (char *)util_malloc(DATE_STRING_LENGTH * sizeof *date_string);
+    std::vector<int> var_index;
 
     char *current_locale = NULL;
     if (fmt->locale != NULL)
@@ -1215,9 +1439,8 @@ void ecl_sum_fprintf(const ecl_sum_type *ecl_sum, FILE *stream,
             if (ecl_sum_has_general_var(ecl_sum,
                                         stringlist_iget(var_list, ivar))) {
                 bool_vector_iset(has_var, ivar, true);
-                int_vector_iset(var_index, ivar,
-                                ecl_sum_get_general_var_params_index(
-                                    ecl_sum, stringlist_iget(var_list, ivar)));
+                var_index.push_back(ecl_sum_get_general_var_params_index(
+                    ecl_sum, stringlist_iget(var_list, ivar)));
             } else {
                 fprintf(stderr,
                         "** Warning: could not find variable: \'%s\' in "
@@ -1231,33 +1454,13 @@ void ecl_sum_fprintf(const ecl_sum_type *ecl_sum, FILE *stream,
     if (fmt->print_header)
         ecl_sum_fprintf_header(ecl_sum, var_list, has_var, stream, fmt);
 
-    if (report_only) {
-        int first_report = ecl_sum_get_first_report_step(ecl_sum);
-        int last_report = ecl_sum_get_last_report_step(ecl_sum);
-        int report;
-
-        for (report = first_report; report <= last_report; report++) {
-            if (ecl_sum_data_has_report_step(ecl_sum->data, report)) {
-                int time_index;
-                time_index =
-                    ecl_sum_data_iget_report_end(ecl_sum->data, report);
-                __ecl_sum_fprintf_line(ecl_sum, stream, time_index, has_var,
-                                       var_index, date_string, fmt);
-            }
-        }
-    } else {
-        int time_index;
-        for (time_index = 0; time_index < ecl_sum_get_data_length(ecl_sum);
-             time_index++)
-            __ecl_sum_fprintf_line(ecl_sum, stream, time_index, has_var,
-                                   var_index, date_string, fmt);
-    }
+    ecl_sum_fprintf_rows(ecl_sum, stream,
+                         ecl_sum_fprintf_time_indices(ecl_sum, report_only),
+                         var_index, fmt);
 
-    int_vector_free(var_index);
     bool_vector_free(has_var);
     if (current_locale != NULL)
         setlocale(LC_NUMERIC, current_locale);
-    free(date_string);
 }
 #undef DATE_STRING_LENGTH
 
@@ -1289,6 +1492,260 @@ void ecl_sum_export_csv(const ecl_sum_type *ecl_sum, const char *filename,
     free(date_header);
 }
 
+/**
+   Exports the vectors in @keys as csv, in the same layout as
+   ecl_sum_export_csv(). The values are written with the shortest
+   representation which reads back to the stored value, instead of
+   with "%g". Keys in @keys which are not present in @ecl_sum, see
+   ecl_sum_vector_alloc_layout(), give empty columns.
+*/
+
+void ecl_sum_export_csv_vector(const ecl_sum_type *ecl_sum,
+                               const char *filename,
+                               const ecl_sum_vector_type *keys,
+                               const char *date_format, const char *sep) {
+    FILE *stream = util_mkdir_fopen(filename, "w");
+    char *date_header = util_alloc_sprintf("DAYS%sDATE", sep);
+    int num_keys = ecl_sum_vector_get_size(keys);
+    stringlist_type *key_list = stringlist_alloc_new();
+    bool_vector_type *has_var = bool_vector_alloc(num_keys, true);
+    std::vector<int> var_index;
+
+    for (int i = 0; i < num_keys; i++) {
+        stringlist_append_copy(key_list, ecl_sum_vector_iget_key(keys, i));
+        if (ecl_sum_vector_iget_valid(keys, i))
+            var_index.push_back(ecl_sum_vector_iget_param_index(keys, i));
+        else
+            var_index.push_back(-1);
+    }
+
+    ecl_sum_fmt_type fmt;
+    ecl_sum_fmt_init_csv(&fmt, date_format, date_header, sep);
+    fmt.value_fmt = NULL;
+    ecl_sum_fprintf_header(ecl_sum, key_list, has_var, stream, &fmt);
+    ecl_sum_fprintf_rows(ecl_sum, stream,
+                         ecl_sum_fprintf_time_indices(ecl_sum, false),
+                         var_index, &fmt);
+
+    fclose(stream);
+    bool_vector_free(has_var);
+    stringlist_free(key_list);
+    free(date_header);
+}
+
+/*
+  When no row group size is given to ecl_sum_export_columns() the row
+  groups are made so that each holds approximately this many bytes of
+  summary data.
+*/
+#define ECL_SUM_COLUMNS_ROW_GROUP_BYTES (1 << 26)
+
+static uint32_t ecl_sum_columns_add_string(std::string &strings,
+                                           const char *s) {
+    uint32_t offset = strings.size();
+    if (s)
+        strings.append(s);
+    strings.push_back('\0');
+    return offset;
+}
+
+static void ecl_sum_columns_add_column(
+    std::vector<ecl::sum_columns::column_header> &columns,
+    std::string &strings, uint32_t data_type, const char *key,
+    const char *keyword, const char *unit) {
+    ecl::sum_columns::column_header column = {};
+    column.data_type = data_type;
+    column.key = ecl_sum_columns_add_string(strings, key);
+    column.keyword = ecl_sum_columns_add_string(strings, keyword);
+    column.wgname = ecl_sum_columns_add_string(strings, NULL);
+    column.unit = ecl_sum_columns_add_string(strings, unit);
+    column.var_type = ECL_SMSPEC_MISC_VAR;
+    columns.push_back(column);
+}
+
+static void ecl_sum_columns_fwrite_chunk(FILE *stream,
+                                         ecl::sum_columns::chunk_header &chunk,
+                                         const void *data, size_t size,
+                                         bool use_compression) {
+    static const char padding[ecl::sum_columns::COLUMN_ALIGNMENT] = {0};
+    offset_type offset = util_ftell(stream);
+    offset_type pad = (ecl::sum_columns::COLUMN_ALIGNMENT -
+                       offset % ecl::sum_columns::COLUMN_ALIGNMENT) %
+                      ecl::sum_columns::COLUMN_ALIGNMENT;
+    util_fwrite(padding, 1, pad, stream, __func__);
+
+    chunk.offset = offset + pad;
+    chunk.size = size;
+    chunk.stored_size = size;
+    chunk.compression = ecl::sum_columns::COMPRESSION_NONE;
+
+#ifdef ERT_HAVE_ZLIB
+    /*
+      Chunks which do not get smaller, e.g. short chunks or floats with
+      noisy low bits, are stored as is.
+    */
+    if (use_compression && size > 0) {
+        uLongf zsize = compressBound(size);
+        std::vector<Bytef> zbuffer(zsize);
+        if (compress2(zbuffer.data(), &zsize, (const Bytef *)data, size,
+                      Z_BEST_SPEED) == Z_OK &&
+            zsize < size) {
+            util_fwrite(zbuffer.data(), 1, zsize, stream, __func__);
+            chunk.stored_size = zsize;
+            chunk.compression = ecl::sum_columns::COMPRESSION_ZLIB;
+            return;
+        }
+    }
+#endif
+    util_fwrite(data, 1, size, stream, __func__);
+}
+
+/**
+   Exports the time axis and the vectors in @keys as a columnar binary
+   file which can be read back, memory mapped, with
+   ecl_sum_columns_fread_alloc(). The metadata of each vector is taken
+   from the smspec_node; keys in @keys which are not present in
+   @ecl_sum, see ecl_sum_vector_alloc_layout(), are not exported.
+
+   The rows are written in row groups of @row_group_size rows; if
+   @row_group_size <= 0 the size of the row groups is chosen based on
+   the number of keys. The data is assembled one row group at a time,
+   so a lazily loaded case is only read once. When @compress is true
+   each chunk is compressed with zlib; the flag is ignored if the
+   library has been built without zlib.
+*/
+
+void ecl_sum_export_columns(const ecl_sum_type *ecl_sum, const char *filename,
+                            const ecl_sum_vector_type *keys, int row_group_size,
+                            bool compress) {
+    namespace sc = ecl::sum_columns;
+    int num_rows = ecl_sum_get_data_length(ecl_sum);
+    std::vector<sc::column_header> columns;
+    std::vector<int> params_indices;
+    std::string strings;
+
+    ecl_sum_columns_add_column(columns, strings, sc::DATA_INT64, "TIME",
+                               "TIME", "SECONDS");
+    ecl_sum_columns_add_column(columns, strings, sc::DATA_DOUBLE, "DAYS",
+                               "DAYS", "DAYS");
+    ecl_sum_columns_add_column(columns, strings, sc::DATA_INT32,
+                               "REPORT_STEP", "REPORT_STEP", NULL);
+
+    for (int i = 0; i < ecl_sum_vector_get_size(keys); i++) {
+        if (!ecl_sum_vector_iget_valid(keys, i))
+            continue;
+
+        int params_index = ecl_sum_vector_iget_param_index(keys, i);
+        const ecl::smspec_node &node =
+            ecl_smspec_iget_node_w_params_index(ecl_sum->smspec, params_index);
+        sc::column_header column = {};
+        column.data_type = sc::DATA_FLOAT;
+        column.key = ecl_sum_columns_add_string(
+            strings, ecl_sum_vector_iget_key(keys, i));
+        column.keyword =
+            ecl_sum_columns_add_string(strings, node.get_keyword());
+        column.wgname = ecl_sum_columns_add_string(strings, node.get_wgname());
+        column.unit = ecl_sum_columns_add_string(strings, node.get_unit());
+        column.num = node.get_num();
+        column.var_type = node.get_var_type();
+        column.default_value = node.get_default();
+        if (node.is_rate())
+            column.flags |= sc::COLUMN_RATE;
+        if (node.is_total())
+            column.flags |= sc::COLUMN_TOTAL;
+        if (node.is_historical())
+            column.flags |= sc::COLUMN_HISTORICAL;
+
+        columns.push_back(column);
+        params_indices.push_back(params_index);
+    }
+
+    int num_keys = params_indices.size();
+    if (row_group_size <= 0)
+        row_group_size = std::max(
+            1, ECL_SUM_COLUMNS_ROW_GROUP_BYTES /
+                   (int)((num_keys + sc::NUM_TIME_COLUMNS) * sizeof(float)));
+    int num_row_groups = (num_rows + row_group_size - 1) / row_group_size;
+
+    sc::file_header header = {};
+    memcpy(header.magic, sc::MAGIC, sizeof header.magic);
+    header.version = sc::VERSION;
+    header.byte_order = sc::ENDIAN_MARK;
+    header.num_rows = num_rows;
+    header.num_columns = columns.size();
+    header.num_time_columns = sc::NUM_TIME_COLUMNS;
+    header.num_row_groups = num_row_groups;
+    header.strings_offset =
+        sizeof header + columns.size() * sizeof(sc::column_header) +
+        num_row_groups * columns.size() * sizeof(sc::chunk_header);
+    header.strings_size = strings.size();
+    header.start_time = ecl_sum_get_start_time(ecl_sum);
+
+    std::vector<sc::chunk_header> chunks(num_row_groups * columns.size());
+    FILE *stream = util_mkdir_fopen(filename, "wb");
+    util_fwrite(&header, sizeof header, 1, stream, __func__);
+    util_fwrite(columns.data(), sizeof(sc::column_header), columns.size(),
+                stream, __func__);
+    util_fwrite(chunks.data(), sizeof(sc::chunk_header), chunks.size(), stream,
+                __func__);
+    util_fwrite(strings.data(), 1, strings.size(), stream, __func__);
+
+    {
+        std::vector<int> time_indices(row_group_size);
+        std::vector<int64_t> sim_time(row_group_size);
+        std::vector<double> sim_days(row_group_size);
+        std::vector<int> report_step(row_group_size);
+        std::vector<double> frame((size_t)row_group_size * num_keys);
+        std::vector<float> values(row_group_size);
+
+        for (int group = 0; group < num_row_groups; group++) {
+            int first_row = group * row_group_size;
+            int rows = std::min(row_group_size, num_rows - first_row);
+            sc::chunk_header *group_chunks = &chunks[group * columns.size()];
+
+            for (int row = 0; row < rows; row++) {
+                int time_index = first_row + row;
+                time_indices[row] = time_index;
+                sim_time[row] = ecl_sum_iget_sim_time(ecl_sum, time_index);
+                sim_days[row] = ecl_sum_iget_sim_days(ecl_sum, time_index);
+                report_step[row] =
+                    ecl_sum_iget_report_step(ecl_sum, time_index);
+            }
+            ecl_sum_columns_fwrite_chunk(stream, group_chunks[0],
+                                         sim_time.data(),
+                                         rows * sizeof(int64_t), compress);
+            ecl_sum_columns_fwrite_chunk(stream, group_chunks[1],
+                                         sim_days.data(),
+                                         rows * sizeof(double), compress);
+            ecl_sum_columns_fwrite_chunk(stream, group_chunks[2],
+                                         report_step.data(),
+                                         rows * sizeof(int), compress);
+
+            if (num_keys == 0)
+                continue;
+
+            ecl_sum_data_init_double_frame_rows(
+                ecl_sum->data, time_indices.data(), rows,
+                params_indices.data(), num_keys, frame.data());
+            for (int key = 0; key < num_keys; key++) {
+                for (int row = 0; row < rows; row++)
+                    values[row] = frame[(size_t)row * num_keys + key];
+
+                ecl_sum_columns_fwrite_chunk(
+                    stream, group_chunks[sc::NUM_TIME_COLUMNS + key],
+                    values.data(), rows * sizeof(float), compress);
+            }
+        }
+    }
+
+    util_fseek(stream,
+               sizeof header + columns.size() * sizeof(sc::column_header),
+               SEEK_SET);
+    util_fwrite(chunks.data(), sizeof(sc::chunk_header), chunks.size(), stream,
+                __func__);
+    fclose(stream);
+}
+
 const ecl_sum_type *ecl_sum_get_restart_case(const ecl_sum_type *ecl_sum) {
     return ecl_sum->restart_case;
 }
@@ -1334,8 +1791,11 @@ bool ecl_sum_same_case(const ecl_sum_type *ecl_sum, const char *input_file) {
             char *header_file = ecl_util_alloc_exfilename(
                 path, base, ECL_SUMMARY_HEADER_FILE, fmt_file, -1);
             if (header_file != NULL) {
-                same_case = util_same_file(
-                    header_file, ecl_smspec_get_header_file(ecl_sum->smspec));
+                const char *case_header =
+                    ecl_sum->header_file
+                        ? ecl_sum->header_file
+                        : ecl_smspec_get_header_file(ecl_sum->smspec);
+                same_case = util_same_file(header_file, case_header);
                 free(header_file);
             }
         }
@@ -1358,6 +1818,12 @@ void ecl_sum_select_matching_general_var_list(const ecl_sum_type *ecl_sum,
     ecl_smspec_select_matching_general_var_list(ecl_sum->smspec, pattern, keys);
 }
 
+void ecl_sum_select_matching_keys(const ecl_sum_type *ecl_sum,
+                                  const ecl_smspec_matcher_type *matcher,
+                                  stringlist_type *keys) {
+    ecl_smspec_select_matching_keys(ecl_sum->smspec, matcher, keys);
+}
+
 stringlist_type *ecl_sum_alloc_well_list(const ecl_sum_type *ecl_sum,
                                          const char *pattern) {
     return ecl_smspec_alloc_well_list(ecl_sum->smspec, pattern);
@@ -0,0 +1,391 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <ert/util/build_config.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_sum_columns.hpp>
+
+#include "detail/ecl/ecl_sum_columns_format.hpp"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+#ifdef ERT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#define ECL_SUM_COLUMNS_TYPE_ID 5540672
+
+namespace sc = ecl::sum_columns;
+
+struct ecl_sum_columns_struct {
+    UTIL_TYPE_ID_DECLARATION;
+    char *data; /* The whole file, mapped or read into memory. */
+    size_t size;
+    bool mmapped;
+
+    const sc::file_header *header;
+    const sc::column_header *column_list;
+    const sc::chunk_header *chunk_list;
+    const char *strings;
+
+    std::unordered_map<std::string, int> key_index;
+    /* The data of each column, NULL until first accessed. */
+    std::vector<const void *> column_data;
+    std::vector<std::vector<char>> assembled;
+};
+
+UTIL_IS_INSTANCE_FUNCTION(ecl_sum_columns, ECL_SUM_COLUMNS_TYPE_ID)
+
+static size_t ecl_sum_columns_sizeof_type(uint32_t data_type) {
+    switch (data_type) {
+    case sc::DATA_INT32:
+    case sc::DATA_FLOAT:
+        return 4;
+    case sc::DATA_INT64:
+    case sc::DATA_DOUBLE:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+static bool ecl_sum_columns_valid_string(const ecl_sum_columns_type *columns,
+                                         uint32_t offset) {
+    return offset < columns->header->strings_size;
+}
+
+/*
+  Checks that the header and all the tables are consistent with the
+  size of the file, so that the accessors can use the offsets in the
+  file without further checks.
+*/
+
+static bool ecl_sum_columns_init(ecl_sum_columns_type *columns) {
+    const sc::file_header *header = (const sc::file_header *)columns->data;
+    if (memcmp(header->magic, sc::MAGIC, sizeof sc::MAGIC) != 0 ||
+        header->version != sc::VERSION || header->byte_order != sc::ENDIAN_MARK)
+        return false;
+
+    if (header->num_time_columns != sc::NUM_TIME_COLUMNS ||
+        header->num_columns < header->num_time_columns)
+        return false;
+
+    uint64_t num_chunks =
+        (uint64_t)header->num_columns * header->num_row_groups;
+    uint64_t tables_size = sizeof(sc::file_header) +
+                           header->num_columns * sizeof(sc::column_header) +
+                           num_chunks * sizeof(sc::chunk_header);
+    if (tables_size > columns->size || header->strings_offset < tables_size ||
+        header->strings_offset > columns->size || header->strings_size == 0 ||
+        header->strings_size > columns->size - header->strings_offset)
+        return false;
+
+    columns->header = header;
+    columns->column_list =
+        (const sc::column_header *)(columns->data + sizeof(sc::file_header));
+    columns->chunk_list =
+        (const sc::chunk_header *)(columns->column_list + header->num_columns);
+    columns->strings = columns->data + header->strings_offset;
+    if (columns->strings[header->strings_size - 1] != '\0')
+        return false;
+
+    if (header->num_columns > 0 && header->num_row_groups == 0 &&
+        header->num_rows > 0)
+        return false;
+
+    for (uint32_t column = 0; column < header->num_columns; column++) {
+        const sc::column_header &column_header = columns->column_list[column];
+        size_t type_size = ecl_sum_columns_sizeof_type(column_header.data_type);
+        uint64_t size = 0;
+
+        if (type_size == 0 ||
+            !ecl_sum_columns_valid_string(columns, column_header.key) ||
+            !ecl_sum_columns_valid_string(columns, column_header.keyword) ||
+            !ecl_sum_columns_valid_string(columns, column_header.wgname) ||
+            !ecl_sum_columns_valid_string(columns, column_header.unit))
+            return false;
+
+        if (column < header->num_time_columns) {
+            if (column_header.data_type != sc::TIME_COLUMN_TYPES[column])
+                return false;
+        } else if (column_header.data_type != sc::DATA_FLOAT)
+            return false;
+
+        for (uint32_t group = 0; group < header->num_row_groups; group++) {
+            const sc::chunk_header &chunk =
+                columns->chunk_list[group * header->num_columns + column];
+            if (chunk.offset > columns->size ||
+                chunk.offset % sc::COLUMN_ALIGNMENT != 0 ||
+                chunk.stored_size > columns->size - chunk.offset ||
+                chunk.size % type_size != 0)
+                return false;
+
+            if (chunk.compression == sc::COMPRESSION_NONE) {
+                if (chunk.stored_size != chunk.size)
+                    return false;
+            }
+#ifdef ERT_HAVE_ZLIB
+            else if (chunk.compression != sc::COMPRESSION_ZLIB)
+                return false;
+#else
+            else
+                return false;
+#endif
+            size += chunk.size;
+        }
+        if (size != header->num_rows * type_size)
+            return false;
+    }
+
+    for (uint32_t column = header->num_time_columns;
+         column < header->num_columns; column++) {
+        const char *key = columns->strings + columns->column_list[column].key;
+        columns->key_index[key] = column - header->num_time_columns;
+    }
+
+    columns->column_data.resize(header->num_columns, NULL);
+    columns->assembled.resize(header->num_columns);
+    return true;
+}
+
+/**
+   Returns NULL if @filename can not be opened, or is not a valid
+   columnar summary file written by ecl_sum_export_columns() on a
+   machine with the same byte order.
+*/
+
+ecl_sum_columns_type *ecl_sum_columns_fread_alloc(const char *filename) {
+    FILE *stream = fopen(filename, "rb");
+    if (!stream)
+        return NULL;
+
+    if (util_file_size(filename) < sizeof(sc::file_header)) {
+        fclose(stream);
+        return NULL;
+    }
+
+    ecl_sum_columns_type *columns = new ecl_sum_columns_type();
+    UTIL_TYPE_ID_INIT(columns, ECL_SUM_COLUMNS_TYPE_ID);
+    columns->size = util_file_size(filename);
+    columns->data = NULL;
+    columns->mmapped = false;
+
+#ifdef HAVE_MMAP
+    {
+        void *data = mmap(NULL, columns->size, PROT_READ, MAP_SHARED,
+                          fileno(stream), 0);
+        if (data != MAP_FAILED) {
+            columns->data = (char *)data;
+            columns->mmapped = true;
+        }
+    }
+#endif
+
+    if (!columns->mmapped) {
+        columns->data = (char *)util_malloc(columns->size);
+        util_fread(columns->data, 1, columns->size, stream, __func__);
+    }
+    fclose(stream);
+
+    if (!ecl_sum_columns_init(columns)) {
+        ecl_sum_columns_free(columns);
+        return NULL;
+    }
+    return columns;
+}
+
+void ecl_sum_columns_free(ecl_sum_columns_type *columns) {
+#ifdef HAVE_MMAP
+    if (columns->mmapped)
+        munmap(columns->data, columns->size);
+#endif
+    if (!columns->mmapped)
+        free(columns->data);
+    delete columns;
+}
+
+/*
+  A column which is stored uncompressed in a single chunk is used
+  directly from the file, otherwise the chunks are copied, and
+  decompressed, into one buffer the first time the column is accessed.
+  A file without rows has no chunks, and all the columns are NULL.
+*/
+
+static const void *ecl_sum_columns_get_column(ecl_sum_columns_type *columns,
+                                              int column) {
+    const sc::file_header *header = columns->header;
+    if (header->num_rows == 0)
+        return NULL;
+
+    if (columns->column_data[column])
+        return columns->column_data[column];
+
+    const sc::chunk_header *chunk = &columns->chunk_list[column];
+    if (header->num_row_groups == 1 &&
+        chunk->compression == sc::COMPRESSION_NONE) {
+        columns->column_data[column] = columns->data + chunk->offset;
+        return columns->column_data[column];
+    }
+
+    std::vector<char> &buffer = columns->assembled[column];
+    size_t offset = 0;
+    buffer.resize(header->num_rows *
+                  ecl_sum_columns_sizeof_type(
+                      columns->column_list[column].data_type));
+    for (uint32_t group = 0; group < header->num_row_groups; group++) {
+        chunk = &columns->chunk_list[group * header->num_columns + column];
+        if (chunk->compression == sc::COMPRESSION_NONE)
+            memcpy(&buffer[offset], columns->data + chunk->offset,
+                   chunk->size);
+#ifdef ERT_HAVE_ZLIB
+        else {
+            uLongf size = chunk->size;
+            int result =
+                uncompress((Bytef *)&buffer[offset], &size,
+                           (const Bytef *)(columns->data + chunk->offset),
+                           chunk->stored_size);
+            if (result != Z_OK || size != chunk->size)
+                util_abort("%s: failed to decompress column:%d - file "
+                           "corrupt?\n",
+                           __func__, column);
+        }
+#endif
+        offset += chunk->size;
+    }
+    columns->column_data[column] = buffer.data();
+    return columns->column_data[column];
+}
+
+static const sc::column_header &
+ecl_sum_columns_iget_header(const ecl_sum_columns_type *columns, int index) {
+    if (index < 0 || index >= ecl_sum_columns_get_size(columns))
+        util_abort("%s: invalid index:%d - valid range: [0,%d)\n", __func__,
+                   index, ecl_sum_columns_get_size(columns));
+    return columns->column_list[columns->header->num_time_columns + index];
+}
+
+int ecl_sum_columns_get_length(const ecl_sum_columns_type *columns) {
+    return columns->header->num_rows;
+}
+
+/*
+  The number of summary vectors in the file; the time axis is not
+  included.
+*/
+
+int ecl_sum_columns_get_size(const ecl_sum_columns_type *columns) {
+    return columns->header->num_columns - columns->header->num_time_columns;
+}
+
+int ecl_sum_columns_get_num_row_groups(const ecl_sum_columns_type *columns) {
+    return columns->header->num_row_groups;
+}
+
+bool ecl_sum_columns_is_mmapped(const ecl_sum_columns_type *columns) {
+    return columns->mmapped;
+}
+
+time_t ecl_sum_columns_get_start_time(const ecl_sum_columns_type *columns) {
+    return columns->header->start_time;
+}
+
+const int64_t *ecl_sum_columns_get_sim_time(ecl_sum_columns_type *columns) {
+    return (const int64_t *)ecl_sum_columns_get_column(columns, 0);
+}
+
+const double *ecl_sum_columns_get_sim_days(ecl_sum_columns_type *columns) {
+    return (const double *)ecl_sum_columns_get_column(columns, 1);
+}
+
+const int *ecl_sum_columns_get_report_step(ecl_sum_columns_type *columns) {
+    return (const int *)ecl_sum_columns_get_column(columns, 2);
+}
+
+bool ecl_sum_columns_has_key(const ecl_sum_columns_type *columns,
+                             const char *key) {
+    return columns->key_index.count(key) > 0;
+}
+
+/*
+  Returns -1 if @key is not in the file.
+*/
+
+int ecl_sum_columns_get_index(const ecl_sum_columns_type *columns,
+                              const char *key) {
+    auto iter = columns->key_index.find(key);
+    if (iter == columns->key_index.end())
+        return -1;
+    return iter->second;
+}
+
+const char *ecl_sum_columns_iget_key(const ecl_sum_columns_type *columns,
+                                     int index) {
+    return columns->strings + ecl_sum_columns_iget_header(columns, index).key;
+}
+
+const char *ecl_sum_columns_iget_keyword(const ecl_sum_columns_type *columns,
+                                         int index) {
+    return columns->strings +
+           ecl_sum_columns_iget_header(columns, index).keyword;
+}
+
+/*
+  Returns NULL for vectors without a well or group name.
+*/
+
+const char *ecl_sum_columns_iget_wgname(const ecl_sum_columns_type *columns,
+                                        int index) {
+    const char *wgname =
+        columns->strings + ecl_sum_columns_iget_header(columns, index).wgname;
+    return wgname[0] ? wgname : NULL;
+}
+
+const char *ecl_sum_columns_iget_unit(const ecl_sum_columns_type *columns,
+                                      int index) {
+    return columns->strings + ecl_sum_columns_iget_header(columns, index).unit;
+}
+
+int ecl_sum_columns_iget_num(const ecl_sum_columns_type *columns, int index) {
+    return ecl_sum_columns_iget_header(columns, index).num;
+}
+
+ecl_smspec_var_type
+ecl_sum_columns_iget_var_type(const ecl_sum_columns_type *columns, int index) {
+    return (ecl_smspec_var_type)ecl_sum_columns_iget_header(columns, index)
+        .var_type;
+}
+
+bool ecl_sum_columns_iget_is_rate(const ecl_sum_columns_type *columns,
+                                  int index) {
+    return ecl_sum_columns_iget_header(columns, index).flags & sc::COLUMN_RATE;
+}
+
+bool ecl_sum_columns_iget_is_total(const ecl_sum_columns_type *columns,
+                                   int index) {
+    return ecl_sum_columns_iget_header(columns, index).flags &
+           sc::COLUMN_TOTAL;
+}
+
+float ecl_sum_columns_iget_default(const ecl_sum_columns_type *columns,
+                                   int index) {
+    return ecl_sum_columns_iget_header(columns, index).default_value;
+}
+
+/*
+  The values of vector @index at all the ministeps; the pointer is
+  valid as long as @columns is.
+*/
+
+const float *ecl_sum_columns_iget_data(ecl_sum_columns_type *columns,
+                                       int index) {
+    ecl_sum_columns_iget_header(columns, index);
+    return (const float *)ecl_sum_columns_get_column(
+        columns, columns->header->num_time_columns + index);
+}
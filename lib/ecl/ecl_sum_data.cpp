@@ -229,6 +229,7 @@ private:
 
 struct ecl_sum_data_struct {
     const ecl_smspec_type *smspec;
+    std::string header_file; // See ecl_sum_data_set_header_file()
     std::vector<ecl::ecl_sum_file_data *>
         data_files; // List of ecl_sum_file_data instances
     CaseIndex index;
@@ -327,9 +328,17 @@ static void ecl_sum_data_fwrite_multiple(const ecl_sum_data_type *data,
         data->data_files[index]->fwrite_multiple(ecl_case, fmt_case);
 }
 
+/*
+  For a streaming writer, see ecl_sum_data_stream_open(), the data is
+  already on its way to disk, and ecl_sum_data_fwrite() only writes the
+  pending timesteps and flushes the file.
+*/
+
 void ecl_sum_data_fwrite(const ecl_sum_data_type *data, const char *ecl_case,
                          bool fmt_case, bool unified) {
-    if (unified)
+    if (!data->data_files.empty() && data->data_files.back()->is_stream())
+        data->data_files.back()->stream_flush(true);
+    else if (unified)
         ecl_sum_data_fwrite_unified(data, ecl_case, fmt_case);
     else
         ecl_sum_data_fwrite_multiple(data, ecl_case, fmt_case);
@@ -655,10 +664,38 @@ ecl_sum_tstep_type *ecl_sum_data_add_new_tstep(ecl_sum_data_type *data,
     ecl::ecl_sum_file_data *file_data = data->data_files.back();
     ecl_sum_tstep_type *tstep =
         file_data->add_new_tstep(report_step, sim_seconds);
-    ecl_sum_data_build_index(data);
+    auto &node = data->index.back();
+
+    /*
+      When the new tstep has been appended after the existing tsteps of
+      the main case the index node is just extended; that avoids
+      recreating the params map for every timestep.
+    */
+    if (node.length > 0 && node.length + 1 == file_data->length() &&
+        node.time1 == file_data->get_data_start() &&
+        node.report1 == file_data->first_report() &&
+        ecl_sum_tstep_get_sim_time(tstep) == file_data->get_sim_end()) {
+        node.length = file_data->length();
+        node.report2 = file_data->last_report();
+        node.time2 = file_data->get_sim_end();
+        node.days2 = file_data->get_sim_length();
+    } else
+        ecl_sum_data_build_index(data);
     return tstep;
 }
 
+/*
+  Puts a writer in streaming mode, where each report step is written to
+  the summary file(s) of @ecl_case as soon as a timestep of a later
+  report step is added, and the memory of the written timesteps is
+  released; see ecl_sum_alloc_stream_writer().
+*/
+
+void ecl_sum_data_stream_open(ecl_sum_data_type *data, const char *ecl_case,
+                              bool fmt_case, bool unified) {
+    data->data_files.back()->stream_open(ecl_case, fmt_case, unified);
+}
+
 int *ecl_sum_data_alloc_param_mapping(int *current_param_mapping,
                                       int *old_param_mapping, size_t size) {
     int *new_param_mapping =
@@ -672,6 +709,36 @@ int *ecl_sum_data_alloc_param_mapping(int *current_param_mapping,
     return new_param_mapping;
 }
 
+/*
+  Will load new timesteps which have been appended to the summary file of
+  the main case since it was loaded; the cases this case has been
+  restarted from are not considered. Returns the number of new timesteps.
+*/
+
+int ecl_sum_data_refresh(ecl_sum_data_type *data) {
+    if (data->data_files.empty())
+        return 0;
+
+    ecl::ecl_sum_file_data *file_data = data->data_files.back();
+    int new_steps = file_data->refresh();
+    if (new_steps > 0) {
+        auto &node = data->index.back();
+
+        /*
+          The main case is the last node in the index, so when the node
+          has already been initialized we only need to extend it.
+        */
+        if (node.length > 0) {
+            node.length = file_data->length();
+            node.report2 = file_data->last_report();
+            node.time2 = file_data->get_sim_end();
+            node.days2 = file_data->get_sim_length();
+        } else
+            ecl_sum_data_build_index(data);
+    }
+    return new_steps;
+}
+
 void ecl_sum_data_add_case(ecl_sum_data_type *self,
                            const ecl_sum_data_type *other) {
     for (auto other_file : other->data_files)
@@ -689,11 +756,22 @@ void ecl_sum_data_add_case(ecl_sum_data_type *self,
   call to ecl_sum_data_build_index().
 */
 
+/*
+  Sets the SMSPEC file of the case which is loaded with
+  ecl_sum_data_fread(); this is only needed when the smspec instance is
+  shared with other cases, and its header file belongs to another case.
+*/
+
+void ecl_sum_data_set_header_file(ecl_sum_data_type *data,
+                                  const char *header_file) {
+    data->header_file = header_file ? header_file : "";
+}
+
 bool ecl_sum_data_fread(ecl_sum_data_type *data,
                         const stringlist_type *filelist, bool lazy_load,
                         int file_options) {
     ecl::ecl_sum_file_data *file_data =
-        new ecl::ecl_sum_file_data(data->smspec);
+        new ecl::ecl_sum_file_data(data->smspec, data->header_file);
     if (file_data->fread(filelist, lazy_load, file_options)) {
         ecl_sum_data_append_file_data(data, file_data);
         ecl_sum_data_build_index(data);
@@ -1142,120 +1220,337 @@ ecl_sum_data_alloc_data_vector(const ecl_sum_data_type *data, int params_index,
     return data_vector;
 }
 
-void ecl_sum_data_init_double_vector_interp(
-    const ecl_sum_data_type *data, const ecl::smspec_node &smspec_node,
-    const time_t_vector_type *time_points, double *output_data) {
-    bool is_rate = smspec_node_is_rate(&smspec_node);
-    int params_index = smspec_node_get_params_index(&smspec_node);
-    time_t start_time = ecl_sum_data_get_data_start(data);
-    time_t end_time = ecl_sum_data_get_sim_end(data);
-    double start_value = 0;
-    double end_value = 0;
-
-    if (!is_rate) {
-        start_value = ecl_sum_data_iget_first_value(data, params_index);
-        end_value = ecl_sum_data_iget_last_value(data, params_index);
+/*
+  Resampling plan for interpolating all the vectors of a case to a list
+  of time points. Since both the ministep times and (normally) the time
+  points are sorted the bracketing ministeps are found in one linear
+  sweep. Only the ministeps which are actually used are fetched from
+  the data files, in one call per file and vector, and the plan can
+  then be applied to one full vector at a time. The plan gives exactly
+  the same values as ecl_sum_data_get_from_sim_time() for time points
+  inside the data interval; outside the interval the first/last value
+  is used for totals and zero for rates.
+*/
+
+namespace {
+
+struct interp_plan {
+    /* The ministeps to fetch, per index node, relative to the node offset. */
+    std::vector<std::vector<int>> node_rows;
+    int num_rows;
+
+    /* Positions in the fetched rows. */
+    std::vector<int> index1;
+    std::vector<int> index2;
+    std::vector<double> weight1;
+    std::vector<double> weight2;
+    std::vector<int> rate_index; /* -1: outside the data, the rate is 0. */
+};
+
+} // namespace
+
+static void ecl_sum_data_init_interp_plan(const ecl_sum_data_type *data,
+                                          const time_t_vector_type *time_points,
+                                          interp_plan &plan) {
+    const int num_points = time_t_vector_size(time_points);
+    const int length = ecl_sum_data_get_length(data);
+    const time_t start_time = ecl_sum_data_get_data_start(data);
+    const time_t end_time = ecl_sum_data_get_sim_end(data);
+    std::vector<time_t> sim_times(length);
+    ecl_sum_data_init_time_vector__(data, sim_times.data(), false);
+
+    plan.index1.resize(num_points);
+    plan.index2.resize(num_points);
+    plan.weight1.resize(num_points);
+    plan.weight2.resize(num_points);
+    plan.rate_index.resize(num_points);
+
+    int idx = 0;
+    time_t prev_time = start_time;
+    for (int i = 0; i < num_points; i++) {
+        time_t sim_time = time_t_vector_iget(time_points, i);
+
+        if (sim_time < start_time || sim_time > end_time) {
+            int edge = sim_time < start_time ? 0 : length - 1;
+            plan.index1[i] = edge;
+            plan.index2[i] = edge;
+            plan.weight1[i] = 1;
+            plan.weight2[i] = 0;
+            plan.rate_index[i] = -1;
+            continue;
+        }
+
+        /*
+          The first ministep with time >= sim_time, as found with the
+          binary search in ecl_sum_data_get_index_from_sim_time(). The
+          search only restarts if the time points are not sorted.
+        */
+        if (sim_time < prev_time)
+            idx = std::lower_bound(sim_times.begin(), sim_times.end(),
+                                   sim_time) -
+                  sim_times.begin();
+        while (idx < length - 1 && sim_times[idx] < sim_time)
+            idx++;
+        prev_time = sim_time;
+
+        plan.rate_index[i] = idx;
+        if (idx == 0) {
+            plan.index1[i] = 0;
+            plan.index2[i] = 0;
+            plan.weight1[i] = 1;
+            plan.weight2[i] = 0;
+        } else {
+            time_t sim_time1 = sim_times[idx - 1];
+            time_t sim_time2 = sim_times[idx];
+            double time_diff = sim_time2 - sim_time1;
+            double time_dist1 = (sim_time - sim_time1);
+            double time_dist2 = -(sim_time - sim_time2);
+
+            plan.index1[i] = idx - 1;
+            plan.index2[i] = idx;
+            plan.weight1[i] = time_dist2 / time_diff;
+            plan.weight2[i] = time_dist1 / time_diff;
+        }
     }
 
-    for (int time_index = 0; time_index < time_t_vector_size(time_points);
-         time_index++) {
-        time_t sim_time = time_t_vector_iget(time_points, time_index);
-        double value;
-        if (sim_time < start_time)
-            value = start_value;
+    /* Number the used ministeps, and map the plan to the fetched rows. */
+    std::vector<int> row_pos(length, -1);
+    for (int i = 0; i < num_points; i++) {
+        row_pos[plan.index1[i]] = 0;
+        row_pos[plan.index2[i]] = 0;
+    }
 
-        else if (sim_time > end_time)
-            value = end_value;
+    plan.num_rows = 0;
+    plan.node_rows.clear();
+    for (const auto &index_node : data->index) {
+        std::vector<int> rows;
+        for (int i = 0; i < index_node.length; i++) {
+            if (row_pos[index_node.offset + i] == 0) {
+                row_pos[index_node.offset + i] = plan.num_rows++;
+                rows.push_back(i);
+            }
+        }
+        plan.node_rows.push_back(rows);
+    }
 
-        else {
-            int time_index1, time_index2;
-            double weight1, weight2;
-            ecl_sum_data_init_interp_from_sim_time(
-                data, sim_time, &time_index1, &time_index2, &weight1, &weight2);
-            value = ecl_sum_data_vector_iget(data, sim_time, params_index,
-                                             is_rate, time_index1, time_index2,
-                                             weight1, weight2);
+    for (int i = 0; i < num_points; i++) {
+        plan.index1[i] = row_pos[plan.index1[i]];
+        plan.index2[i] = row_pos[plan.index2[i]];
+        if (plan.rate_index[i] >= 0)
+            plan.rate_index[i] = row_pos[plan.rate_index[i]];
+    }
+}
+
+/*
+  Fetches the ministeps used by the plan for the @num_keys vectors
+  main_params_index[0 .. num_keys); the value of vector i at fetched
+  row r is stored in values[r * num_keys + i].
+*/
+static void ecl_sum_data_fetch_interp_rows(const ecl_sum_data_type *data,
+                                           const interp_plan &plan,
+                                           const int *main_params_index,
+                                           int num_keys, double *values) {
+    int offset = 0;
+    int node_nr = 0;
+    std::vector<int> params_indices(num_keys);
+    for (const auto &index_node : data->index) {
+        const auto &data_file = data->data_files[index_node.data_index];
+        const auto &rows = plan.node_rows[node_nr];
+
+        for (int i = 0; i < num_keys; i++) {
+            params_indices[i] = index_node.params_map[main_params_index[i]];
+            if (params_indices[i] < 0) {
+                const ecl::smspec_node &smspec_node =
+                    ecl_smspec_iget_node_w_params_index(data->smspec,
+                                                        main_params_index[i]);
+                for (size_t r = 0; r < rows.size(); r++)
+                    values[(offset + r) * num_keys + i] =
+                        smspec_node.get_default();
+            }
         }
 
-        output_data[time_index] = value;
+        data_file->get_data_at(rows, params_indices,
+                               &values[(size_t)offset * num_keys], num_keys);
+        offset += rows.size();
+        node_nr++;
+    }
+}
+
+/*
+  Applies the plan to the fetched rows values[r * value_stride] and
+  writes the result to output_data[i * output_stride].
+*/
+static void ecl_sum_data_apply_interp_plan(const interp_plan &plan,
+                                           bool is_rate, const double *values,
+                                           int value_stride,
+                                           double *output_data,
+                                           int output_stride) {
+    const int num_points = plan.rate_index.size();
+    if (is_rate) {
+        const int *rate_index = plan.rate_index.data();
+        for (int i = 0; i < num_points; i++)
+            output_data[i * output_stride] =
+                rate_index[i] >= 0 ? values[rate_index[i] * value_stride] : 0;
+    } else {
+        const int *index1 = plan.index1.data();
+        const int *index2 = plan.index2.data();
+        const double *weight1 = plan.weight1.data();
+        const double *weight2 = plan.weight2.data();
+        for (int i = 0; i < num_points; i++)
+            output_data[i * output_stride] =
+                values[index1[i] * value_stride] * weight1[i] +
+                values[index2[i] * value_stride] * weight2[i];
     }
 }
 
+void ecl_sum_data_init_double_vector_interp(
+    const ecl_sum_data_type *data, const ecl::smspec_node &smspec_node,
+    const time_t_vector_type *time_points, double *output_data) {
+    interp_plan plan;
+    ecl_sum_data_init_interp_plan(data, time_points, plan);
+
+    int params_index = smspec_node_get_params_index(&smspec_node);
+    std::vector<double> values(plan.num_rows);
+    ecl_sum_data_fetch_interp_rows(data, plan, &params_index, 1,
+                                   values.data());
+    ecl_sum_data_apply_interp_plan(plan, smspec_node_is_rate(&smspec_node),
+                                   values.data(), 1, output_data, 1);
+}
+
 void ecl_sum_data_init_double_frame(const ecl_sum_data_type *data,
                                     const ecl_sum_vector_type *keywords,
                                     double *output_data) {
-    int time_stride = ecl_sum_vector_get_size(keywords);
-    int key_stride = 1;
-    for (int time_index = 0; time_index < ecl_sum_data_get_length(data);
-         time_index++) {
-        for (int key_index = 0; key_index < ecl_sum_vector_get_size(keywords);
-             key_index++) {
-            int param_index =
+    /*
+      The data is assembled one file at a time, so that all the
+      requested vectors are extracted from a lazily loaded file in one
+      pass through the file.
+    */
+    int num_keywords = ecl_sum_vector_get_size(keywords);
+    int time_stride = num_keywords;
+    int offset = 0;
+    std::vector<int> params_indices(num_keywords);
+
+    for (const auto &index_node : data->index) {
+        const auto &data_file = data->data_files[index_node.data_index];
+        const auto &params_map = index_node.params_map;
+
+        for (int key_index = 0; key_index < num_keywords; key_index++) {
+            int main_params_index =
                 ecl_sum_vector_iget_param_index(keywords, key_index);
-            int data_index = key_index * key_stride + time_index * time_stride;
+            params_indices[key_index] = params_map[main_params_index];
+
+            if (params_indices[key_index] < 0) {
+                const ecl::smspec_node &smspec_node =
+                    ecl_smspec_iget_node_w_params_index(data->smspec,
+                                                        main_params_index);
+                for (int i = 0; i < index_node.length; i++)
+                    output_data[(offset + i) * time_stride + key_index] =
+                        smspec_node.get_default();
+            }
+        }
+
+        data_file->get_data(params_indices, index_node.length,
+                            &output_data[offset * time_stride], time_stride);
+        offset += index_node.length;
+    }
+}
+
+/*
+  Will fetch the values for @params_indices at the ministeps
+  @time_indices, which must be sorted; the value of params_indices[i]
+  at time_indices[k] is stored in output_data[k * num_params + i].
+  Negative params indices are skipped.
+*/
+
+void ecl_sum_data_init_double_frame_rows(const ecl_sum_data_type *data,
+                                         const int *time_indices, int num_rows,
+                                         const int *params_indices,
+                                         int num_params, double *output_data) {
+    std::vector<int> rows;
+    std::vector<int> file_params(num_params);
+    int row = 0;
 
-            output_data[data_index] =
-                ecl_sum_data_iget(data, time_index, param_index);
+    for (const auto &index_node : data->index) {
+        int first_row = row;
+        rows.clear();
+        while (row < num_rows && time_indices[row] < index_node.end()) {
+            rows.push_back(time_indices[row] - index_node.offset);
+            row++;
+        }
+        if (rows.empty())
+            continue;
+
+        const auto &data_file = data->data_files[index_node.data_index];
+        for (int i = 0; i < num_params; i++) {
+            if (params_indices[i] < 0) {
+                file_params[i] = -1;
+                continue;
+            }
+
+            file_params[i] = index_node.params_map[params_indices[i]];
+            if (file_params[i] < 0) {
+                const ecl::smspec_node &smspec_node =
+                    ecl_smspec_iget_node_w_params_index(data->smspec,
+                                                        params_indices[i]);
+                for (size_t k = 0; k < rows.size(); k++)
+                    output_data[(first_row + k) * num_params + i] =
+                        smspec_node.get_default();
+            }
         }
+
+        data_file->get_data_at(rows, file_params,
+                               &output_data[(size_t)first_row * num_params],
+                               num_params);
     }
 }
 
+/*
+  The vectors are fetched in blocks of keys, where each block holds at
+  most this many values.
+*/
+#define ECL_SUM_DATA_INTERP_BLOCK_SIZE (1 << 22)
+
+/*
+  Invalid keys in @keywords, i.e. keys which are not present in this
+  case, are not updated in @output_data.
+*/
+
 void ecl_sum_data_init_double_frame_interp(
     const ecl_sum_data_type *data, const ecl_sum_vector_type *keywords,
     const time_t_vector_type *time_points, double *output_data) {
     int num_keywords = ecl_sum_vector_get_size(keywords);
     int time_stride = num_keywords;
-    int key_stride = 1;
-    time_t start_time = ecl_sum_data_get_data_start(data);
-    time_t end_time = ecl_sum_data_get_sim_end(data);
-
-    for (int time_index = 0; time_index < time_t_vector_size(time_points);
-         time_index++) {
-        time_t sim_time = time_t_vector_iget(time_points, time_index);
-        if (sim_time < start_time) {
-            for (int key_index = 0; key_index < num_keywords; key_index++) {
-                int param_index =
-                    ecl_sum_vector_iget_param_index(keywords, key_index);
-                int data_index =
-                    key_index * key_stride + time_index * time_stride;
-                bool is_rate = ecl_sum_vector_iget_is_rate(keywords, key_index);
-                if (is_rate)
-                    output_data[data_index] = 0;
-                else
-                    output_data[data_index] =
-                        ecl_sum_data_iget_first_value(data, param_index);
-            }
-        } else if (sim_time > end_time) {
-            for (int key_index = 0; key_index < num_keywords; key_index++) {
-                int param_index =
-                    ecl_sum_vector_iget_param_index(keywords, key_index);
-                int data_index =
-                    key_index * key_stride + time_index * time_stride;
-                bool is_rate = ecl_sum_vector_iget_is_rate(keywords, key_index);
-                if (is_rate)
-                    output_data[data_index] = 0;
-                else
-                    output_data[data_index] =
-                        ecl_sum_data_iget_last_value(data, param_index);
-            }
-        } else {
-            double weight1, weight2;
-            int time_index1, time_index2;
-
-            ecl_sum_data_init_interp_from_sim_time(
-                data, sim_time, &time_index1, &time_index2, &weight1, &weight2);
-
-            for (int key_index = 0; key_index < num_keywords; key_index++) {
-                int param_index =
-                    ecl_sum_vector_iget_param_index(keywords, key_index);
-                int data_index =
-                    key_index * key_stride + time_index * time_stride;
-                bool is_rate = ecl_sum_vector_iget_is_rate(keywords, key_index);
-                double value = ecl_sum_data_vector_iget(
-                    data, sim_time, param_index, is_rate, time_index1,
-                    time_index2, weight1, weight2);
-                output_data[data_index] = value;
-            }
+    interp_plan plan;
+    ecl_sum_data_init_interp_plan(data, time_points, plan);
+
+    std::vector<int> key_list;
+    for (int key_index = 0; key_index < num_keywords; key_index++) {
+        if (ecl_sum_vector_iget_valid(keywords, key_index))
+            key_list.push_back(key_index);
+    }
+
+    const int num_keys = key_list.size();
+    const int block_size =
+        std::max(1, std::min(num_keys, ECL_SUM_DATA_INTERP_BLOCK_SIZE /
+                                           std::max(plan.num_rows, 1)));
+    std::vector<int> params_indices(block_size);
+    std::vector<double> values((size_t)block_size * plan.num_rows);
+
+    for (int block_start = 0; block_start < num_keys;
+         block_start += block_size) {
+        int block_keys = std::min(block_size, num_keys - block_start);
+        for (int i = 0; i < block_keys; i++)
+            params_indices[i] = ecl_sum_vector_iget_param_index(
+                keywords, key_list[block_start + i]);
+
+        ecl_sum_data_fetch_interp_rows(data, plan, params_indices.data(),
+                                       block_keys, values.data());
+        for (int i = 0; i < block_keys; i++) {
+            int key_index = key_list[block_start + i];
+            bool is_rate = ecl_sum_vector_iget_is_rate(keywords, key_index);
+            ecl_sum_data_apply_interp_plan(plan, is_rate, &values[i],
+                                           block_keys, &output_data[key_index],
+                                           time_stride);
         }
     }
 }
@@ -0,0 +1,223 @@
+#include <math.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_smspec.hpp>
+#include <ert/ecl/ecl_sum.hpp>
+#include <ert/ecl/ecl_sum_vector.hpp>
+#include <ert/ecl/ecl_sum_ensemble.hpp>
+
+#include "detail/ecl/ecl_sum_shared_smspec.hpp"
+
+#define ECL_SUM_ENSEMBLE_TYPE_ID 6613904
+
+/*
+  The ensemble owns all the ecl_sum instances and all the ecl_smspec
+  instances; the ecl_sum instances only hold a reference to one of the
+  elements in smspec_list.
+*/
+
+struct ecl_sum_ensemble_struct {
+    UTIL_TYPE_ID_DECLARATION;
+    std::vector<ecl_smspec_type *> smspec_list;
+    std::vector<ecl_sum_type *> case_list;
+    std::vector<std::string> case_names;
+    std::vector<int> smspec_index; /* Index into smspec_list for each case. */
+};
+
+UTIL_IS_INSTANCE_FUNCTION(ecl_sum_ensemble, ECL_SUM_ENSEMBLE_TYPE_ID)
+
+/**
+   Will load all the summary cases in @case_list, using @num_threads
+   threads; if @num_threads <= 0 one thread per core is used. The cases
+   are handed out to the threads one at a time, so a few large cases do
+   not hold up the rest of the ensemble.
+
+   Each case is loaded as with ecl_sum_fread_alloc_case(), but when the
+   SMSPEC header of a case is identical - in the ecl_smspec_shareable()
+   sense - to a header which has already been loaded, the new header is
+   discarded and the case uses the existing one.
+
+   Cases which can not be loaded are skipped with a warning; the order
+   of the remaining cases is the order of @case_list.
+*/
+
+ecl_sum_ensemble_type *
+ecl_sum_ensemble_fread_alloc(const stringlist_type *case_list,
+                             const char *key_join_string, int num_threads) {
+    const int num_cases = stringlist_get_size(case_list);
+    std::vector<ecl_sum_type *> loaded(num_cases, nullptr);
+    std::vector<ecl_smspec_type *> smspec_list;
+    std::mutex smspec_mutex;
+
+    const ecl::share_smspec_ftype share_smspec =
+        [&](ecl_smspec_type *smspec) {
+            std::lock_guard<std::mutex> lock(smspec_mutex);
+            for (ecl_smspec_type *other : smspec_list) {
+                if (ecl_smspec_shareable(other, smspec)) {
+                    ecl_smspec_free(smspec);
+                    return other;
+                }
+            }
+            smspec_list.push_back(smspec);
+            return smspec;
+        };
+
+    std::atomic<int> next_case(0);
+    auto load_cases = [&]() {
+        for (int i = next_case++; i < num_cases; i = next_case++)
+            loaded[i] = ecl_sum_fread_alloc_case_shared(
+                stringlist_iget(case_list, i), key_join_string, true, false,
+                0, share_smspec);
+    };
+
+    if (num_threads <= 0)
+        num_threads = std::thread::hardware_concurrency();
+    num_threads = std::max(1, std::min(num_threads, num_cases));
+    {
+        std::vector<std::thread> threads;
+        for (int i = 1; i < num_threads; i++)
+            threads.emplace_back(load_cases);
+        load_cases();
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    ecl_sum_ensemble_type *ensemble = new ecl_sum_ensemble_type();
+    UTIL_TYPE_ID_INIT(ensemble, ECL_SUM_ENSEMBLE_TYPE_ID);
+    std::vector<int> smspec_map(smspec_list.size(), -1);
+    for (int i = 0; i < num_cases; i++) {
+        ecl_sum_type *ecl_sum = loaded[i];
+        if (!ecl_sum) {
+            fprintf(stderr, "** Warning: could not load summary case:%s\n",
+                    stringlist_iget(case_list, i));
+            continue;
+        }
+
+        const ecl_smspec_type *smspec = ecl_sum_get_smspec(ecl_sum);
+        int pos = std::find(smspec_list.begin(), smspec_list.end(), smspec) -
+                  smspec_list.begin();
+        if (smspec_map[pos] < 0) {
+            smspec_map[pos] = ensemble->smspec_list.size();
+            ensemble->smspec_list.push_back(smspec_list[pos]);
+        }
+
+        ensemble->case_list.push_back(ecl_sum);
+        ensemble->case_names.push_back(stringlist_iget(case_list, i));
+        ensemble->smspec_index.push_back(smspec_map[pos]);
+    }
+
+    /* Headers from cases where loading the data failed. */
+    for (size_t pos = 0; pos < smspec_list.size(); pos++)
+        if (smspec_map[pos] < 0)
+            ecl_smspec_free(smspec_list[pos]);
+
+    return ensemble;
+}
+
+void ecl_sum_ensemble_free(ecl_sum_ensemble_type *ensemble) {
+    for (ecl_sum_type *ecl_sum : ensemble->case_list)
+        ecl_sum_free(ecl_sum);
+
+    for (ecl_smspec_type *smspec : ensemble->smspec_list)
+        ecl_smspec_free(smspec);
+
+    delete ensemble;
+}
+
+int ecl_sum_ensemble_get_size(const ecl_sum_ensemble_type *ensemble) {
+    return ensemble->case_list.size();
+}
+
+const ecl_sum_type *
+ecl_sum_ensemble_iget_case(const ecl_sum_ensemble_type *ensemble, int index) {
+    return ensemble->case_list.at(index);
+}
+
+const char *
+ecl_sum_ensemble_iget_case_name(const ecl_sum_ensemble_type *ensemble,
+                                int index) {
+    return ensemble->case_names.at(index).c_str();
+}
+
+int ecl_sum_ensemble_get_num_smspec(const ecl_sum_ensemble_type *ensemble) {
+    return ensemble->smspec_list.size();
+}
+
+/**
+   Will fill @data with the values of all the @keys in all the cases,
+   interpolated to @time_points as in ecl_sum_init_double_frame_interp().
+   The @data array must have room for size x num_time x num_keys
+   elements, and is filled with the key as the fastest running index:
+
+      data[(case * num_time + time_index) * num_keys + key_index]
+
+   Keys which are not present in a case get the value NAN for that case.
+*/
+
+void ecl_sum_ensemble_init_double_frame_interp(
+    const ecl_sum_ensemble_type *ensemble, const stringlist_type *keys,
+    const time_t_vector_type *time_points, double *data) {
+    const int num_cases = ensemble->case_list.size();
+    const int num_keys = stringlist_get_size(keys);
+    const int num_time = time_t_vector_size(time_points);
+    const size_t case_size = size_t(num_time) * num_keys;
+
+    /*
+      The key lookup only depends on the header, so it is done once for
+      each distinct smspec. The columns vector holds the position in
+      @keys of each key which was found.
+    */
+    std::vector<ecl_sum_vector_type *> vectors(ensemble->smspec_list.size(),
+                                               nullptr);
+    std::vector<std::vector<int>> columns(ensemble->smspec_list.size());
+    for (int i = 0; i < num_cases; i++) {
+        int index = ensemble->smspec_index[i];
+        if (vectors[index])
+            continue;
+
+        vectors[index] = ecl_sum_vector_alloc(ensemble->case_list[i], false);
+        for (int k = 0; k < num_keys; k++) {
+            const char *key = stringlist_iget(keys, k);
+            if (ecl_sum_vector_add_key(vectors[index], key))
+                columns[index].push_back(k);
+        }
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < num_cases; i++) {
+        int index = ensemble->smspec_index[i];
+        const std::vector<int> &column = columns[index];
+        double *case_data = data + i * case_size;
+        const int num_columns = column.size();
+
+        if (num_columns == num_keys) {
+            ecl_sum_init_double_frame_interp(ensemble->case_list[i],
+                                             vectors[index], time_points,
+                                             case_data);
+            continue;
+        }
+
+        std::vector<double> values(size_t(num_time) * num_columns);
+        if (num_columns > 0)
+            ecl_sum_init_double_frame_interp(ensemble->case_list[i],
+                                             vectors[index], time_points,
+                                             values.data());
+
+        std::fill(case_data, case_data + case_size, NAN);
+        for (int t = 0; t < num_time; t++)
+            for (int c = 0; c < num_columns; c++)
+                case_data[size_t(t) * num_keys + column[c]] =
+                    values[size_t(t) * num_columns + c];
+    }
+
+    for (ecl_sum_vector_type *vector : vectors)
+        ecl_sum_vector_free(vector);
+}
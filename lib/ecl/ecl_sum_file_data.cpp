@@ -1,6 +1,7 @@
 #include <stdexcept>
 #include <limits>
 #include <algorithm>
+#include <numeric>
 #include <memory>
 
 #include <ert/ecl/ecl_sum_tstep.hpp>
@@ -174,12 +175,84 @@
 
 */
 
+/*
+  The size of the stdio buffer used when streaming the summary data
+  to disk, see ecl_sum_file_data::stream_open().
+*/
+#define ECL_SUM_STREAM_BUFFER_SIZE (1 << 22)
+
 namespace ecl {
 
-ecl_sum_file_data::ecl_sum_file_data(const ecl_smspec_type *smspec)
-    : ecl_smspec(smspec), data(vector_alloc_new()) {}
+struct ecl_sum_file_data::stream_type {
+    std::string ecl_case;
+    bool fmt_case;
+    bool unified;
+
+    int written = 0;      /* The number of tsteps written and released. */
+    int last_report = -1; /* The report step of the last written tstep. */
+    fortio_type *fortio = NULL;
+    std::vector<char> buffer;
+
+    /* Allocated when the first tsteps are written. */
+    ecl_kw_type *seqhdr_kw = NULL;
+    ecl_kw_type *ministep_kw = NULL;
+    ecl_kw_type *params_kw = NULL;
+
+    void open(int report_step, bool append);
+    void close();
+};
+
+void ecl_sum_file_data::stream_type::open(int report_step, bool append) {
+    char *filename;
+    if (this->unified)
+        filename = ecl_util_alloc_filename(NULL, this->ecl_case.c_str(),
+                                           ECL_UNIFIED_SUMMARY_FILE,
+                                           this->fmt_case, 0);
+    else
+        filename = ecl_util_alloc_filename(NULL, this->ecl_case.c_str(),
+                                           ECL_SUMMARY_FILE, this->fmt_case,
+                                           report_step);
+
+    if (append)
+        this->fortio =
+            fortio_open_append(filename, this->fmt_case, ECL_ENDIAN_FLIP);
+    else
+        this->fortio =
+            fortio_open_writer(filename, this->fmt_case, ECL_ENDIAN_FLIP);
+
+    if (!this->fortio)
+        util_abort("%s: failed to open:%s for writing \n", __func__, filename);
+
+    this->buffer.resize(ECL_SUM_STREAM_BUFFER_SIZE);
+    setvbuf(fortio_get_FILE(this->fortio), this->buffer.data(), _IOFBF,
+            this->buffer.size());
+    free(filename);
+}
+
+void ecl_sum_file_data::stream_type::close() {
+    if (this->fortio) {
+        fortio_fclose(this->fortio);
+        this->fortio = NULL;
+    }
+}
 
-ecl_sum_file_data::~ecl_sum_file_data() { vector_free(data); }
+ecl_sum_file_data::ecl_sum_file_data(const ecl_smspec_type *smspec,
+                                     const std::string &header_file)
+    : ecl_smspec(smspec), header_file(header_file), data(vector_alloc_new()) {
+}
+
+ecl_sum_file_data::~ecl_sum_file_data() {
+    if (this->stream) {
+        this->stream_flush(true);
+        this->stream->close();
+        if (this->stream->params_kw) {
+            ecl_kw_free(this->stream->seqhdr_kw);
+            ecl_kw_free(this->stream->ministep_kw);
+            ecl_kw_free(this->stream->params_kw);
+        }
+    }
+    vector_free(data);
+}
 
 int ecl_sum_file_data::length() const {
     if (this->loader)
@@ -258,7 +331,13 @@ double ecl_sum_file_data::get_sim_length() const {
 double ecl_sum_file_data::iget(int time_index, int params_index) const {
     if (this->loader)
         return this->loader->iget(time_index, params_index);
-    else {
+    else if (!this->params_ministep.empty()) {
+        int params_size = ecl_smspec_get_params_size(this->ecl_smspec);
+        if (params_index < 0 || params_index >= params_size)
+            util_abort("%s: param index:%d invalid: Valid range: [0,%d) \n",
+                       __func__, params_index, params_size);
+        return this->iget_params(time_index)[params_index];
+    } else {
         const ecl_sum_tstep_type *ministep_data = iget_ministep(time_index);
         return ecl_sum_tstep_iget(ministep_data, params_index);
     }
@@ -273,6 +352,68 @@ void ecl_sum_file_data::append_tstep(ecl_sum_tstep_type *tstep) {
     vector_append_owned_ref(data, tstep, ecl_sum_tstep_free__);
 }
 
+/*
+  Appends the content of @params_kw as a new row of the params matrix;
+  like ecl_sum_tstep_alloc_from_file() a PARAMS keyword of the wrong
+  size is discarded with a warning, and false is returned.
+*/
+
+bool ecl_sum_file_data::append_params(int report_step, int ministep_nr,
+                                      const ecl_kw_type *params_kw,
+                                      const char *src_file) {
+    int params_size = ecl_smspec_get_params_size(this->ecl_smspec);
+    int data_size = ecl_kw_get_size(params_kw);
+
+    if (data_size != params_size) {
+        const char *header_file =
+            this->header_file.empty()
+                ? ecl_smspec_get_header_file(this->ecl_smspec)
+                : this->header_file.c_str();
+        fprintf(stderr,
+                "** Warning size mismatch between timestep loaded from:%s(%d) "
+                "and header:%s(%d) - timestep discarded.\n",
+                src_file, data_size, header_file, params_size);
+        return false;
+    }
+
+    size_t offset = this->params.size();
+    this->params.resize(offset + params_size);
+    ecl_kw_get_memcpy_data(params_kw, this->params.data() + offset);
+    this->params_report.push_back(report_step);
+    this->params_ministep.push_back(ministep_nr);
+    return true;
+}
+
+const float *ecl_sum_file_data::iget_params(int time_index) const {
+    size_t params_size = ecl_smspec_get_params_size(this->ecl_smspec);
+    return this->params.data() + time_index * params_size;
+}
+
+/*
+  The loaded timesteps are converted to tsteps before new tsteps are
+  added with add_new_tstep(); the new tsteps have no counterpart in the
+  file, so the case can not be refreshed from the file after that.
+*/
+
+void ecl_sum_file_data::params_to_tsteps() {
+    int params_size = ecl_smspec_get_params_size(this->ecl_smspec);
+
+    for (size_t row = 0; row < this->params_ministep.size(); row++) {
+        ecl_kw_type *params_kw = ecl_kw_alloc_new_shared(
+            PARAMS_KW, params_size, ECL_FLOAT,
+            this->params.data() + row * params_size);
+        append_tstep(ecl_sum_tstep_alloc_from_file(
+            this->params_report[row], this->params_ministep[row], params_kw,
+            this->unified_file.c_str(), this->ecl_smspec));
+        ecl_kw_free(params_kw);
+    }
+
+    std::vector<float>().swap(this->params);
+    std::vector<int>().swap(this->params_report);
+    std::vector<int>().swap(this->params_ministep);
+    this->unified_file.clear();
+}
+
 /*
   This function is meant to be called in write mode; and will create a
   new and empty tstep which is appended to the current data. The tstep
@@ -282,7 +423,18 @@ void ecl_sum_file_data::append_tstep(ecl_sum_tstep_type *tstep) {
 
 ecl_sum_tstep_type *ecl_sum_file_data::add_new_tstep(int report_step,
                                                      double sim_seconds) {
-    int ministep_nr = vector_get_size(data);
+    /*
+      When streaming, a new report step means that all the pending
+      tsteps are complete and can be written to disk.
+    */
+    if (this->stream && this->index.size() > 0 &&
+        this->index.back().report_step != report_step)
+        this->stream_flush(false);
+
+    if (!this->params_ministep.empty())
+        this->params_to_tsteps();
+
+    int ministep_nr = this->index.size();
     ecl_sum_tstep_type *tstep = ecl_sum_tstep_alloc_new(
         report_step, ministep_nr, sim_seconds, ecl_smspec);
     ecl_sum_tstep_type *prev_tstep = NULL;
@@ -290,37 +442,123 @@ ecl_sum_tstep_type *ecl_sum_file_data::add_new_tstep(int report_step,
     if (vector_get_size(data) > 0)
         prev_tstep = (ecl_sum_tstep_type *)vector_get_last(data);
 
+    /*
+      In the simple case that we just add another timestep to the
+      currently active report_step, we do a limited update of the
+      index. A timestep which starts a new report step after all the
+      existing timesteps is also just appended to the index, otherwise
+      the index is rebuilt from scratch.
+    */
+    bool same_report =
+        prev_tstep && ecl_sum_tstep_get_report(prev_tstep) == report_step &&
+        ecl_sum_tstep_get_sim_days(prev_tstep) <
+            ecl_sum_tstep_get_sim_days(tstep);
+    bool append =
+        this->index.size() == 0 ||
+        (this->index.back().report_step <= report_step &&
+         this->index.back().sim_seconds < ecl_sum_tstep_get_sim_seconds(tstep));
+
+    if (this->stream && !same_report && !append) {
+        ecl_sum_tstep_free(tstep);
+        throw std::invalid_argument(
+            "ecl_sum_file_data::add_new_tstep: a streaming writer must add "
+            "the timesteps in order");
+    }
+
     append_tstep(tstep);
+    if (same_report)
+        this->index.add(ecl_sum_tstep_get_sim_time(tstep), sim_seconds,
+                        report_step);
+    else if (append)
+        this->index.add(ecl_sum_tstep_get_sim_time(tstep),
+                        ecl_sum_tstep_get_sim_seconds(tstep), report_step);
+    else
+        this->build_index();
 
-    bool rebuild_index = true;
-    /*
-    In the simple case that we just add another timestep to the
-    currently active report_step, we do a limited update of the
-    index, otherwise we call ecl_sum_data_build_index() to get a
-    full recalculation of the index.
-  */
-    if (!prev_tstep)
-        goto exit;
+    return tstep;
+}
 
-    if (ecl_sum_tstep_get_report(prev_tstep) != ecl_sum_tstep_get_report(tstep))
-        goto exit;
+/*
+  Puts the file data in streaming mode: every time a tstep with a new
+  report step is added the pending tsteps, i.e. the completed report
+  steps, are written to the summary file(s) of @ecl_case and released.
+  The tsteps must be added in order, and the values of the tsteps
+  which have been written can not be accessed any more.
+*/
 
-    if (ecl_sum_tstep_get_sim_days(prev_tstep) >=
-        ecl_sum_tstep_get_sim_days(tstep))
-        goto exit;
+void ecl_sum_file_data::stream_open(const char *ecl_case, bool fmt_case,
+                                    bool unified) {
+    if (this->length() > 0 || this->loader)
+        throw std::logic_error("ecl_sum_file_data::stream_open: streaming "
+                               "must start with an empty writer");
 
-    this->index.add(ecl_sum_tstep_get_sim_time(tstep), sim_seconds,
-                    report_step);
-    rebuild_index = false;
+    this->stream.reset(new stream_type());
+    this->stream->ecl_case = ecl_case;
+    this->stream->fmt_case = fmt_case;
+    this->stream->unified = unified;
+}
 
-exit:
-    if (rebuild_index)
-        this->build_index();
+bool ecl_sum_file_data::is_stream() const { return (bool)this->stream; }
 
-    return tstep;
+/*
+  Writes all the pending tsteps and releases them. A report step which
+  is continued in a later flush is not given a new SEQHDR, so it is
+  safe to flush in the middle of a report step. With @sync the data
+  is also flushed from the stdio buffer; the unified file is kept open
+  until the file data is destroyed.
+*/
+
+void ecl_sum_file_data::stream_flush(bool sync) {
+    stream_type &stream = *this->stream;
+    const int *index_map = ecl_smspec_get_index_map(this->ecl_smspec);
+    int index_map_size = ecl_smspec_num_nodes(this->ecl_smspec);
+    int pending = vector_get_size(this->data);
+
+    if (pending > 0 && !stream.params_kw) {
+        stream.seqhdr_kw = ecl_kw_alloc(SEQHDR_KW, SEQHDR_SIZE, ECL_INT);
+        ecl_kw_iset_int(stream.seqhdr_kw, 0, 0);
+        stream.ministep_kw = ecl_kw_alloc(MINISTEP_KW, 1, ECL_INT);
+        stream.params_kw = ecl_kw_alloc(PARAMS_KW, index_map_size, ECL_FLOAT);
+    }
+
+    for (int i = 0; i < pending; i++) {
+        const ecl_sum_tstep_type *tstep =
+            (const ecl_sum_tstep_type *)vector_iget_const(this->data, i);
+        int report_step = ecl_sum_tstep_get_report(tstep);
+
+        if (report_step != stream.last_report) {
+            if (!stream.unified)
+                stream.close();
+            if (!stream.fortio)
+                stream.open(report_step, false);
+
+            ecl_kw_fwrite(stream.seqhdr_kw, stream.fortio);
+            stream.last_report = report_step;
+        } else if (!stream.fortio)
+            stream.open(report_step, true);
+
+        ecl_sum_tstep_fwrite_kw(tstep, index_map, index_map_size,
+                                stream.ministep_kw, stream.params_kw,
+                                stream.fortio);
+    }
+
+    if (!stream.unified)
+        stream.close();
+    else if (sync && stream.fortio)
+        fortio_fflush(stream.fortio);
+
+    stream.written += pending;
+    vector_clear(this->data);
 }
 
 ecl_sum_tstep_type *ecl_sum_file_data::iget_ministep(int internal_index) const {
+    if (this->stream) {
+        internal_index -= this->stream->written;
+        if (internal_index < 0)
+            throw std::out_of_range(
+                "ecl_sum_file_data::iget_ministep: the timestep has been "
+                "written to disk");
+    }
     return (ecl_sum_tstep_type *)vector_iget(data, internal_index);
 }
 
@@ -349,6 +587,49 @@ static int cmp_ministep(const void *arg1, const void *arg2) {
         return 1;
 }
 
+/*
+  Sorts the rows of the params matrix by time, like the tsteps are
+  sorted in build_index(); @sim_time and @sim_seconds hold the time of
+  each row and are sorted along. Normally the rows are already in order
+  and nothing is moved.
+*/
+
+void ecl_sum_file_data::sort_params(std::vector<time_t> &sim_time,
+                                    std::vector<double> &sim_seconds) {
+    if (std::is_sorted(sim_time.begin(), sim_time.end()))
+        return;
+
+    size_t num_rows = sim_time.size();
+    size_t params_size = ecl_smspec_get_params_size(this->ecl_smspec);
+    std::vector<size_t> order(num_rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&sim_time](size_t row1, size_t row2) {
+                         return sim_time[row1] < sim_time[row2];
+                     });
+
+    std::vector<float> params(this->params.size());
+    std::vector<int> params_report(num_rows);
+    std::vector<int> params_ministep(num_rows);
+    std::vector<time_t> sorted_time(num_rows);
+    std::vector<double> sorted_seconds(num_rows);
+    for (size_t row = 0; row < num_rows; row++) {
+        size_t src = order[row];
+        std::copy_n(this->params.begin() + src * params_size, params_size,
+                    params.begin() + row * params_size);
+        params_report[row] = this->params_report[src];
+        params_ministep[row] = this->params_ministep[src];
+        sorted_time[row] = sim_time[src];
+        sorted_seconds[row] = sim_seconds[src];
+    }
+
+    this->params.swap(params);
+    this->params_report.swap(params_report);
+    this->params_ministep.swap(params_ministep);
+    sim_time.swap(sorted_time);
+    sim_seconds.swap(sorted_seconds);
+}
+
 void ecl_sum_file_data::build_index() {
     this->index.clear();
 
@@ -361,6 +642,20 @@ void ecl_sum_file_data::build_index() {
         for (int i = 0; i < this->loader->length(); i++) {
             this->index.add(sim_time[i], sim_seconds[i], report_steps[i]);
         }
+    } else if (!this->params_ministep.empty()) {
+        size_t num_rows = this->params_ministep.size();
+        std::vector<time_t> sim_time(num_rows);
+        std::vector<double> sim_seconds(num_rows);
+
+        for (size_t row = 0; row < num_rows; row++)
+            ecl_sum_tstep_time_from_params(this->iget_params(row),
+                                           this->ecl_smspec, &sim_time[row],
+                                           &sim_seconds[row]);
+
+        this->sort_params(sim_time, sim_seconds);
+        for (size_t row = 0; row < num_rows; row++)
+            this->index.add(sim_time[row], sim_seconds[row],
+                            this->params_report[row]);
     } else {
         vector_sort(data, cmp_ministep);
         for (int internal_index = 0; internal_index < vector_get_size(data);
@@ -399,12 +694,89 @@ void ecl_sum_file_data::get_data(int params_index, int length, double *data) {
     if (this->loader) {
         const auto tmp_data = loader->get_vector(params_index);
         memcpy(data, tmp_data.data(), length * sizeof data);
+    } else if (!this->params_ministep.empty()) {
+        size_t params_size = ecl_smspec_get_params_size(this->ecl_smspec);
+        const float *column = this->params.data() + params_index;
+        for (int time_index = 0; time_index < length; time_index++)
+            data[time_index] = column[time_index * params_size];
     } else {
         for (int time_index = 0; time_index < length; time_index++)
             data[time_index] = this->iget(time_index, params_index);
     }
 }
 
+/*
+  Will fill in the data for all the params indices in @params_indices,
+  the value for params_indices[i] at time_index is stored in
+  data[time_index * time_stride + i]. Negative params indices are
+  skipped, and the corresponding elements in @data are left untouched.
+*/
+
+void ecl_sum_file_data::get_data(const std::vector<int> &params_indices,
+                                 int length, double *data, int time_stride) {
+    if (this->loader) {
+        const auto tmp_data = loader->get_vectors(params_indices);
+        for (size_t i = 0; i < params_indices.size(); i++) {
+            if (params_indices[i] < 0)
+                continue;
+
+            for (int time_index = 0; time_index < length; time_index++)
+                data[time_index * time_stride + i] = tmp_data[i][time_index];
+        }
+    } else if (!this->params_ministep.empty()) {
+        for (int time_index = 0; time_index < length; time_index++) {
+            const float *row = this->iget_params(time_index);
+            for (size_t i = 0; i < params_indices.size(); i++) {
+                if (params_indices[i] >= 0)
+                    data[time_index * time_stride + i] = row[params_indices[i]];
+            }
+        }
+    } else {
+        for (int time_index = 0; time_index < length; time_index++) {
+            const ecl_sum_tstep_type *ministep_data =
+                iget_ministep(time_index);
+            for (size_t i = 0; i < params_indices.size(); i++) {
+                if (params_indices[i] >= 0)
+                    data[time_index * time_stride + i] =
+                        ecl_sum_tstep_iget(ministep_data, params_indices[i]);
+            }
+        }
+    }
+}
+
+/*
+  As get_data() above, but only for the ministeps in @time_indices; the
+  value for params_indices[i] at time_indices[k] is stored in
+  data[k * time_stride + i].
+*/
+
+void ecl_sum_file_data::get_data_at(const std::vector<int> &time_indices,
+                                    const std::vector<int> &params_indices,
+                                    double *data, int time_stride) {
+    if (this->loader)
+        this->loader->get_rows(time_indices, params_indices, data,
+                               time_stride);
+    else if (!this->params_ministep.empty()) {
+        for (size_t k = 0; k < time_indices.size(); k++) {
+            const float *row = this->iget_params(time_indices[k]);
+            for (size_t i = 0; i < params_indices.size(); i++) {
+                if (params_indices[i] >= 0)
+                    data[k * time_stride + i] = row[params_indices[i]];
+            }
+        }
+    } else {
+        for (size_t k = 0; k < time_indices.size(); k++) {
+            const ecl_sum_tstep_type *ministep_data =
+                iget_ministep(time_indices[k]);
+            for (size_t i = 0; i < params_indices.size(); i++) {
+                if (params_indices[i] >= 0)
+                    data[k * time_stride + i] =
+                        ecl_sum_tstep_iget(ministep_data, params_indices[i]);
+            }
+        }
+    }
+}
+
 int ecl_sum_file_data::get_data_report(int params_index, int end_index,
                                        double *data, double default_value) {
     int offset = 0;
@@ -443,13 +815,31 @@ void ecl_sum_file_data::fwrite_report(int report_step,
     }
 
     {
+        const int *index_map = ecl_smspec_get_index_map(ecl_smspec);
+        int index_map_size = ecl_smspec_num_nodes(ecl_smspec);
+        ecl_kw_type *ministep_kw = ecl_kw_alloc(MINISTEP_KW, 1, ECL_INT);
+        ecl_kw_type *params_kw =
+            ecl_kw_alloc(PARAMS_KW, index_map_size, ECL_FLOAT);
         auto range = this->report_range(report_step);
+
         for (int index = range.first; index <= range.second; index++) {
-            const ecl_sum_tstep_type *tstep = iget_ministep(index);
-            //ecl_sum_tstep_fwrite( tstep , ecl_smspec_get_index_map( ecl_smspec ) , fortio );
-            ecl_sum_tstep_fwrite(tstep, ecl_smspec_get_index_map(ecl_smspec),
-                                 ecl_smspec_num_nodes(ecl_smspec), fortio);
+            if (this->params_ministep.empty())
+                ecl_sum_tstep_fwrite_kw(iget_ministep(index), index_map,
+                                        index_map_size, ministep_kw, params_kw,
+                                        fortio);
+            else {
+                const float *row = this->iget_params(index);
+                float *data = (float *)ecl_kw_get_ptr(params_kw);
+
+                ecl_kw_iset_int(ministep_kw, 0, this->params_ministep[index]);
+                ecl_kw_fwrite(ministep_kw, fortio);
+                for (int i = 0; i < index_map_size; i++)
+                    data[i] = row[index_map[i]];
+                ecl_kw_fwrite(params_kw, fortio);
+            }
         }
+        ecl_kw_free(ministep_kw);
+        ecl_kw_free(params_kw);
     }
 }
 
@@ -497,10 +887,17 @@ double ecl_sum_file_data::get_days_start() const {
     return node.sim_seconds * 86400;
 }
 
+/*
+  A file which is still being written can have one trailing MINISTEP
+  keyword where the corresponding PARAMS keyword is not yet complete;
+  that timestep is ignored until the file is refreshed.
+*/
+
 bool ecl_sum_file_data::check_file(ecl_file_type *ecl_file) {
-    return ecl_file_has_kw(ecl_file, PARAMS_KW) &&
-           (ecl_file_get_num_named_kw(ecl_file, PARAMS_KW) ==
-            ecl_file_get_num_named_kw(ecl_file, MINISTEP_KW));
+    int num_params = ecl_file_get_num_named_kw(ecl_file, PARAMS_KW);
+    int num_ministep = ecl_file_get_num_named_kw(ecl_file, MINISTEP_KW);
+    return (num_params > 0) &&
+           ((num_ministep == num_params) || (num_ministep == num_params + 1));
 }
 
 /**
@@ -541,15 +938,9 @@ void ecl_sum_file_data::add_ecl_file(int report_step,
             ecl_kw_type *params_kw =
                 ecl_file_view_iget_named_kw(summary_view, PARAMS_KW, ikw);
 
-            {
-                int ministep_nr = ecl_kw_iget_int(ministep_kw, 0);
-                ecl_sum_tstep_type *tstep = ecl_sum_tstep_alloc_from_file(
-                    report_step, ministep_nr, params_kw,
-                    ecl_file_view_get_src_file(summary_view), this->ecl_smspec);
-
-                if (tstep)
-                    append_tstep(tstep);
-            }
+            int ministep_nr = ecl_kw_iget_int(ministep_kw, 0);
+            this->append_params(report_step, ministep_nr, params_kw,
+                                ecl_file_view_get_src_file(summary_view));
         }
     }
 }
@@ -605,6 +996,11 @@ bool ecl_sum_file_data::fread(const stringlist_type *filelist, bool lazy_load,
                 int first_report_step =
                     ecl_smspec_get_first_step(this->ecl_smspec);
                 int block_index = 0;
+
+                /* All the rows of the params matrix are allocated up front. */
+                this->params.reserve(
+                    size_t(ecl_file_get_num_named_kw(ecl_file, PARAMS_KW)) *
+                    ecl_smspec_get_params_size(this->ecl_smspec));
                 while (true) {
                     /*
             Observe that there is a number discrepancy between ECLIPSE
@@ -618,10 +1014,29 @@ bool ecl_sum_file_data::fread(const stringlist_type *filelist, bool lazy_load,
                     if (summary_view) {
                         this->add_ecl_file(block_index + first_report_step,
                                            summary_view);
+                        if (ecl_file_view_has_kw(summary_view, PARAMS_KW))
+                            this->last_params_report =
+                                block_index + first_report_step;
                         block_index++;
                     } else
                         break;
                 }
+
+                {
+                    const ecl_file_view_type *global_view =
+                        ecl_file_get_global_view(ecl_file);
+                    int num_params =
+                        ecl_file_view_get_num_named_kw(global_view, PARAMS_KW);
+                    if (num_params > 0) {
+                        const ecl_file_kw_type *params_kw =
+                            ecl_file_view_iget_named_file_kw(
+                                global_view, PARAMS_KW, num_params - 1);
+
+                        this->unified_file = stringlist_iget(filelist, 0);
+                        this->last_params_offset =
+                            ecl_file_kw_get_offset(params_kw);
+                    }
+                }
                 ecl_file_close(ecl_file);
             }
         }
@@ -631,6 +1046,107 @@ bool ecl_sum_file_data::fread(const stringlist_type *filelist, bool lazy_load,
     return (length() > 0);
 }
 
+/*
+  Will load the timesteps which have been appended to a unified summary
+  file since it was loaded, e.g. while the simulation is still running,
+  and returns the number of new timesteps. Reading is resumed after the
+  last PARAMS keyword which has been loaded, and stops at the first
+  incomplete keyword; a partially written trailing record is therefore
+  ignored until it has been completed.
+
+  For summary files split in one file per report step nothing is done.
+*/
+
+int ecl_sum_file_data::refresh() {
+    if (this->loader) {
+        int old_length = this->loader->length();
+        int new_steps = this->loader->refresh();
+
+        if (new_steps > 0) {
+            int offset = ecl_smspec_get_first_step(this->ecl_smspec) - 1;
+            std::vector<int> report_steps = this->loader->report_steps(offset);
+
+            for (int i = old_length; i < this->loader->length(); i++)
+                this->index.add(this->loader->iget_sim_time(i),
+                                this->loader->iget_sim_seconds(i),
+                                report_steps[i]);
+        }
+        return new_steps;
+    }
+
+    if (this->unified_file.empty())
+        return 0;
+
+    bool fmt_file;
+    ecl_util_fmt_file(this->unified_file.c_str(), &fmt_file);
+    fortio_type *fortio = fortio_open_reader(this->unified_file.c_str(),
+                                             fmt_file, ECL_ENDIAN_FLIP);
+    if (!fortio)
+        return 0;
+
+    int new_steps = 0;
+    bool rebuild_index = false;
+    int report_step = this->last_params_report;
+    ecl_kw_type *ministep_kw = NULL;
+    ecl_kw_type *work_kw = ecl_kw_alloc_empty();
+
+    /* Skip the PARAMS keyword which has already been loaded. */
+    fortio_fseek(fortio, this->last_params_offset, SEEK_SET);
+    bool read_ok = (ecl_kw_fread_header(work_kw, fortio) == ECL_KW_READ_OK) &&
+                   ecl_kw_name_equal(work_kw, PARAMS_KW) &&
+                   ecl_kw_fskip_data(work_kw, fortio);
+
+    while (read_ok) {
+        offset_type kw_offset = fortio_ftell(fortio);
+        ecl_kw_type *ecl_kw = ecl_kw_fread_alloc(fortio);
+        if (!ecl_kw)
+            break;
+
+        if (ecl_kw_name_equal(ecl_kw, SEQHDR_KW))
+            report_step++;
+        else if (ecl_kw_name_equal(ecl_kw, MINISTEP_KW)) {
+            if (ministep_kw)
+                ecl_kw_free(ministep_kw);
+            ministep_kw = ecl_kw;
+            continue;
+        } else if (ecl_kw_name_equal(ecl_kw, PARAMS_KW) && ministep_kw) {
+            int ministep_nr = ecl_kw_iget_int(ministep_kw, 0);
+            if (this->append_params(report_step, ministep_nr, ecl_kw,
+                                    this->unified_file.c_str())) {
+                int row = this->params_ministep.size() - 1;
+                time_t sim_time;
+                double sim_seconds;
+
+                ecl_sum_tstep_time_from_params(this->iget_params(row),
+                                               this->ecl_smspec, &sim_time,
+                                               &sim_seconds);
+                if (this->index.size() > 0 && sim_time > this->get_sim_end())
+                    this->index.add(sim_time, sim_seconds, report_step);
+                else
+                    rebuild_index = true;
+
+                new_steps++;
+            }
+
+            this->last_params_offset = kw_offset;
+            this->last_params_report = report_step;
+            ecl_kw_free(ministep_kw);
+            ministep_kw = NULL;
+        }
+        ecl_kw_free(ecl_kw);
+    }
+
+    if (ministep_kw)
+        ecl_kw_free(ministep_kw);
+    ecl_kw_free(work_kw);
+    fortio_fclose(fortio);
+
+    if (rebuild_index)
+        this->build_index();
+
+    return new_steps;
+}
+
 const ecl_smspec_type *ecl_sum_file_data::smspec() const {
     return this->ecl_smspec;
 }
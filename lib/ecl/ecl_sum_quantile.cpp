@@ -0,0 +1,184 @@
+#include <math.h>
+
+#include <string>
+#include <vector>
+
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_sum.hpp>
+#include <ert/ecl/ecl_sum_quantile.hpp>
+
+#include "detail/util/quantile_sketch.hpp"
+
+#define ECL_SUM_QUANTILE_TYPE_ID 7719305
+
+struct ecl_sum_quantile_struct {
+    UTIL_TYPE_ID_DECLARATION;
+    std::vector<std::string> keys;
+    time_t_vector_type *time_points;
+    int size; /* The number of cases which have been added. */
+    std::vector<int> count; /* The number of cases with each key. */
+    /* One sketch for each (key, time) pair: [key * num_time + time]. */
+    std::vector<ecl::util::quantile_sketch> sketches;
+};
+
+UTIL_IS_INSTANCE_FUNCTION(ecl_sum_quantile, ECL_SUM_QUANTILE_TYPE_ID)
+
+/**
+   The @capacity is the number of values each quantile sketch can hold
+   before it starts to approximate; with fewer cases than this the
+   quantiles are exactly those of statistics_empirical_quantile(). If
+   @capacity <= 0 ECL_SUM_QUANTILE_DEFAULT_CAPACITY is used.
+*/
+
+ecl_sum_quantile_type *
+ecl_sum_quantile_alloc(const stringlist_type *keys,
+                       const time_t_vector_type *time_points, int capacity) {
+    if (capacity <= 0)
+        capacity = ECL_SUM_QUANTILE_DEFAULT_CAPACITY;
+
+    ecl_sum_quantile_type *quantile = new ecl_sum_quantile_type();
+    UTIL_TYPE_ID_INIT(quantile, ECL_SUM_QUANTILE_TYPE_ID);
+    for (int k = 0; k < stringlist_get_size(keys); k++)
+        quantile->keys.push_back(stringlist_iget(keys, k));
+
+    quantile->time_points = time_t_vector_alloc_copy(time_points);
+    quantile->size = 0;
+    quantile->count.resize(quantile->keys.size(), 0);
+    quantile->sketches.resize(quantile->keys.size() *
+                                  time_t_vector_size(time_points),
+                              ecl::util::quantile_sketch(capacity));
+    return quantile;
+}
+
+void ecl_sum_quantile_free(ecl_sum_quantile_type *quantile) {
+    time_t_vector_free(quantile->time_points);
+    delete quantile;
+}
+
+/**
+   Interpolates all the keys of @ecl_sum to the time axis and adds the
+   values to the sketches. Keys which are not present in @ecl_sum are
+   skipped, so the keys can have different number of samples, see
+   ecl_sum_quantile_iget_count().
+
+   The interpolation is serial because a lazy loaded ecl_sum instance
+   can not be used from several threads, updating the sketches is done
+   in parallel over the keys.
+*/
+
+void ecl_sum_quantile_add_case(ecl_sum_quantile_type *quantile,
+                               const ecl_sum_type *ecl_sum) {
+    const int num_keys = quantile->keys.size();
+    const int num_time = time_t_vector_size(quantile->time_points);
+    std::vector<double> values(size_t(num_keys) * num_time);
+    std::vector<bool> has_key(num_keys);
+
+    for (int k = 0; k < num_keys; k++) {
+        const char *key = quantile->keys[k].c_str();
+        has_key[k] = ecl_sum_has_key(ecl_sum, key);
+        if (has_key[k]) {
+            ecl_sum_init_double_vector_interp(ecl_sum, key,
+                                              quantile->time_points,
+                                              &values[size_t(k) * num_time]);
+            quantile->count[k]++;
+        }
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < num_keys; k++) {
+        if (!has_key[k])
+            continue;
+
+        for (int t = 0; t < num_time; t++) {
+            size_t index = size_t(k) * num_time + t;
+            quantile->sketches[index].add(values[index]);
+        }
+    }
+
+    quantile->size++;
+}
+
+/**
+   Will load the cases in @case_list one at a time, add them and discard
+   them again. Cases which can not be loaded are skipped with a warning,
+   the return value is the number of cases which were added.
+*/
+
+int ecl_sum_quantile_add_cases(ecl_sum_quantile_type *quantile,
+                               const stringlist_type *case_list,
+                               const char *key_join_string) {
+    int num_added = 0;
+    for (int i = 0; i < stringlist_get_size(case_list); i++) {
+        const char *case_name = stringlist_iget(case_list, i);
+        ecl_sum_type *ecl_sum =
+            ecl_sum_fread_alloc_case(case_name, key_join_string);
+        if (!ecl_sum) {
+            fprintf(stderr, "** Warning: could not load summary case:%s\n",
+                    case_name);
+            continue;
+        }
+
+        ecl_sum_quantile_add_case(quantile, ecl_sum);
+        ecl_sum_free(ecl_sum);
+        num_added++;
+    }
+    return num_added;
+}
+
+int ecl_sum_quantile_get_size(const ecl_sum_quantile_type *quantile) {
+    return quantile->size;
+}
+
+int ecl_sum_quantile_iget_count(const ecl_sum_quantile_type *quantile,
+                                int key_index) {
+    return quantile->count.at(key_index);
+}
+
+/**
+   Returns true as long as the quantiles are computed from all the
+   values, i.e. no sketch has exceeded its capacity.
+*/
+
+bool ecl_sum_quantile_is_exact(const ecl_sum_quantile_type *quantile) {
+    for (const auto &sketch : quantile->sketches)
+        if (!sketch.exact())
+            return false;
+    return true;
+}
+
+/**
+   The @q quantile of key @key_index at time @time_index; NAN if no case
+   has the key.
+*/
+
+double ecl_sum_quantile_iget(const ecl_sum_quantile_type *quantile,
+                             int key_index, int time_index, double q) {
+    const int num_time = time_t_vector_size(quantile->time_points);
+    if (key_index < 0 || key_index >= (int)quantile->keys.size() ||
+        time_index < 0 || time_index >= num_time)
+        util_abort("%s: invalid key_index:%d / time_index:%d\n", __func__,
+                   key_index, time_index);
+
+    return quantile->sketches[size_t(key_index) * num_time + time_index]
+        .quantile(q);
+}
+
+/**
+   Fills @data with the @q quantile of all the keys at all the time
+   points, with the same layout as ecl_sum_init_double_frame_interp():
+
+      data[time_index * num_keys + key_index]
+*/
+
+void ecl_sum_quantile_init_double_frame(const ecl_sum_quantile_type *quantile,
+                                        double q, double *data) {
+    const int num_keys = quantile->keys.size();
+    const int num_time = time_t_vector_size(quantile->time_points);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < num_keys; k++)
+        for (int t = 0; t < num_time; t++)
+            data[size_t(t) * num_keys + k] =
+                quantile->sketches[size_t(k) * num_time + t].quantile(q);
+}
@@ -124,6 +124,14 @@ void ecl_sum_tstep_free__(void *__ministep) {
     ecl_sum_tstep_free(ministep);
 }
 
+static void ecl_sum_tstep_set_time_info_from_seconds(ecl_sum_tstep_type *tstep,
+                                                     time_t sim_start,
+                                                     double sim_seconds) {
+    tstep->sim_seconds = sim_seconds;
+    tstep->sim_time = sim_start;
+    util_inplace_forward_seconds_utc(&tstep->sim_time, tstep->sim_seconds);
+}
+
 /**
    This function sets the internal time representation in the
    ecl_sum_tstep. The treatment of time is a bit weird; on the one
@@ -143,26 +151,15 @@ void ecl_sum_tstep_free__(void *__ministep) {
            the tstep.
 
    The ecl_sum_tstep class can utilize both types of information, but
-   will select the DAYS variety if both are present.
+   will select the DAYS variety if both are present. The time
+   information is extracted from one PARAMS vector, so that it can
+   also be used for summary data which is not stored as ecl_sum_tstep
+   instances.
 */
 
-static void ecl_sum_tstep_set_time_info_from_seconds(ecl_sum_tstep_type *tstep,
-                                                     time_t sim_start,
-                                                     double sim_seconds) {
-    tstep->sim_seconds = sim_seconds;
-    tstep->sim_time = sim_start;
-    util_inplace_forward_seconds_utc(&tstep->sim_time, tstep->sim_seconds);
-}
-
-static void ecl_sum_tstep_set_time_info_from_date(ecl_sum_tstep_type *tstep,
-                                                  time_t sim_start,
-                                                  time_t sim_time) {
-    tstep->sim_time = sim_time;
-    tstep->sim_seconds = util_difftime_seconds(sim_start, tstep->sim_time);
-}
-
-static void ecl_sum_tstep_set_time_info(ecl_sum_tstep_type *tstep,
-                                        const ecl_smspec_type *smspec) {
+void ecl_sum_tstep_time_from_params(const float *params,
+                                    const ecl_smspec_type *smspec,
+                                    time_t *sim_time, double *sim_seconds) {
     int date_day_index = ecl_smspec_get_date_day_index(smspec);
     int date_month_index = ecl_smspec_get_date_month_index(smspec);
     int date_year_index = ecl_smspec_get_date_year_index(smspec);
@@ -170,22 +167,29 @@ static void ecl_sum_tstep_set_time_info(ecl_sum_tstep_type *tstep,
     time_t sim_start = ecl_smspec_get_start_time(smspec);
 
     if (sim_time_index >= 0) {
-        double sim_time = tstep->data[sim_time_index];
-        double sim_seconds = sim_time * ecl_smspec_get_time_seconds(smspec);
-        ecl_sum_tstep_set_time_info_from_seconds(tstep, sim_start, sim_seconds);
+        double time = params[sim_time_index];
+        *sim_seconds = time * ecl_smspec_get_time_seconds(smspec);
+        *sim_time = sim_start;
+        util_inplace_forward_seconds_utc(sim_time, *sim_seconds);
     } else if (date_day_index >= 0) {
-        int day = util_roundf(tstep->data[date_day_index]);
-        int month = util_roundf(tstep->data[date_month_index]);
-        int year = util_roundf(tstep->data[date_year_index]);
+        int day = util_roundf(params[date_day_index]);
+        int month = util_roundf(params[date_month_index]);
+        int year = util_roundf(params[date_year_index]);
 
-        time_t sim_time = ecl_util_make_date(day, month, year);
-        ecl_sum_tstep_set_time_info_from_date(tstep, sim_start, sim_time);
+        *sim_time = ecl_util_make_date(day, month, year);
+        *sim_seconds = util_difftime_seconds(sim_start, *sim_time);
     } else
         util_abort("%s: Hmmm - could not extract date/time information from "
                    "SMSPEC header file? \n",
                    __func__);
 }
 
+static void ecl_sum_tstep_set_time_info(ecl_sum_tstep_type *tstep,
+                                        const ecl_smspec_type *smspec) {
+    ecl_sum_tstep_time_from_params(tstep->data.data(), smspec,
+                                   &tstep->sim_time, &tstep->sim_seconds);
+}
+
 /**
    If the ecl_kw instance is in some way invalid (i.e. wrong size);
    the function will return NULL:
@@ -267,31 +271,39 @@ int ecl_sum_tstep_get_ministep(const ecl_sum_tstep_type *ministep) {
     return ministep->ministep;
 }
 
-void ecl_sum_tstep_fwrite(const ecl_sum_tstep_type *ministep,
-                          const int *index_map, int index_map_size,
-                          fortio_type *fortio) {
+/*
+  Writes the MINISTEP and PARAMS keywords of @ministep to @fortio using
+  the preallocated keywords @ministep_kw (one int) and @params_kw
+  (@index_map_size floats); when many timesteps are written this
+  avoids allocating new keywords for every timestep.
+*/
+
+void ecl_sum_tstep_fwrite_kw(const ecl_sum_tstep_type *ministep,
+                             const int *index_map, int index_map_size,
+                             ecl_kw_type *ministep_kw, ecl_kw_type *params_kw,
+                             fortio_type *fortio) {
+    ecl_kw_iset_int(ministep_kw, 0, ministep->ministep);
+    ecl_kw_fwrite(ministep_kw, fortio);
+
     {
-        ecl_kw_type *ministep_kw = ecl_kw_alloc(MINISTEP_KW, 1, ECL_INT);
-        ecl_kw_iset_int(ministep_kw, 0, ministep->ministep);
-        ecl_kw_fwrite(ministep_kw, fortio);
-        ecl_kw_free(ministep_kw);
+        float *data = (float *)ecl_kw_get_ptr(params_kw);
+        for (int i = 0; i < index_map_size; i++)
+            data[i] = ministep->data[index_map[i]];
     }
+    ecl_kw_fwrite(params_kw, fortio);
+}
 
-    {
-        int compact_size = index_map_size;
-        ecl_kw_type *params_kw =
-            ecl_kw_alloc(PARAMS_KW, compact_size, ECL_FLOAT);
+void ecl_sum_tstep_fwrite(const ecl_sum_tstep_type *ministep,
+                          const int *index_map, int index_map_size,
+                          fortio_type *fortio) {
+    ecl_kw_type *ministep_kw = ecl_kw_alloc(MINISTEP_KW, 1, ECL_INT);
+    ecl_kw_type *params_kw = ecl_kw_alloc(PARAMS_KW, index_map_size, ECL_FLOAT);
 
-        float *data = (float *)ecl_kw_get_ptr(params_kw);
+    ecl_sum_tstep_fwrite_kw(ministep, index_map, index_map_size, ministep_kw,
+                            params_kw, fortio);
 
-        {
-            int i;
-            for (i = 0; i < compact_size; i++)
-                data[i] = ministep->data[index_map[i]];
-        }
-        ecl_kw_fwrite(params_kw, fortio);
-        ecl_kw_free(params_kw);
-    }
+    ecl_kw_free(ministep_kw);
+    ecl_kw_free(params_kw);
 }
 
 void ecl_sum_tstep_iset(ecl_sum_tstep_type *tstep, int index, float value) {
@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <iostream>
+#include <stdexcept>
 
 #include <ert/util/int_vector.hpp>
 
@@ -11,6 +13,145 @@
 
 namespace ecl {
 
+#define ECL_SUM_COLUMN_CACHE_ID 7701356
+#define ECL_SUM_COLUMN_CACHE_BLOCK_BYTES (1 << 26)
+
+namespace {
+
+/*
+  The column cache is stored in the hidden file .<name>.columns next to
+  the UNSMRY file. The file starts with a header identifying the
+  UNSMRY file it has been created from, followed by the PARAMS data
+  as float values in column major order:
+
+     int     ECL_SUM_COLUMN_CACHE_ID
+     size_t  size of the UNSMRY file
+     time_t  mtime of the UNSMRY file
+     int     number of elements in each PARAMS keyword
+     int     number of PARAMS keywords
+     float   data[num_params][length]
+*/
+
+const long column_cache_header_size =
+    3 * sizeof(int) + sizeof(size_t) + sizeof(time_t);
+
+std::string alloc_column_cache_name(const std::string &filename) {
+    char *path;
+    char *basename = util_split_alloc_filename(filename.c_str());
+    char *hidden_name = util_alloc_sprintf(".%s", basename);
+
+    util_alloc_file_components(filename.c_str(), &path, NULL, NULL);
+    char *cache_name = util_alloc_filename(path, hidden_name, "columns");
+    std::string cache_file = cache_name;
+
+    free(cache_name);
+    free(path);
+    free(hidden_name);
+    free(basename);
+    return cache_file;
+}
+
+bool column_cache_valid(const std::string &cache_file, size_t file_size,
+                        time_t mtime, int size, int length) {
+    FILE *stream = fopen(cache_file.c_str(), "rb");
+    if (!stream)
+        return false;
+
+    int id, cache_size, cache_length;
+    size_t cache_file_size;
+    time_t cache_mtime;
+    bool valid = (fread(&id, sizeof id, 1, stream) == 1) &&
+                 (id == ECL_SUM_COLUMN_CACHE_ID) &&
+                 (fread(&cache_file_size, sizeof cache_file_size, 1, stream) ==
+                  1) &&
+                 (fread(&cache_mtime, sizeof cache_mtime, 1, stream) == 1) &&
+                 (fread(&cache_size, sizeof cache_size, 1, stream) == 1) &&
+                 (fread(&cache_length, sizeof cache_length, 1, stream) == 1) &&
+                 (cache_file_size == file_size) && (cache_mtime == mtime) &&
+                 (cache_size == size) && (cache_length == length);
+
+    if (valid) {
+        /* Guard against a truncated cache file. */
+        long data_size = (long)size * length * sizeof(float);
+        valid = (util_fseek(stream, 0, SEEK_END) == 0) &&
+                (util_ftell(stream) == column_cache_header_size + data_size);
+    }
+
+    fclose(stream);
+    return valid;
+}
+
+/*
+  Transposes the PARAMS keywords of @file_view to the column major
+  cache file. The transposition is done in tiles of consecutive
+  timesteps, so that at most ECL_SUM_COLUMN_CACHE_BLOCK_BYTES are held
+  in memory; the part of each column which belongs to a tile is written
+  at its final offset in the file. The cache is written to a temporary
+  file which is then renamed, so that concurrent readers never see a
+  partially written cache file.
+*/
+
+bool write_column_cache(const std::string &cache_file, size_t file_size,
+                        time_t mtime, int size, int length,
+                        const ecl_file_view_type *file_view) {
+    char *path;
+    util_alloc_file_components(cache_file.c_str(), &path, NULL, NULL);
+    char *tmp_file =
+        util_alloc_tmp_file(path ? path : ".", ".ecl_columns", true);
+    FILE *stream = fopen(tmp_file, "wb");
+    bool write_ok = false;
+
+    if (stream) {
+        int tile_length = std::max(
+            1, (int)std::min<size_t>(length, ECL_SUM_COLUMN_CACHE_BLOCK_BYTES /
+                                                 (size * sizeof(float))));
+        std::vector<float> tile((size_t)size * tile_length);
+        ecl_kw_type *params_kw = ecl_kw_alloc(PARAMS_KW, size, ECL_FLOAT);
+
+        util_fwrite_int(ECL_SUM_COLUMN_CACHE_ID, stream);
+        util_fwrite_size_t(file_size, stream);
+        util_fwrite_time_t(mtime, stream);
+        util_fwrite_int(size, stream);
+        util_fwrite_int(length, stream);
+        write_ok = true;
+
+        for (int first = 0; first < length && write_ok; first += tile_length) {
+            int rows = std::min(tile_length, length - first);
+
+            for (int row = 0; row < rows && write_ok; row++) {
+                write_ok = ecl_file_view_index_fread_kw(file_view, PARAMS_KW,
+                                                        first + row, params_kw);
+                const float *params = ecl_kw_get_float_ptr(params_kw);
+                for (int i = 0; i < size && write_ok; i++)
+                    tile[(size_t)i * rows + row] = params[i];
+            }
+
+            for (int i = 0; i < size && write_ok; i++) {
+                offset_type offset =
+                    column_cache_header_size +
+                    ((offset_type)i * length + first) * sizeof(float);
+                write_ok = (util_fseek(stream, offset, SEEK_SET) == 0) &&
+                           (fwrite(&tile[(size_t)i * rows], sizeof(float), rows,
+                                   stream) == (size_t)rows);
+            }
+        }
+        ecl_kw_free(params_kw);
+
+        write_ok = (fclose(stream) == 0) && write_ok;
+        if (write_ok)
+            write_ok = (rename(tmp_file, cache_file.c_str()) == 0);
+
+        if (!write_ok)
+            remove(tmp_file);
+    }
+
+    free(tmp_file);
+    free(path);
+    return write_ok;
+}
+
+} // namespace
+
 unsmry_loader::unsmry_loader(const ecl_smspec_type *smspec,
                              const std::string &filename, int file_options)
     : size(ecl_smspec_get_params_size(smspec)),
@@ -26,10 +167,14 @@ unsmry_loader::unsmry_loader(const ecl_smspec_type *smspec,
         throw std::bad_alloc();
     }
 
-    if (ecl_file_get_num_named_kw(file, PARAMS_KW) !=
-        ecl_file_get_num_named_kw(file, MINISTEP_KW)) {
-        ecl_file_close(file);
-        throw std::bad_alloc();
+    /* A trailing MINISTEP without PARAMS is accepted, see refresh(). */
+    {
+        int num_params = ecl_file_get_num_named_kw(file, PARAMS_KW);
+        int num_ministep = ecl_file_get_num_named_kw(file, MINISTEP_KW);
+        if (num_ministep != num_params && num_ministep != num_params + 1) {
+            ecl_file_close(file);
+            throw std::bad_alloc();
+        }
     }
 
     this->date_index = {{ecl_smspec_get_date_day_index(smspec),
@@ -38,12 +183,99 @@ unsmry_loader::unsmry_loader(const ecl_smspec_type *smspec,
     this->file = file;
     this->file_view = ecl_file_get_global_view(this->file);
     this->m_length = ecl_file_view_get_num_named_kw(this->file_view, PARAMS_KW);
+    if (file_options & ECL_FILE_COLUMN_CACHE)
+        this->column_file = alloc_column_cache_name(filename);
 }
 
 unsmry_loader::~unsmry_loader() { ecl_file_close(file); }
 
+/*
+  Will pick up MINISTEP / PARAMS pairs which have been appended to the
+  file since it was opened; returns the number of new timesteps.
+*/
+int unsmry_loader::refresh() {
+    if (ecl_file_refresh(this->file) == 0)
+        return 0;
+
+    int old_length = this->m_length;
+    this->m_length =
+        std::min(ecl_file_view_get_num_named_kw(this->file_view, PARAMS_KW),
+                 ecl_file_view_get_num_named_kw(this->file_view, MINISTEP_KW));
+    return this->m_length - old_length;
+}
+
 int unsmry_loader::length() const { return this->m_length; }
 
+/*
+  Will transpose all the PARAMS keywords to column major order in one
+  sequential pass through the file, and store the result in the column
+  cache file. If a valid cache file already exists nothing is read. If
+  the cache file can not be written, e.g. because the directory is
+  read-only, the vectors are read from the UNSMRY file instead, and the
+  cache is not tried again until the file has grown.
+*/
+
+void unsmry_loader::load_columns() const {
+    const char *filename = ecl_file_get_src_file(this->file);
+    size_t file_size = util_file_size(filename);
+    time_t mtime = util_file_mtime(filename);
+    int length = this->length();
+
+    this->column_length = 0;
+    if (column_cache_valid(this->column_file, file_size, mtime, this->size,
+                           length)) {
+        this->column_length = length;
+        return;
+    }
+
+    if (this->column_failed_length == length)
+        return;
+
+    bool write_ok = write_column_cache(this->column_file, file_size, mtime,
+                                       this->size, length, this->file_view);
+    if (ecl_file_view_flags_set(file_view, ECL_FILE_CLOSE_STREAM))
+        ecl_file_view_fclose_stream(file_view);
+
+    if (write_ok)
+        this->column_length = length;
+    else
+        this->column_failed_length = length;
+}
+
+bool unsmry_loader::column_vector(int pos, std::vector<double> &data) const {
+    int length = this->length();
+    if (this->column_length != length)
+        this->load_columns();
+
+    if (this->column_length != length)
+        return false;
+
+    data.resize(length);
+    std::vector<float> column(length);
+    bool read_ok = false;
+    FILE *stream = fopen(this->column_file.c_str(), "rb");
+    if (stream) {
+        offset_type offset = column_cache_header_size +
+                             (offset_type)pos * length * sizeof(float);
+        read_ok = (util_fseek(stream, offset, SEEK_SET) == 0) &&
+                  (fread(column.data(), sizeof(float), length, stream) ==
+                   (size_t)length);
+        fclose(stream);
+    }
+
+    if (!read_ok) {
+        /*
+          The cache file has been removed under our feet; fall back to
+          reading the UNSMRY file, the cache is rebuilt on next call.
+        */
+        this->column_length = 0;
+        return false;
+    }
+
+    std::copy(column.begin(), column.end(), data.begin());
+    return true;
+}
+
 std::vector<double> unsmry_loader::get_vector(int pos) const {
     if (pos >= size)
         throw std::out_of_range(
@@ -51,6 +283,9 @@ std::vector<double> unsmry_loader::get_vector(int pos) const {
             " PARAMS_SIZE: " + std::to_string(size));
 
     std::vector<double> data(this->length());
+    if (!this->column_file.empty() && this->column_vector(pos, data))
+        return data;
+
     int_vector_type *index_map = int_vector_alloc(1, pos);
     char buffer[4];
 
@@ -68,6 +303,124 @@ std::vector<double> unsmry_loader::get_vector(int pos) const {
     return data;
 }
 
+/*
+  Will load the vectors for all the params indices in @params_indices
+  in one pass through the file; each PARAMS keyword is read with one
+  read and all the requested values are gathered from it. Entries in
+  @params_indices which are negative are ignored, and the
+  corresponding vector in the return value is empty.
+*/
+
+std::vector<std::vector<double>>
+unsmry_loader::get_vectors(const std::vector<int> &params_indices) const {
+    std::vector<std::vector<double>> data(params_indices.size());
+    for (int pos : params_indices) {
+        if (pos >= size)
+            throw std::out_of_range(
+                "unsmry_loader::get_vectors pos: " + std::to_string(pos) +
+                " PARAMS_SIZE: " + std::to_string(size));
+    }
+
+    if (!this->column_file.empty()) {
+        bool cache_ok = true;
+        for (size_t i = 0; i < params_indices.size() && cache_ok; i++) {
+            if (params_indices[i] >= 0)
+                cache_ok = this->column_vector(params_indices[i], data[i]);
+        }
+
+        if (cache_ok)
+            return data;
+    }
+
+    int length = this->length();
+    for (size_t i = 0; i < params_indices.size(); i++) {
+        if (params_indices[i] >= 0)
+            data[i].resize(length);
+    }
+
+    ecl_kw_type *params_kw = ecl_kw_alloc(PARAMS_KW, this->size, ECL_FLOAT);
+    int time_index = 0;
+    for (; time_index < length; time_index++) {
+        if (!ecl_file_view_index_fread_kw(this->file_view, PARAMS_KW,
+                                          time_index, params_kw))
+            break;
+
+        const float *params = ecl_kw_get_float_ptr(params_kw);
+        for (size_t i = 0; i < params_indices.size(); i++) {
+            if (params_indices[i] >= 0)
+                data[i][time_index] = params[params_indices[i]];
+        }
+    }
+    ecl_kw_free(params_kw);
+
+    if (ecl_file_view_flags_set(file_view, ECL_FILE_CLOSE_STREAM))
+        ecl_file_view_fclose_stream(file_view);
+
+    if (time_index < length)
+        throw std::runtime_error(
+            "unsmry_loader::get_vectors failed to load PARAMS keyword " +
+            std::to_string(time_index) + " from: " +
+            ecl_file_get_src_file(this->file));
+
+    return data;
+}
+
+/*
+  Will load the values for @params_indices at the ministeps in
+  @time_indices; the value for params_indices[i] at time_indices[k] is
+  stored in data[k * time_stride + i], negative params indices are
+  skipped. When a large part of the PARAMS keyword is requested the
+  full keyword is read, otherwise only the requested elements.
+*/
+
+void unsmry_loader::get_rows(const std::vector<int> &time_indices,
+                             const std::vector<int> &params_indices,
+                             double *data, int time_stride) const {
+    if (time_indices.empty())
+        return;
+
+    if (params_indices.size() * 8 > (size_t)this->size) {
+        ecl_kw_type *params_kw = ecl_kw_alloc(PARAMS_KW, this->size, ECL_FLOAT);
+        for (size_t k = 0; k < time_indices.size(); k++) {
+            if (!ecl_file_view_index_fread_kw(this->file_view, PARAMS_KW,
+                                              time_indices[k], params_kw))
+                throw std::runtime_error(
+                    "unsmry_loader::get_rows failed to load PARAMS keyword " +
+                    std::to_string(time_indices[k]) + " from: " +
+                    ecl_file_get_src_file(this->file));
+
+            const float *params = ecl_kw_get_float_ptr(params_kw);
+            for (size_t i = 0; i < params_indices.size(); i++) {
+                if (params_indices[i] >= 0)
+                    data[k * time_stride + i] = params[params_indices[i]];
+            }
+        }
+        ecl_kw_free(params_kw);
+    } else {
+        int_vector_type *index_map = int_vector_alloc(0, 0);
+        for (int pos : params_indices) {
+            if (pos >= 0)
+                int_vector_append(index_map, pos);
+        }
+
+        std::vector<float> values(int_vector_size(index_map));
+        for (size_t k = 0; k < time_indices.size(); k++) {
+            ecl_file_view_index_fload_kw(this->file_view, PARAMS_KW,
+                                         time_indices[k], index_map,
+                                         (char *)values.data());
+            int value_index = 0;
+            for (size_t i = 0; i < params_indices.size(); i++) {
+                if (params_indices[i] >= 0)
+                    data[k * time_stride + i] = values[value_index++];
+            }
+        }
+        int_vector_free(index_map);
+    }
+
+    if (ecl_file_view_flags_set(file_view, ECL_FILE_CLOSE_STREAM))
+        ecl_file_view_fclose_stream(file_view);
+}
+
 // This is horribly inefficient
 double unsmry_loader::iget(int time_index, int params_index) const {
     int_vector_type *index_map = int_vector_alloc(1, params_index);
@@ -22,10 +22,19 @@
 #include <string.h>
 #include <errno.h>
 
+#include <ert/util/build_config.h>
 #include <ert/util/util.h>
 #include <ert/util/type_macros.h>
 #include <ert/ecl/fortio.h>
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+#ifdef HAVE_PREAD
+#include <unistd.h>
+#endif
+
 #define FORTIO_ID 345116
 
 /**
@@ -87,6 +96,14 @@ struct fortio_struct {
     bool writable;
     offset_type read_size;
     char opts[3];
+
+    /*
+    Optional read-only memory mapping of the complete file, see
+    fortio_mmap(). The mapping is independent of the FILE stream, and
+    survives fortio_fclose_stream().
+  */
+    char *mmap_data;
+    size_t mmap_size;
 };
 
 UTIL_IS_INSTANCE_FUNCTION(fortio, FORTIO_ID);
@@ -103,6 +120,8 @@ static fortio_type *fortio_alloc__(const char *filename, bool fmt_file,
     fortio->stream_owner = stream_owner;
     fortio->writable = writable;
     fortio->read_size = 0;
+    fortio->mmap_data = NULL;
+    fortio->mmap_size = 0;
     strcpy(fortio->opts, endian_flip_header ? "c" : "ce");
 
     return fortio;
@@ -370,7 +389,18 @@ bool fortio_assert_stream_open(fortio_type *fortio) {
     }
 }
 
+static void fortio_munmap(fortio_type *fortio) {
+#ifdef HAVE_MMAP
+    if (fortio->mmap_data) {
+        munmap(fortio->mmap_data, fortio->mmap_size);
+        fortio->mmap_data = NULL;
+        fortio->mmap_size = 0;
+    }
+#endif
+}
+
 static void fortio_free__(fortio_type *fortio) {
+    fortio_munmap(fortio);
     free(fortio->filename);
     free(fortio);
 }
@@ -544,6 +574,188 @@ bool fortio_fread_buffer(fortio_type *fortio, char *buffer, int buffer_size) {
     return false;
 }
 
+/**
+   Will map the complete file read-only into memory. This is only
+   supported for unformatted files which have been opened read-only;
+   for all other files - or if the mmap() call fails - the function
+   will return false and the fortio instance is unchanged.
+
+   When the file is mapped the function fortio_pread_buffer() will
+   serve data directly from the mapping without touching the FILE
+   stream; the pages of the mapping are shared with the OS page cache,
+   i.e. many processes reading the same file will share memory.
+*/
+
+bool fortio_mmap(fortio_type *fortio) {
+#ifdef HAVE_MMAP
+    if (fortio->mmap_data)
+        return true;
+
+    if (fortio->writable || fortio->fmt_file)
+        return false;
+
+    if (fortio->read_size <= 0)
+        return false;
+
+    if (!fortio_assert_stream_open(fortio))
+        return false;
+
+    {
+        void *data = mmap(NULL, fortio->read_size, PROT_READ, MAP_SHARED,
+                          fortio_fileno(fortio), 0);
+        if (data == MAP_FAILED)
+            return false;
+
+        fortio->mmap_data = (char *)data;
+        fortio->mmap_size = fortio->read_size;
+        return true;
+    }
+#else
+    return false;
+#endif
+}
+
+/**
+   For a file opened read-only the size of the file is recorded when
+   it is opened, and seeks beyond that size fail. When the file is
+   growing, e.g. while a simulation is running, this function can be
+   called to pick up the current size of the file; if the file has
+   been memory mapped the mapping is recreated to cover the new size.
+
+   Returns true if the size of the file has changed.
+*/
+
+bool fortio_refresh_size(fortio_type *fortio) {
+    if (fortio->writable)
+        return false;
+
+    if (!fortio_assert_stream_open(fortio))
+        return false;
+
+    {
+        offset_type old_size = fortio->read_size;
+        fortio_init_size(fortio);
+        if (fortio->read_size == old_size)
+            return false;
+
+        if (fortio->mmap_data) {
+            fortio_munmap(fortio);
+            fortio_mmap(fortio);
+        }
+        return true;
+    }
+}
+
+bool fortio_is_mmapped(const fortio_type *fortio) {
+    return (fortio->mmap_data != NULL);
+}
+
+/*
+  Copy @size bytes from file offset @offset to @dst; either from the
+  memory mapping, or with pread() on the file descriptor of the
+  stream. Neither of them use, or update, the position of the FILE
+  stream, so several threads can call this function concurrently on
+  the same fortio instance.
+*/
+
+static bool fortio_pread_bytes(const fortio_type *fortio, offset_type offset,
+                               void *dst, size_t size) {
+    if (fortio->mmap_data) {
+        if (offset < 0 ||
+            offset + (offset_type)size > (offset_type)fortio->mmap_size)
+            return false;
+
+        memcpy(dst, &fortio->mmap_data[offset], size);
+        return true;
+    }
+
+#ifdef HAVE_PREAD
+    {
+        int fd = fileno(fortio->stream);
+        char *char_dst = (char *)dst;
+        size_t bytes_read = 0;
+
+        while (bytes_read < size) {
+            ssize_t n = pread(fd, &char_dst[bytes_read], size - bytes_read,
+                              offset + bytes_read);
+            if (n < 0 && errno == EINTR)
+                continue;
+
+            if (n <= 0)
+                return false;
+
+            bytes_read += n;
+        }
+        return true;
+    }
+#else
+    return false;
+#endif
+}
+
+static bool fortio_pread_int(const fortio_type *fortio, offset_type offset,
+                             int *value) {
+    if (!fortio_pread_bytes(fortio, offset, value, sizeof *value))
+        return false;
+
+    if (fortio->endian_flip_header)
+        util_endian_flip_vector(value, sizeof *value, 1);
+
+    return true;
+}
+
+/**
+   Positional version of fortio_fread_buffer(): will fill @buffer with
+   @buffer_size bytes from the fortran records starting at file offset
+   @offset. The current position of the FILE stream is not used, and
+   not updated, so the function can be called concurrently from
+   several threads.
+
+   If the file has been mapped with fortio_mmap() the data is served
+   from the mapping, otherwise pread() is used on the open stream. The
+   function will return false if positional reads are not possible,
+   i.e. for formatted or writable files, when the stream is closed or
+   pread() is not available - or if the records starting at @offset
+   do not add up to @buffer_size bytes.
+*/
+
+bool fortio_pread_buffer(const fortio_type *fortio, offset_type offset,
+                         char *buffer, int buffer_size) {
+    int total_bytes_read = 0;
+
+    if (!fortio->mmap_data) {
+        if (fortio->fmt_file || fortio->writable || !fortio->stream)
+            return false;
+    }
+
+    while (total_bytes_read < buffer_size) {
+        int record_size, trailer;
+
+        if (!fortio_pread_int(fortio, offset, &record_size))
+            return false;
+
+        if (record_size < 0 || record_size > buffer_size - total_bytes_read)
+            return false;
+
+        offset += sizeof record_size;
+        if (!fortio_pread_bytes(fortio, offset, &buffer[total_bytes_read],
+                                record_size))
+            return false;
+        offset += record_size;
+
+        if (!fortio_pread_int(fortio, offset, &trailer))
+            return false;
+
+        if (trailer != record_size)
+            return false;
+
+        offset += sizeof trailer;
+        total_bytes_read += record_size;
+    }
+
+    return true;
+}
+
 int fortio_fskip_record(fortio_type *fortio) {
     int record_size = fortio_init_read(fortio);
     fortio_fseek(fortio, (offset_type)record_size, SEEK_CUR);
@@ -775,7 +987,8 @@ int fortio_fileno(fortio_type *fortio) { return fileno(fortio->stream); }
 /*
   It is massively undefined behaviour to call this function for a file
   which has been updated; in that case the util_fd_size() function
-  will return the size of the file *when it was opened*.
+  will return the size of the file *when it was opened* - unless
+  fortio_refresh_size() has been called after the update.
 */
 
 bool fortio_read_at_eof(fortio_type *fortio) {
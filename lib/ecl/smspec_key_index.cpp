@@ -0,0 +1,107 @@
+#include <string.h>
+
+#include <algorithm>
+
+#include "detail/ecl/smspec_key_index.hpp"
+
+/* Initial number of slots; the table is kept at most half full. */
+#define SMSPEC_KEY_INDEX_MIN_SLOTS 64
+
+namespace ecl {
+
+/* 64 bit FNV-1a */
+uint64_t smspec_key_index::hash(const char *key) {
+    uint64_t h = 14695981039346656037ULL;
+    for (const unsigned char *c = (const unsigned char *)key; *c; c++) {
+        h ^= *c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/*
+  Returns the slot holding @key, or the empty slot where it should be
+  inserted. The table is never full, so the probing terminates.
+*/
+size_t smspec_key_index::find_slot(const char *key, uint64_t key_hash) const {
+    const size_t mask = this->slots.size() - 1;
+    size_t pos = key_hash & mask;
+    while (true) {
+        const slot_type &slot = this->slots[pos];
+        if (slot.entry == 0)
+            return pos;
+
+        if (slot.hash == key_hash &&
+            strcmp(this->entry_list[slot.entry - 1].first.c_str(), key) == 0)
+            return pos;
+
+        pos = (pos + 1) & mask;
+    }
+}
+
+void smspec_key_index::rehash(size_t num_slots) {
+    this->slots.assign(num_slots, {0, 0});
+    for (size_t i = 0; i < this->entry_list.size(); i++) {
+        const char *key = this->entry_list[i].first.c_str();
+        uint64_t key_hash = hash(key);
+        this->slots[this->find_slot(key, key_hash)] = {key_hash, i + 1};
+    }
+}
+
+/*
+  Inserting a key which is already present will replace the node, as
+  assigning to a std::map would.
+*/
+void smspec_key_index::insert(const char *key, const smspec_node *node) {
+    if (2 * (this->entry_list.size() + 1) > this->slots.size())
+        this->rehash(std::max(2 * this->slots.size(),
+                              size_t(SMSPEC_KEY_INDEX_MIN_SLOTS)));
+
+    uint64_t key_hash = hash(key);
+    slot_type &slot = this->slots[this->find_slot(key, key_hash)];
+    if (slot.entry > 0)
+        this->entry_list[slot.entry - 1].second = node;
+    else {
+        this->entry_list.emplace_back(key, node);
+        slot = {key_hash, this->entry_list.size()};
+
+        if (!this->key_separator.empty()) {
+            const char *sep = strstr(key, this->key_separator.c_str());
+            if (sep)
+                this->prefix_index[std::string(key, sep - key)].push_back(
+                    this->entry_list.size() - 1);
+        }
+    }
+}
+
+const smspec_key_index::entry_type *
+smspec_key_index::find_entry(const char *key, uint64_t key_hash) const {
+    if (this->slots.empty())
+        return nullptr;
+
+    const slot_type &slot = this->slots[this->find_slot(key, key_hash)];
+    if (slot.entry == 0)
+        return nullptr;
+
+    return &this->entry_list[slot.entry - 1];
+}
+
+const smspec_node *smspec_key_index::find(const char *key,
+                                          uint64_t key_hash) const {
+    const entry_type *entry = this->find_entry(key, key_hash);
+    if (!entry)
+        return nullptr;
+
+    return entry->second;
+}
+
+const std::vector<size_t> *
+smspec_key_index::prefix_entries(const std::string &prefix) const {
+    const auto iter = this->prefix_index.find(prefix);
+    if (iter == this->prefix_index.end())
+        return nullptr;
+
+    return &iter->second;
+}
+
+} // namespace ecl
@@ -0,0 +1,127 @@
+#include <ert/util/util.h>
+
+#include "detail/ecl/smspec_key_matcher.hpp"
+
+namespace ecl {
+
+static bool has_wildcard(const std::string &pattern) {
+    return pattern.find_first_of("*?[\\") != std::string::npos;
+}
+
+smspec_key_matcher::smspec_key_matcher(const std::vector<std::string> &patterns,
+                                       const std::string &separator)
+    : separator(separator) {
+    for (const auto &pattern : patterns) {
+        pattern_type p;
+        p.pattern = pattern;
+        p.hash = 0;
+
+        if (pattern == "*")
+            p.kind = MATCH_ALL;
+        else if (!has_wildcard(pattern)) {
+            p.kind = MATCH_LITERAL;
+            p.hash = smspec_key_index::hash(pattern.c_str());
+        } else {
+            p.kind = MATCH_FNMATCH;
+            if (!separator.empty()) {
+                size_t sep_pos = pattern.find(separator);
+                if (sep_pos != std::string::npos) {
+                    std::string prefix = pattern.substr(0, sep_pos);
+                    if (!has_wildcard(prefix)) {
+                        p.prefix = prefix;
+                        if (pattern.compare(sep_pos + separator.size(),
+                                            std::string::npos, "*") == 0)
+                            p.kind = MATCH_PREFIX;
+                        else
+                            p.kind = MATCH_PREFIX_FNMATCH;
+                    }
+                }
+            }
+        }
+        this->pattern_list.push_back(p);
+    }
+}
+
+std::vector<size_t>
+smspec_key_matcher::select(const smspec_key_index &index) const {
+    const auto &entries = index.entries();
+    const bool use_prefix = (index.separator() == this->separator);
+    std::vector<char> selected(entries.size(), 0);
+    std::vector<size_t> matches;
+    std::vector<const char *> scan_patterns;
+    bool match_all = false;
+
+    auto add_match = [&](size_t entry) {
+        if (!selected[entry]) {
+            selected[entry] = 1;
+            matches.push_back(entry);
+        }
+    };
+
+    for (const auto &p : this->pattern_list) {
+        switch (p.kind) {
+        case MATCH_ALL:
+            match_all = true;
+            break;
+        case MATCH_LITERAL: {
+            const auto *entry = index.find_entry(p.pattern.c_str(), p.hash);
+            if (entry)
+                add_match(entry - entries.data());
+            break;
+        }
+        case MATCH_PREFIX:
+        case MATCH_PREFIX_FNMATCH:
+            if (use_prefix) {
+                const std::vector<size_t> *bucket =
+                    index.prefix_entries(p.prefix);
+                if (!bucket)
+                    break;
+
+                for (size_t entry : *bucket) {
+                    if (selected[entry])
+                        continue;
+
+                    if (p.kind == MATCH_PREFIX ||
+                        util_fnmatch(p.pattern.c_str(),
+                                     entries[entry].first.c_str()) == 0)
+                        add_match(entry);
+                }
+            } else
+                scan_patterns.push_back(p.pattern.c_str());
+            break;
+        case MATCH_FNMATCH:
+            scan_patterns.push_back(p.pattern.c_str());
+            break;
+        }
+    }
+
+    /*
+      The TIME is typically special cased by output and will not
+      match the 'all keys' wildcard.
+    */
+    if (match_all) {
+        for (size_t entry = 0; entry < entries.size(); entry++) {
+            if (entries[entry].first != "TIME")
+                add_match(entry);
+        }
+    }
+
+    if (!scan_patterns.empty()) {
+        for (size_t entry = 0; entry < entries.size(); entry++) {
+            if (selected[entry])
+                continue;
+
+            const char *key = entries[entry].first.c_str();
+            for (const char *pattern : scan_patterns) {
+                if (util_fnmatch(pattern, key) == 0) {
+                    add_match(entry);
+                    break;
+                }
+            }
+        }
+    }
+
+    return matches;
+}
+
+} // namespace ecl
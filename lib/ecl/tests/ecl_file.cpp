@@ -20,6 +20,8 @@
 #include <stdbool.h>
 #include <unistd.h>
 
+#include <vector>
+
 #include <ert/util/test_util.hpp>
 #include <ert/util/util.h>
 #include <ert/util/test_work_area.hpp>
@@ -116,10 +118,304 @@ void test_mixed_case() {
     }
 }
 
+void test_mmap(int flags) {
+    ecl::util::TestArea ta("file_mmap");
+    const char *data_file_name = "TEST.INIT";
+    const int data_size = 2503;
+    std::vector<ecl_kw_type *> kw_list;
+
+    {
+        ecl_kw_type *int_kw = ecl_kw_alloc("INT", data_size, ECL_INT);
+        ecl_kw_type *float_kw = ecl_kw_alloc("FLOAT", data_size, ECL_FLOAT);
+        ecl_kw_type *double_kw = ecl_kw_alloc("DOUBLE", data_size, ECL_DOUBLE);
+        ecl_kw_type *bool_kw = ecl_kw_alloc("BOOL", data_size, ECL_BOOL);
+        ecl_kw_type *char_kw = ecl_kw_alloc("CHAR", 211, ECL_CHAR);
+
+        for (int i = 0; i < data_size; i++) {
+            ecl_kw_iset_int(int_kw, i, i * 37);
+            ecl_kw_iset_float(float_kw, i, i * 0.25);
+            ecl_kw_iset_double(double_kw, i, i * 1.0 / 3);
+            ecl_kw_iset_bool(bool_kw, i, (i % 3) == 0);
+        }
+        for (int i = 0; i < ecl_kw_get_size(char_kw); i++)
+            ecl_kw_iset_char_ptr(char_kw, i, (i % 2) ? "ABC" : "DEFGHIJK");
+
+        kw_list = {int_kw, float_kw, double_kw, bool_kw, char_kw};
+    }
+
+    {
+        fortio_type *fortio = fortio_open_writer(data_file_name, false, true);
+        for (const auto *kw : kw_list)
+            ecl_kw_fwrite(kw, fortio);
+        fortio_fclose(fortio);
+    }
+
+    {
+        ecl_file_type *ecl_file = ecl_file_open(data_file_name, flags);
+        test_assert_int_equal(ecl_file_get_size(ecl_file), kw_list.size());
+        for (size_t i = 0; i < kw_list.size(); i++)
+            test_assert_true(
+                ecl_kw_equal(kw_list[i], ecl_file_iget_kw(ecl_file, i)));
+        ecl_file_close(ecl_file);
+    }
+
+    for (auto *kw : kw_list)
+        ecl_kw_free(kw);
+}
+
+void test_load_kw_list(bool fmt_file, int flags) {
+    ecl::util::TestArea ta("file_load_kw_list");
+    const char *data_file_name = fmt_file ? "TEST.FUNRST" : "TEST.UNRST";
+    std::vector<ecl_kw_type *> kw_list;
+
+    for (int step = 0; step < 2; step++) {
+        ecl_kw_type *pressure = ecl_kw_alloc("PRESSURE", 1733, ECL_DOUBLE);
+        ecl_kw_type *swat = ecl_kw_alloc("SWAT", 1733, ECL_FLOAT);
+        ecl_kw_type *iwel = ecl_kw_alloc("IWEL", 55, ECL_INT);
+        for (int i = 0; i < 1733; i++) {
+            ecl_kw_iset_double(pressure, i, 100 + step + i * 0.5);
+            ecl_kw_iset_float(swat, i, i * 0.001 + step);
+        }
+        for (int i = 0; i < 55; i++)
+            ecl_kw_iset_int(iwel, i, i * (step + 1));
+
+        kw_list.push_back(pressure);
+        kw_list.push_back(swat);
+        kw_list.push_back(iwel);
+    }
+
+    {
+        fortio_type *fortio =
+            fortio_open_writer(data_file_name, fmt_file, ECL_ENDIAN_FLIP);
+        for (const auto *kw : kw_list)
+            ecl_kw_fwrite(kw, fortio);
+        fortio_fclose(fortio);
+    }
+
+    {
+        const char *load_kw[] = {"SWAT", "PRESSURE", "IWEL", "PRESSURE"};
+        const int load_occurence[] = {1, 1, 1, 0};
+        const int expected_index[] = {4, 3, 5, 0};
+        ecl_file_type *ecl_file = ecl_file_open(data_file_name, flags);
+
+        test_assert_true(
+            ecl_file_load_kw_list(ecl_file, 4, load_kw, load_occurence));
+        ecl_file_fortio_detach(ecl_file);
+
+        for (int i = 0; i < 4; i++)
+            test_assert_true(ecl_kw_numeric_equal(
+                kw_list[expected_index[i]],
+                ecl_file_iget_named_kw(ecl_file, load_kw[i],
+                                       load_occurence[i]),
+                0, 1e-12));
+        ecl_file_close(ecl_file);
+    }
+
+    {
+        ecl_file_type *ecl_file = ecl_file_open(data_file_name, flags);
+        test_assert_true(ecl_file_load_all(ecl_file));
+        ecl_file_fortio_detach(ecl_file);
+        for (size_t i = 0; i < kw_list.size(); i++)
+            test_assert_true(ecl_kw_numeric_equal(
+                kw_list[i], ecl_file_iget_kw(ecl_file, i), 0, 1e-12));
+        ecl_file_close(ecl_file);
+    }
+
+    for (auto *kw : kw_list)
+        ecl_kw_free(kw);
+}
+
+static void write_int_kw(fortio_type *fortio, const char *header, int size) {
+    ecl_kw_type *kw = ecl_kw_alloc(header, size, ECL_INT);
+    for (int i = 0; i < size; i++)
+        ecl_kw_iset_int(kw, i, i);
+    ecl_kw_fwrite(kw, fortio);
+    ecl_kw_free(kw);
+}
+
+void test_index_cache() {
+    ecl::util::TestArea ta("file_index_cache");
+    const char *data_file_name = "TEST.UNRST";
+    const char *cache_file_name = ".TEST.UNRST.index";
+
+    {
+        fortio_type *fortio = fortio_open_writer(data_file_name, false, true);
+        write_int_kw(fortio, "SEQNUM", 1);
+        write_int_kw(fortio, "PRESSURE", 100);
+        write_int_kw(fortio, "SWAT", 100);
+        fortio_fclose(fortio);
+    }
+
+    for (int i = 0; i < 2; i++) {
+        ecl_file_type *ecl_file =
+            ecl_file_open(data_file_name, ECL_FILE_INDEX_CACHE);
+        test_assert_true(util_file_exists(cache_file_name));
+        test_assert_int_equal(ecl_file_get_size(ecl_file), 3);
+        test_assert_int_equal(
+            ecl_kw_iget_int(ecl_file_iget_named_kw(ecl_file, "SWAT", 0), 99),
+            99);
+        ecl_file_close(ecl_file);
+    }
+
+    // The file has grown - the new keywords should be picked up.
+    {
+        fortio_type *fortio = fortio_open_append(data_file_name, false, true);
+        write_int_kw(fortio, "SEQNUM", 1);
+        write_int_kw(fortio, "PRESSURE", 100);
+        fortio_fclose(fortio);
+
+        ecl_file_type *ecl_file =
+            ecl_file_open(data_file_name, ECL_FILE_INDEX_CACHE);
+        test_assert_int_equal(ecl_file_get_size(ecl_file), 5);
+        test_assert_int_equal(
+            ecl_file_get_num_named_kw(ecl_file, "PRESSURE"), 2);
+        ecl_file_close(ecl_file);
+
+        ecl_file = ecl_file_open(data_file_name, ECL_FILE_INDEX_CACHE);
+        test_assert_int_equal(ecl_file_get_size(ecl_file), 5);
+        ecl_file_close(ecl_file);
+    }
+
+    // The file has been rewritten and is smaller - the cache is discarded.
+    {
+        fortio_type *fortio = fortio_open_writer(data_file_name, false, true);
+        write_int_kw(fortio, "SWAT", 10);
+        fortio_fclose(fortio);
+
+        ecl_file_type *ecl_file =
+            ecl_file_open(data_file_name, ECL_FILE_INDEX_CACHE);
+        test_assert_int_equal(ecl_file_get_size(ecl_file), 1);
+        test_assert_int_equal(
+            ecl_kw_get_size(ecl_file_iget_named_kw(ecl_file, "SWAT", 0)), 10);
+        ecl_file_close(ecl_file);
+    }
+
+    // A corrupt cache file is ignored.
+    {
+        FILE *stream = util_fopen(cache_file_name, "w");
+        fprintf(stream, "garbage");
+        fclose(stream);
+
+        ecl_file_type *ecl_file =
+            ecl_file_open(data_file_name, ECL_FILE_INDEX_CACHE);
+        test_assert_int_equal(ecl_file_get_size(ecl_file), 1);
+        ecl_file_close(ecl_file);
+    }
+
+    // A cache file with a valid header and a corrupt body is ignored.
+    {
+        const long num_kw_offset = sizeof(int) + sizeof(size_t) +
+                                   sizeof(time_t) + sizeof(offset_type);
+        const long type_offset = num_kw_offset + sizeof(int) +
+                                 ECL_STRING8_LENGTH + sizeof(int) +
+                                 sizeof(offset_type);
+        const long type_size_offset = type_offset + sizeof(int);
+
+        for (long offset : {num_kw_offset, type_offset, type_size_offset}) {
+            FILE *stream = util_fopen(cache_file_name, "r+b");
+            util_fseek(stream, offset, SEEK_SET);
+            util_fwrite_int(1 << 30, stream);
+            fclose(stream);
+
+            ecl_file_type *ecl_file =
+                ecl_file_open(data_file_name, ECL_FILE_INDEX_CACHE);
+            test_assert_int_equal(ecl_file_get_size(ecl_file), 1);
+            test_assert_int_equal(
+                ecl_kw_get_size(ecl_file_iget_named_kw(ecl_file, "SWAT", 0)),
+                10);
+            ecl_file_close(ecl_file);
+        }
+    }
+}
+
+/*
+  Appends the first num_bytes of the keyword to the file, to emulate a
+  keyword which is in the process of being written.
+*/
+static void append_partial_kw(const char *filename, const char *header,
+                              int size, int num_bytes) {
+    const char *tmp_file = "PARTIAL.KW";
+    fortio_type *fortio = fortio_open_writer(tmp_file, false, true);
+    write_int_kw(fortio, header, size);
+    fortio_fclose(fortio);
+
+    std::vector<char> buffer(num_bytes);
+    FILE *src = util_fopen(tmp_file, "r");
+    test_assert_size_t_equal(fread(buffer.data(), 1, num_bytes, src),
+                             num_bytes);
+    fclose(src);
+
+    FILE *target = util_fopen(filename, "a");
+    fwrite(buffer.data(), 1, num_bytes, target);
+    fclose(target);
+}
+
+void test_refresh(int flags) {
+    ecl::util::TestArea ta("file_refresh");
+    const char *data_file_name = "TEST.UNRST";
+
+    {
+        fortio_type *fortio = fortio_open_writer(data_file_name, false, true);
+        write_int_kw(fortio, "SEQNUM", 1);
+        write_int_kw(fortio, "PRESSURE", 100);
+        fortio_fclose(fortio);
+    }
+
+    ecl_file_type *ecl_file = ecl_file_open(data_file_name, flags);
+    test_assert_int_equal(ecl_file_get_size(ecl_file), 2);
+    test_assert_int_equal(ecl_file_refresh(ecl_file), 0);
+
+    {
+        fortio_type *fortio = fortio_open_append(data_file_name, false, true);
+        write_int_kw(fortio, "SEQNUM", 1);
+        write_int_kw(fortio, "PRESSURE", 100);
+        fortio_fclose(fortio);
+    }
+    append_partial_kw(data_file_name, "SWAT", 100, 50);
+
+    test_assert_int_equal(ecl_file_refresh(ecl_file), 2);
+    test_assert_int_equal(ecl_file_get_size(ecl_file), 4);
+    test_assert_int_equal(ecl_file_get_num_named_kw(ecl_file, "PRESSURE"), 2);
+    test_assert_int_equal(
+        ecl_kw_iget_int(ecl_file_iget_named_kw(ecl_file, "PRESSURE", 1), 99),
+        99);
+    test_assert_false(ecl_file_has_kw(ecl_file, "SWAT"));
+
+    // Complete the partially written keyword.
+    {
+        std::vector<char> buffer(util_file_size("PARTIAL.KW") - 50);
+        FILE *src = util_fopen("PARTIAL.KW", "r");
+        fseek(src, 50, SEEK_SET);
+        test_assert_size_t_equal(fread(buffer.data(), 1, buffer.size(), src),
+                                 buffer.size());
+        fclose(src);
+
+        FILE *target = util_fopen(data_file_name, "a");
+        fwrite(buffer.data(), 1, buffer.size(), target);
+        fclose(target);
+    }
+
+    test_assert_int_equal(ecl_file_refresh(ecl_file), 1);
+    test_assert_int_equal(ecl_file_get_size(ecl_file), 5);
+    test_assert_int_equal(
+        ecl_kw_iget_int(ecl_file_iget_named_kw(ecl_file, "SWAT", 0), 77), 77);
+    test_assert_int_equal(ecl_file_refresh(ecl_file), 0);
+    ecl_file_close(ecl_file);
+}
+
 int main(int argc, char **argv) {
     test_writable(10);
     test_writable(1337);
     test_truncated();
     test_mixed_case();
+    test_mmap(ECL_FILE_MMAP);
+    test_mmap(ECL_FILE_MMAP | ECL_FILE_CLOSE_STREAM);
+    test_load_kw_list(false, 0);
+    test_load_kw_list(false, ECL_FILE_MMAP);
+    test_load_kw_list(true, 0);
+    test_index_cache();
+    test_refresh(0);
+    test_refresh(ECL_FILE_MMAP);
+    test_refresh(ECL_FILE_CLOSE_STREAM);
     exit(0);
 }
@@ -121,8 +121,89 @@ void test_kw_io_charlength() {
     }
 }
 
+void test_fread_formatted() {
+    ecl::util::TestArea ta("fread_formatted");
+    ecl_kw_type *float_kw = ecl_kw_alloc("FLOAT", 5, ECL_FLOAT);
+    ecl_kw_type *double_kw = ecl_kw_alloc("DOUBLE", 4, ECL_DOUBLE);
+    ecl_kw_type *int_kw = ecl_kw_alloc("INT", 7, ECL_INT);
+    ecl_kw_type *bool_kw = ecl_kw_alloc("BOOL", 3, ECL_BOOL);
+    ecl_kw_type *char_kw = ecl_kw_alloc("CHAR", 2, ECL_CHAR);
+    ecl_kw_type *string_kw = ecl_kw_alloc("STRING", 2, ECL_STRING(10));
+
+    const float float_values[] = {0, 1.5, -0.0625, 1e-20, 123456.78};
+    const double double_values[] = {0, -1.0, 0.1, 2.5e100};
+    const int int_values[] = {0, 1, -1, 2147483647, -2147483647 - 1, 100, 7};
+    for (int i = 0; i < 5; i++)
+        ecl_kw_iset_float(float_kw, i, float_values[i]);
+    for (int i = 0; i < 4; i++)
+        ecl_kw_iset_double(double_kw, i, double_values[i]);
+    for (int i = 0; i < 7; i++)
+        ecl_kw_iset_int(int_kw, i, int_values[i]);
+    for (int i = 0; i < 3; i++)
+        ecl_kw_iset_bool(bool_kw, i, i != 1);
+    ecl_kw_iset_string8(char_kw, 0, "ABC");
+    ecl_kw_iset_string8(char_kw, 1, "ABCDEFGH");
+    ecl_kw_iset_string_ptr(string_kw, 0, "A B");
+    ecl_kw_iset_string_ptr(string_kw, 1, "ABCDEFGHIJ");
+
+    ecl_kw_type *kw_list[] = {float_kw, double_kw, int_kw,
+                              bool_kw,  char_kw,   string_kw};
+    {
+        fortio_type *fortio = fortio_open_writer("FMT", true, true);
+        for (ecl_kw_type *kw : kw_list)
+            test_assert_true(ecl_kw_fwrite(kw, fortio));
+        fortio_fclose(fortio);
+    }
+
+    {
+        char *content = util_fread_alloc_file_content("FMT", NULL);
+        test_assert_string_equal(
+            content,
+            " 'FLOAT   '           5 'REAL'\n"
+            "   0.00000000E+00   0.15000000E+01  -0.62500000E-01   "
+            "0.99999997E-20\n"
+            "   0.12345678E+06\n"
+            " 'DOUBLE  '           4 'DOUB'\n"
+            "   0.00000000000000D+00  -0.10000000000000D+01   "
+            "0.10000000000000D+00\n"
+            "   0.25000000000000D+101\n"
+            " 'INT     '           7 'INTE'\n"
+            "           0           1          -1  2147483647 -2147483648"
+            "         100\n"
+            "           7\n"
+            " 'BOOL    '           3 'LOGI'\n"
+            "  T  F  T\n"
+            " 'CHAR    '           2 'CHAR'\n"
+            " 'ABC     ' 'ABCDEFGH'\n"
+            " 'STRING  '           2 'C010'\n"
+            " 'A B       ' 'ABCDEFGHIJ'\n");
+        free(content);
+    }
+
+    {
+        fortio_type *fortio = fortio_open_reader("FMT", true, true);
+        for (ecl_kw_type *kw : kw_list) {
+            ecl_kw_type *kw2 = ecl_kw_fread_alloc(fortio);
+            test_assert_true(ecl_kw_is_instance(kw2));
+            test_assert_true(ecl_kw_header_eq(kw, kw2));
+            if (ecl_type_is_float(ecl_kw_get_data_type(kw)) ||
+                ecl_type_is_double(ecl_kw_get_data_type(kw)))
+                test_assert_true(ecl_kw_numeric_equal(kw, kw2, 0, 1e-7));
+            else
+                test_assert_true(ecl_kw_equal(kw, kw2));
+            ecl_kw_free(kw2);
+        }
+        test_assert_NULL(ecl_kw_fread_alloc(fortio));
+        fortio_fclose(fortio);
+    }
+
+    for (ecl_kw_type *kw : kw_list)
+        ecl_kw_free(kw);
+}
+
 int main(int argc, char **argv) {
     test_fread_alloc();
+    test_fread_formatted();
     test_kw_io_charlength();
     exit(0);
 }
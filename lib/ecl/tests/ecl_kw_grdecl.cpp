@@ -24,6 +24,40 @@
 
 #include <ert/ecl/ecl_kw.hpp>
 
+void test_grdecl_syntax() {
+    ecl::util::TestArea ta("kw_grdecl_syntax");
+    FILE *stream = util_fopen("SYNTAX.grdecl", "w");
+    fprintf(stream, "PORO\n");
+    fprintf(stream, "-- 1 2 3 commented out\n");
+    fprintf(stream, "  3*0.25 0.5 -- trailing comment\n");
+    fprintf(stream, " +1.5e-1\t2*7 /\n");
+    fprintf(stream, "FIPNUM\n 2*1 -3 +4 /\n");
+    fclose(stream);
+
+    stream = util_fopen("SYNTAX.grdecl", "r");
+    {
+        const float poro[] = {0.25, 0.25, 0.25, 0.5, 0.15, 7, 7};
+        ecl_kw_type *poro_kw =
+            ecl_kw_fscanf_alloc_grdecl(stream, "PORO", 7, ECL_FLOAT);
+        test_assert_not_NULL(poro_kw);
+        for (int i = 0; i < 7; i++)
+            test_assert_float_equal(ecl_kw_iget_float(poro_kw, i), poro[i]);
+        ecl_kw_free(poro_kw);
+    }
+    {
+        const int fipnum[] = {1, 1, -3, 4};
+        ecl_kw_type *fipnum_kw =
+            ecl_kw_fscanf_alloc_current_grdecl(stream, ECL_INT);
+        test_assert_not_NULL(fipnum_kw);
+        test_assert_string_equal(ecl_kw_get_header(fipnum_kw), "FIPNUM");
+        test_assert_int_equal(ecl_kw_get_size(fipnum_kw), 4);
+        for (int i = 0; i < 4; i++)
+            test_assert_int_equal(ecl_kw_iget_int(fipnum_kw, i), fipnum[i]);
+        ecl_kw_free(fipnum_kw);
+    }
+    fclose(stream);
+}
+
 int main(int argc, char **argv) {
     int i;
     ecl_kw_type *ecl_kw = ecl_kw_alloc("HEAD", 10, ECL_INT);
@@ -70,6 +104,7 @@ int main(int argc, char **argv) {
         fclose(stream);
     }
     ecl_kw_free(ecl_kw);
+    test_grdecl_syntax();
 
     exit(0);
 }
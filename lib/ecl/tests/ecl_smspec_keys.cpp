@@ -0,0 +1,124 @@
+#include <stdlib.h>
+
+#include <ert/util/test_util.hpp>
+#include <ert/util/test_work_area.hpp>
+#include <ert/util/stringlist.hpp>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_smspec.hpp>
+#include <ert/ecl/ecl_sum.hpp>
+
+void test_key_lookup() {
+    ecl::util::TestArea ta("key_lookup");
+    time_t start_time = util_make_date_utc(1, 1, 2010);
+    const int num_wells = 500;
+    {
+        ecl_sum_type *ecl_sum = ecl_sum_alloc_writer(
+            "CASE", false, true, ":", start_time, true, 10, 11, 12);
+        ecl_smspec_type *smspec = ecl_sum_get_smspec(ecl_sum);
+        for (int i = 0; i < num_wells; i++) {
+            char *well = util_alloc_sprintf("OP_%d", i);
+            ecl_smspec_add_node(smspec, "WOPR", well, "SM3/DAY", 0.0);
+            free(well);
+        }
+        ecl_smspec_add_node(smspec, "BPR", 567, "BARS", 0.0);
+
+        ecl_sum_tstep_type *tstep = ecl_sum_add_tstep(ecl_sum, 1, 0);
+        for (int i = 0; i < ecl_smspec_get_params_size(smspec); i++)
+            ecl_sum_tstep_iset(tstep, i, i);
+        ecl_sum_fwrite(ecl_sum);
+        ecl_sum_free(ecl_sum);
+    }
+
+    ecl_sum_type *ecl_sum = ecl_sum_fread_alloc_case("CASE", ":");
+    stringlist_type *keys = ecl_sum_alloc_matching_general_var_list(ecl_sum,
+                                                                    NULL);
+    test_assert_int_equal(stringlist_get_size(keys), num_wells + 2);
+    for (int i = 0; i < stringlist_get_size(keys); i++) {
+        const char *gen_key = stringlist_iget(keys, i);
+        ecl_smspec_key_type *key = ecl_smspec_key_alloc(gen_key);
+        test_assert_string_equal(ecl_smspec_key_get_key(key), gen_key);
+        test_assert_ptr_equal(ecl_sum_get_key_node(ecl_sum, key),
+                              ecl_sum_get_general_var_node(ecl_sum, gen_key));
+        test_assert_int_equal(
+            ecl_sum_get_key_params_index(ecl_sum, key),
+            ecl_sum_get_general_var_params_index(ecl_sum, gen_key));
+        ecl_smspec_key_free(key);
+    }
+
+    ecl_smspec_key_type *missing = ecl_smspec_key_alloc("WOPR:NO_WELL");
+    test_assert_NULL(ecl_sum_get_key_node(ecl_sum, missing));
+    test_assert_int_equal(ecl_sum_get_key_params_index(ecl_sum, missing), -1);
+    ecl_smspec_key_free(missing);
+
+    stringlist_free(keys);
+    ecl_sum_free(ecl_sum);
+}
+
+static void test_matcher_patterns(const ecl_sum_type *ecl_sum,
+                                  const char **patterns, int num_patterns,
+                                  const char *join_string) {
+    stringlist_type *pattern_list = stringlist_alloc_new();
+    stringlist_type *expected = stringlist_alloc_new();
+    for (int i = 0; i < num_patterns; i++) {
+        stringlist_append_copy(pattern_list, patterns[i]);
+        ecl_sum_select_matching_general_var_list(ecl_sum, patterns[i],
+                                                 expected);
+    }
+
+    ecl_smspec_matcher_type *matcher =
+        ecl_smspec_matcher_alloc(pattern_list, join_string);
+    stringlist_type *keys = stringlist_alloc_new();
+    ecl_sum_select_matching_keys(ecl_sum, matcher, keys);
+    test_assert_true(stringlist_equal(keys, expected));
+
+    ecl_smspec_matcher_free(matcher);
+    stringlist_free(keys);
+    stringlist_free(expected);
+    stringlist_free(pattern_list);
+}
+
+void test_key_matcher() {
+    time_t start_time = util_make_date_utc(1, 1, 2010);
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer("CASE", false, true, ":",
+                                                 start_time, true, 10, 11, 12);
+    ecl_smspec_type *smspec = ecl_sum_get_smspec(ecl_sum);
+    for (int i = 0; i < 100; i++) {
+        char *well = util_alloc_sprintf("OP_%d", i);
+        ecl_smspec_add_node(smspec, "WOPR", well, "SM3/DAY", 0.0);
+        ecl_smspec_add_node(smspec, "WWPR", well, "SM3/DAY", 0.0);
+        free(well);
+    }
+    ecl_smspec_add_node(smspec, "BPR", 567, "BARS", 0.0);
+    ecl_smspec_add_node(smspec, "FOPT", "SM3", 0.0);
+
+    {
+        stringlist_type *keys = stringlist_alloc_new();
+        ecl_sum_select_matching_general_var_list(ecl_sum, "WOPR:*", keys);
+        test_assert_int_equal(stringlist_get_size(keys), 100);
+        ecl_sum_select_matching_general_var_list(ecl_sum, "WOPR:OP_1*", keys);
+        test_assert_int_equal(stringlist_get_size(keys), 100);
+        ecl_sum_select_matching_general_var_list(ecl_sum, "BPR:*", keys);
+        test_assert_int_equal(stringlist_get_size(keys), 102);
+        test_assert_string_equal(stringlist_iget(keys, 0), "BPR:7,2,6");
+        stringlist_free(keys);
+    }
+
+    const char *patterns[] = {"WOPR:*", "WOPR:OP_1*", "WWPR:OP_?", "BPR:*",
+                              "FOPT",   "NO_SUCH",    "W*:OP_9*",  "[WB]*PR:5*",
+                              "WOPR:OP_42"};
+    test_matcher_patterns(ecl_sum, patterns, 9, ":");
+    test_matcher_patterns(ecl_sum, patterns, 9, "_");
+
+    const char *all_patterns[] = {"*", "TIME", "FOPT"};
+    test_matcher_patterns(ecl_sum, all_patterns, 1, ":");
+    test_matcher_patterns(ecl_sum, all_patterns, 3, ":");
+
+    ecl_sum_free(ecl_sum);
+}
+
+int main(int argc, char **argv) {
+    test_key_lookup();
+    test_key_matcher();
+    exit(0);
+}
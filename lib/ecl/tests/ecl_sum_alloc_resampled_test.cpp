@@ -1,9 +1,12 @@
 
+#include <vector>
+
 #include <ert/util/test_util.hpp>
 
 #include <ert/ecl/ecl_sum.hpp>
 #include <ert/ecl/smspec_node.hpp>
 #include <ert/ecl/ecl_sum_tstep.hpp>
+#include <ert/ecl/ecl_sum_vector.hpp>
 
 ecl_sum_type *test_alloc_ecl_sum() {
     time_t start_time = util_make_date_utc(1, 1, 2010);
@@ -133,9 +136,62 @@ void test_not_sorted() {
     ecl_sum_free(ecl_sum);
 }
 
+/*
+  The frame interpolation must give the same values as the pointwise
+  lookup, also when the time points are not sorted and when they hit
+  the ministeps exactly.
+*/
+void test_frame_interp() {
+    ecl_sum_type *ecl_sum = test_alloc_ecl_sum();
+    time_t start_time = ecl_sum_get_data_start(ecl_sum);
+    time_t end_time = ecl_sum_get_end_time(ecl_sum);
+    ecl_sum_vector_type *keys = ecl_sum_vector_alloc(ecl_sum, true);
+    int num_keys = ecl_sum_vector_get_size(keys);
+
+    time_t_vector_type *t = time_t_vector_alloc(0, 0);
+    for (time_t sim_time = start_time - 86400; sim_time <= end_time + 86400;
+         sim_time += 3600 * 7)
+        time_t_vector_append(t, sim_time);
+    time_t_vector_append(t, start_time + 86400 * 6);
+    time_t_vector_append(t, start_time + 86400 * 3);
+    time_t_vector_append(t, start_time + 86400 * 4);
+    time_t_vector_append(t, end_time);
+    time_t_vector_append(t, start_time);
+
+    int num_points = time_t_vector_size(t);
+    std::vector<double> data(num_points * num_keys);
+    ecl_sum_init_double_frame_interp(ecl_sum, keys, t, data.data());
+
+    for (int i = 0; i < num_points; i++) {
+        time_t sim_time = time_t_vector_iget(t, i);
+        for (int k = 0; k < num_keys; k++) {
+            const char *key = ecl_sum_vector_iget_key(keys, k);
+            const ecl::smspec_node *node =
+                ecl_sum_get_general_var_node(ecl_sum, key);
+            double expected;
+            if (sim_time < start_time || sim_time > end_time) {
+                if (node->is_rate())
+                    expected = 0;
+                else if (sim_time < start_time)
+                    expected = ecl_sum_get_first_value_gen_key(ecl_sum, key);
+                else
+                    expected = ecl_sum_get_last_value_gen_key(ecl_sum, key);
+            } else
+                expected = ecl_sum_get_from_sim_time(ecl_sum, sim_time, node);
+
+            test_assert_double_equal(data[i * num_keys + k], expected);
+        }
+    }
+
+    time_t_vector_free(t);
+    ecl_sum_vector_free(keys);
+    ecl_sum_free(ecl_sum);
+}
+
 int main() {
     test_correct_time_vector();
     test_resample_extrapolate_rate();
     test_not_sorted();
+    test_frame_interp();
     return 0;
 }
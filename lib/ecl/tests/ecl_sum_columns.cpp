@@ -0,0 +1,174 @@
+#include <stdlib.h>
+
+#include <ert/util/test_util.hpp>
+#include <ert/util/test_work_area.hpp>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_sum.hpp>
+#include <ert/ecl/ecl_sum_vector.hpp>
+#include <ert/ecl/ecl_sum_columns.hpp>
+
+#include "detail/ecl/ecl_sum_columns_format.hpp"
+
+#define NUM_STEPS 25
+
+static ecl_sum_type *alloc_case(time_t start_time) {
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer("CASE", false, true, ":",
+                                                 start_time, true, 10, 10, 10);
+    ecl_smspec_type *smspec = ecl_sum_get_smspec(ecl_sum);
+    const ecl::smspec_node *fopt =
+        ecl_smspec_add_node(smspec, "FOPT", "SM3", 0.0);
+    const ecl::smspec_node *wopr =
+        ecl_smspec_add_node(smspec, "WOPR", "OP-1", "SM3/DAY", 0.0);
+    const ecl::smspec_node *bpr =
+        ecl_smspec_add_node(smspec, "BPR", 567, "BARSA", 0.0);
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        ecl_sum_tstep_type *tstep =
+            ecl_sum_add_tstep(ecl_sum, step / 2 + 1, step * 43200.0);
+        ecl_sum_tstep_set_from_node(tstep, *fopt, step * 1.5);
+        ecl_sum_tstep_set_from_node(tstep, *wopr, 100 + (step % 3) * 0.125);
+        ecl_sum_tstep_set_from_node(tstep, *bpr, 250 - step / 3.0);
+    }
+    return ecl_sum;
+}
+
+static void test_columns(const ecl_sum_type *ecl_sum, const char *filename,
+                         int num_row_groups) {
+    ecl_sum_columns_type *columns = ecl_sum_columns_fread_alloc(filename);
+    test_assert_true(ecl_sum_columns_is_instance(columns));
+    test_assert_int_equal(ecl_sum_columns_get_length(columns), NUM_STEPS);
+    test_assert_int_equal(ecl_sum_columns_get_size(columns), 3);
+    test_assert_int_equal(ecl_sum_columns_get_num_row_groups(columns),
+                          num_row_groups);
+    test_assert_time_t_equal(ecl_sum_columns_get_start_time(columns),
+                             ecl_sum_get_start_time(ecl_sum));
+
+    const int64_t *sim_time = ecl_sum_columns_get_sim_time(columns);
+    const double *sim_days = ecl_sum_columns_get_sim_days(columns);
+    const int *report_step = ecl_sum_columns_get_report_step(columns);
+    for (int i = 0; i < NUM_STEPS; i++) {
+        test_assert_time_t_equal(sim_time[i],
+                                 ecl_sum_iget_sim_time(ecl_sum, i));
+        test_assert_double_equal(sim_days[i],
+                                 ecl_sum_iget_sim_days(ecl_sum, i));
+        test_assert_int_equal(report_step[i],
+                              ecl_sum_iget_report_step(ecl_sum, i));
+    }
+
+    test_assert_false(ecl_sum_columns_has_key(columns, "NO:SUCH:KEY"));
+    test_assert_int_equal(ecl_sum_columns_get_index(columns, "NO:SUCH:KEY"),
+                          -1);
+
+    int wopr = ecl_sum_columns_get_index(columns, "WOPR:OP-1");
+    test_assert_string_equal(ecl_sum_columns_iget_key(columns, wopr),
+                             "WOPR:OP-1");
+    test_assert_string_equal(ecl_sum_columns_iget_keyword(columns, wopr),
+                             "WOPR");
+    test_assert_string_equal(ecl_sum_columns_iget_wgname(columns, wopr),
+                             "OP-1");
+    test_assert_string_equal(ecl_sum_columns_iget_unit(columns, wopr),
+                             "SM3/DAY");
+    test_assert_int_equal(ecl_sum_columns_iget_var_type(columns, wopr),
+                          ECL_SMSPEC_WELL_VAR);
+    test_assert_true(ecl_sum_columns_iget_is_rate(columns, wopr));
+
+    int fopt = ecl_sum_columns_get_index(columns, "FOPT");
+    test_assert_NULL(ecl_sum_columns_iget_wgname(columns, fopt));
+    test_assert_true(ecl_sum_columns_iget_is_total(columns, fopt));
+    test_assert_false(ecl_sum_columns_iget_is_rate(columns, fopt));
+
+    int bpr = ecl_sum_columns_get_index(columns, "BPR:7,7,6");
+    test_assert_int_equal(ecl_sum_columns_iget_num(columns, bpr), 567);
+    test_assert_int_equal(ecl_sum_columns_iget_var_type(columns, bpr),
+                          ECL_SMSPEC_BLOCK_VAR);
+
+    for (int index = 0; index < ecl_sum_columns_get_size(columns); index++) {
+        const char *key = ecl_sum_columns_iget_key(columns, index);
+        const float *data = ecl_sum_columns_iget_data(columns, index);
+        for (int i = 0; i < NUM_STEPS; i++)
+            test_assert_double_equal(
+                data[i], ecl_sum_get_general_var(ecl_sum, i, key));
+    }
+    ecl_sum_columns_free(columns);
+}
+
+void test_export_columns() {
+    ecl::util::TestArea ta("sum_columns");
+    ecl_sum_type *ecl_sum = alloc_case(util_make_date_utc(1, 1, 2010));
+    ecl_sum_vector_type *keys = ecl_sum_vector_alloc(ecl_sum, true);
+
+    ecl_sum_export_columns(ecl_sum, "CASE.columns", keys, 0, false);
+    test_columns(ecl_sum, "CASE.columns", 1);
+
+    ecl_sum_export_columns(ecl_sum, "CASE.zcolumns", keys, 7, true);
+    test_columns(ecl_sum, "CASE.zcolumns", 4);
+
+    test_assert_NULL(ecl_sum_columns_fread_alloc("does/not/exist"));
+    {
+        FILE *stream = util_fopen("CASE.txt", "w");
+        for (int i = 0; i < 100; i++)
+            fprintf(stream, "Not a columnar summary file\n");
+        fclose(stream);
+        test_assert_NULL(ecl_sum_columns_fread_alloc("CASE.txt"));
+    }
+
+    ecl_sum_vector_free(keys);
+    ecl_sum_free(ecl_sum);
+}
+
+void test_time_column_types() {
+    namespace sc = ecl::sum_columns;
+    ecl::util::TestArea ta("sum_columns_types");
+    ecl_sum_type *ecl_sum = alloc_case(util_make_date_utc(1, 1, 2010));
+    ecl_sum_vector_type *keys = ecl_sum_vector_alloc(ecl_sum, true);
+
+    for (uint32_t column = 0; column < sc::NUM_TIME_COLUMNS; column++) {
+        ecl_sum_export_columns(ecl_sum, "CASE.columns", keys, 0, false);
+        {
+            /* TIME as int32 would make the accessor read past the chunk. */
+            uint32_t data_type =
+                (column == 0) ? sc::DATA_INT32 : sc::DATA_INT64;
+            FILE *stream = util_fopen("CASE.columns", "r+b");
+            fseek(stream,
+                  sizeof(sc::file_header) + column * sizeof(sc::column_header),
+                  SEEK_SET);
+            fwrite(&data_type, sizeof data_type, 1, stream);
+            fclose(stream);
+        }
+        test_assert_NULL(ecl_sum_columns_fread_alloc("CASE.columns"));
+    }
+
+    ecl_sum_vector_free(keys);
+    ecl_sum_free(ecl_sum);
+}
+
+void test_export_empty() {
+    ecl::util::TestArea ta("sum_columns_empty");
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer(
+        "EMPTY", false, true, ":", util_make_date_utc(1, 1, 2010), true, 10,
+        10, 10);
+    ecl_smspec_add_node(ecl_sum_get_smspec(ecl_sum), "FOPT", "SM3", 0.0);
+    ecl_sum_vector_type *keys = ecl_sum_vector_alloc(ecl_sum, true);
+
+    ecl_sum_export_columns(ecl_sum, "EMPTY.columns", keys, 0, false);
+    ecl_sum_columns_type *columns =
+        ecl_sum_columns_fread_alloc("EMPTY.columns");
+    test_assert_true(ecl_sum_columns_is_instance(columns));
+    test_assert_int_equal(ecl_sum_columns_get_length(columns), 0);
+    test_assert_int_equal(ecl_sum_columns_get_num_row_groups(columns), 0);
+    test_assert_NULL(ecl_sum_columns_get_sim_time(columns));
+    test_assert_NULL(ecl_sum_columns_iget_data(
+        columns, ecl_sum_columns_get_index(columns, "FOPT")));
+
+    ecl_sum_columns_free(columns);
+    ecl_sum_vector_free(keys);
+    ecl_sum_free(ecl_sum);
+}
+
+int main(int argc, char **argv) {
+    test_export_columns();
+    test_time_column_types();
+    test_export_empty();
+    exit(0);
+}
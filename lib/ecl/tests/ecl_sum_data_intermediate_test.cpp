@@ -210,6 +210,16 @@ void verify_CASE3(int length) {
     ecl_sum_vector_type *vector = ecl_sum_vector_alloc(sum, true);
     double frame[27]; //3 vectors X 9 data points pr. vector
     ecl_sum_init_double_frame(sum, vector, frame);
+    for (int key_index = 0; key_index < ecl_sum_vector_get_size(vector);
+         key_index++) {
+        double_vector_type *d = ecl_sum_alloc_data_vector(
+            sum, ecl_sum_vector_iget_param_index(vector, key_index), false);
+        for (int time_index = 0; time_index < 9; time_index++)
+            ieq(d, time_index,
+                frame[time_index * ecl_sum_vector_get_size(vector) +
+                      key_index]);
+        double_vector_free(d);
+    }
     ecl_sum_vector_free(vector);
 
     ecl_sum_free(sum);
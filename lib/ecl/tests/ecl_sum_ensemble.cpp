@@ -0,0 +1,111 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include <vector>
+
+#include <ert/util/test_util.hpp>
+#include <ert/util/test_work_area.hpp>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_sum.hpp>
+#include <ert/ecl/ecl_sum_ensemble.hpp>
+
+#define NUM_STEPS 10
+
+static void write_case(const char *name, time_t start_time, int member,
+                       bool extra_key) {
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer(name, false, true, ":",
+                                                 start_time, true, 10, 10, 10);
+    ecl_smspec_type *smspec = ecl_sum_get_smspec(ecl_sum);
+    const ecl::smspec_node *fopt =
+        ecl_smspec_add_node(smspec, "FOPT", "SM3", 0.0);
+    const ecl::smspec_node *wwct =
+        ecl_smspec_add_node(smspec, "WWCT", "OP-1", "", 0.0);
+    const ecl::smspec_node *fgpt = NULL;
+    if (extra_key)
+        fgpt = ecl_smspec_add_node(smspec, "FGPT", "SM3", 0.0);
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        double sim_seconds = step * 86400.0;
+        ecl_sum_tstep_type *tstep =
+            ecl_sum_add_tstep(ecl_sum, step + 1, sim_seconds);
+        ecl_sum_tstep_set_from_node(tstep, *fopt, member * 100.0 + step);
+        ecl_sum_tstep_set_from_node(tstep, *wwct, member + 0.01 * step);
+        if (fgpt)
+            ecl_sum_tstep_set_from_node(tstep, *fgpt, -step);
+    }
+    ecl_sum_fwrite(ecl_sum);
+    ecl_sum_free(ecl_sum);
+}
+
+void test_ensemble() {
+    ecl::util::TestArea ta("sum_ensemble");
+    time_t start_time = util_make_date_utc(1, 1, 2010);
+    stringlist_type *case_list = stringlist_alloc_new();
+    const int num_members = 6;
+
+    for (int member = 0; member < num_members; member++) {
+        char *name = util_alloc_sprintf("CASE%d", member);
+        write_case(name, start_time, member, member == num_members - 1);
+        stringlist_append_copy(case_list, name);
+        free(name);
+    }
+    stringlist_insert_copy(case_list, 2, "NO_SUCH_CASE");
+
+    ecl_sum_ensemble_type *ensemble =
+        ecl_sum_ensemble_fread_alloc(case_list, ":", 3);
+    test_assert_true(ecl_sum_ensemble_is_instance(ensemble));
+    test_assert_int_equal(ecl_sum_ensemble_get_size(ensemble), num_members);
+    test_assert_int_equal(ecl_sum_ensemble_get_num_smspec(ensemble), 2);
+    test_assert_string_equal(ecl_sum_ensemble_iget_case_name(ensemble, 2),
+                             "CASE2");
+
+    const ecl_sum_type *case0 = ecl_sum_ensemble_iget_case(ensemble, 0);
+    const ecl_sum_type *case1 = ecl_sum_ensemble_iget_case(ensemble, 1);
+    const ecl_sum_type *last =
+        ecl_sum_ensemble_iget_case(ensemble, num_members - 1);
+    test_assert_ptr_equal(ecl_sum_get_smspec(case0),
+                          ecl_sum_get_smspec(case1));
+    test_assert_ptr_not_equal(ecl_sum_get_smspec(case0),
+                              ecl_sum_get_smspec(last));
+
+    /* The members share one smspec, but each is its own case. */
+    test_assert_true(ecl_sum_same_case(case0, "CASE0"));
+    test_assert_true(ecl_sum_same_case(case1, "CASE1"));
+    test_assert_false(ecl_sum_same_case(case1, "CASE0"));
+    test_assert_false(ecl_sum_same_case(case0, "CASE1"));
+
+    stringlist_type *keys = stringlist_alloc_new();
+    stringlist_append_copy(keys, "WWCT:OP-1");
+    stringlist_append_copy(keys, "FOPT");
+    stringlist_append_copy(keys, "FGPT");
+    time_t_vector_type *time_points = time_t_vector_alloc(0, 0);
+    for (int step = 0; step < NUM_STEPS; step++)
+        time_t_vector_append(time_points, start_time + step * 86400);
+
+    const int num_keys = 3;
+    std::vector<double> data(num_members * NUM_STEPS * num_keys);
+    ecl_sum_ensemble_init_double_frame_interp(ensemble, keys, time_points,
+                                              data.data());
+    for (int member = 0; member < num_members; member++) {
+        for (int step = 0; step < NUM_STEPS; step++) {
+            const double *row = &data[(member * NUM_STEPS + step) * num_keys];
+            test_assert_double_equal(row[0], member + 0.01 * step);
+            test_assert_double_equal(row[1], member * 100.0 + step);
+            if (member == num_members - 1)
+                test_assert_double_equal(row[2], -step);
+            else
+                test_assert_true(isnan(row[2]));
+        }
+    }
+
+    time_t_vector_free(time_points);
+    stringlist_free(keys);
+    ecl_sum_ensemble_free(ensemble);
+    stringlist_free(case_list);
+}
+
+int main(int argc, char **argv) {
+    test_ensemble();
+    exit(0);
+}
@@ -0,0 +1,122 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include <vector>
+
+#include <ert/util/test_util.hpp>
+#include <ert/util/test_work_area.hpp>
+#include <ert/util/statistics.hpp>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_sum.hpp>
+#include <ert/ecl/ecl_sum_quantile.hpp>
+
+#define NUM_STEPS 10
+#define NUM_CASES 30
+
+static double fopt(int member, int step) {
+    return step * (1 + (member * 7) % NUM_CASES);
+}
+
+static ecl_sum_type *alloc_case(int member, time_t start_time) {
+    char *name = util_alloc_sprintf("CASE%d", member);
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer(name, false, true, ":",
+                                                 start_time, true, 10, 10, 10);
+    ecl_smspec_type *smspec = ecl_sum_get_smspec(ecl_sum);
+    const ecl::smspec_node *node1 =
+        ecl_smspec_add_node(smspec, "FOPT", "SM3", 0.0);
+    const ecl::smspec_node *node2 = NULL;
+    if (member % 2 == 0)
+        node2 = ecl_smspec_add_node(smspec, "WWCT", "OP-1", "", 0.0);
+
+    for (int step = 0; step < NUM_STEPS; step++) {
+        ecl_sum_tstep_type *tstep =
+            ecl_sum_add_tstep(ecl_sum, step + 1, step * 86400.0);
+        ecl_sum_tstep_set_from_node(tstep, *node1, fopt(member, step));
+        if (node2)
+            ecl_sum_tstep_set_from_node(tstep, *node2, member % 3);
+    }
+    free(name);
+    return ecl_sum;
+}
+
+void test_quantile() {
+    ecl::util::TestArea ta("sum_quantile");
+    time_t start_time = util_make_date_utc(1, 1, 2010);
+    stringlist_type *keys = stringlist_alloc_new();
+    stringlist_append_copy(keys, "FOPT");
+    stringlist_append_copy(keys, "WWCT:OP-1");
+    stringlist_append_copy(keys, "NO:SUCH:KEY");
+    time_t_vector_type *time_points = time_t_vector_alloc(0, 0);
+    for (int step = 0; step < NUM_STEPS; step++)
+        time_t_vector_append(time_points, start_time + step * 86400);
+
+    ecl_sum_quantile_type *exact =
+        ecl_sum_quantile_alloc(keys, time_points, 0);
+    ecl_sum_quantile_type *sketch =
+        ecl_sum_quantile_alloc(keys, time_points, 10);
+    test_assert_true(ecl_sum_quantile_is_instance(exact));
+    for (int member = 0; member < NUM_CASES; member++) {
+        ecl_sum_type *ecl_sum = alloc_case(member, start_time);
+        ecl_sum_quantile_add_case(exact, ecl_sum);
+        ecl_sum_quantile_add_case(sketch, ecl_sum);
+        ecl_sum_free(ecl_sum);
+    }
+
+    test_assert_int_equal(ecl_sum_quantile_get_size(exact), NUM_CASES);
+    test_assert_int_equal(ecl_sum_quantile_iget_count(exact, 0), NUM_CASES);
+    test_assert_int_equal(ecl_sum_quantile_iget_count(exact, 1),
+                          NUM_CASES / 2);
+    test_assert_int_equal(ecl_sum_quantile_iget_count(exact, 2), 0);
+    test_assert_true(ecl_sum_quantile_is_exact(exact));
+    test_assert_false(ecl_sum_quantile_is_exact(sketch));
+
+    double_vector_type *fopt_values = double_vector_alloc(0, 0);
+    double_vector_type *wwct_values = double_vector_alloc(0, 0);
+    for (int step = 0; step < NUM_STEPS; step++) {
+        double_vector_reset(fopt_values);
+        double_vector_reset(wwct_values);
+        for (int member = 0; member < NUM_CASES; member++) {
+            double_vector_append(fopt_values, fopt(member, step));
+            if (member % 2 == 0)
+                double_vector_append(wwct_values, member % 3);
+        }
+
+        for (double q : {0.1, 0.5, 0.9}) {
+            test_assert_double_equal(
+                ecl_sum_quantile_iget(exact, 0, step, q),
+                statistics_empirical_quantile(fopt_values, q));
+            test_assert_double_equal(
+                ecl_sum_quantile_iget(exact, 1, step, q),
+                statistics_empirical_quantile(wwct_values, q));
+            test_assert_true(isnan(ecl_sum_quantile_iget(exact, 2, step, q)));
+
+            double value = ecl_sum_quantile_iget(sketch, 0, step, q);
+            test_assert_true(value >= double_vector_get_min(fopt_values));
+            test_assert_true(value <= double_vector_get_max(fopt_values));
+        }
+    }
+
+    std::vector<double> frame(NUM_STEPS * 3);
+    ecl_sum_quantile_init_double_frame(exact, 0.9, frame.data());
+    for (int step = 0; step < NUM_STEPS; step++)
+        for (int k = 0; k < 3; k++) {
+            double value = ecl_sum_quantile_iget(exact, k, step, 0.9);
+            if (k == 2)
+                test_assert_true(isnan(frame[step * 3 + k]));
+            else
+                test_assert_double_equal(frame[step * 3 + k], value);
+        }
+
+    double_vector_free(fopt_values);
+    double_vector_free(wwct_values);
+    ecl_sum_quantile_free(exact);
+    ecl_sum_quantile_free(sketch);
+    time_t_vector_free(time_points);
+    stringlist_free(keys);
+}
+
+int main(int argc, char **argv) {
+    test_quantile();
+    exit(0);
+}
@@ -0,0 +1,137 @@
+/*
+   Copyright (C) 2023  Equinor ASA, Norway.
+
+   The file 'ecl_sum_refresh.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include <ert/util/test_util.hpp>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.hpp>
+
+#include <ert/ecl/ecl_sum.hpp>
+#include <ert/ecl/ecl_util.hpp>
+
+void write_summary(const char *name, time_t start_time, int num_dates,
+                   int num_ministep) {
+    ecl_sum_type *ecl_sum =
+        ecl_sum_alloc_writer(name, false, true, ":", start_time, true, 10, 10,
+                             10);
+    ecl_smspec_type *smspec = ecl_sum_get_smspec(ecl_sum);
+    const ecl::smspec_node *node1 =
+        ecl_smspec_add_node(smspec, "FOPT", "Barrels", 99.0);
+    const ecl::smspec_node *node2 =
+        ecl_smspec_add_node(smspec, "BPR", 567, "BARS", 0.0);
+    double sim_seconds = 0;
+
+    for (int report_step = 0; report_step < num_dates; report_step++) {
+        for (int step = 0; step < num_ministep; step++) {
+            ecl_sum_tstep_type *tstep =
+                ecl_sum_add_tstep(ecl_sum, report_step + 1, sim_seconds);
+            ecl_sum_tstep_set_from_node(tstep, *node1, sim_seconds);
+            ecl_sum_tstep_set_from_node(tstep, *node2, 10 * sim_seconds);
+            sim_seconds += 3600;
+        }
+    }
+    ecl_sum_fwrite(ecl_sum);
+    ecl_sum_free(ecl_sum);
+}
+
+static void copy_bytes(const char *src_file, const char *target_file,
+                       long offset, long size, const char *mode) {
+    std::vector<char> buffer(size);
+    FILE *src = util_fopen(src_file, "r");
+    fseek(src, offset, SEEK_SET);
+    test_assert_size_t_equal(fread(buffer.data(), 1, size, src), size);
+    fclose(src);
+
+    FILE *target = util_fopen(target_file, mode);
+    fwrite(buffer.data(), 1, size, target);
+    fclose(target);
+}
+
+static void assert_sum_equal(const ecl_sum_type *sum1,
+                             const ecl_sum_type *sum2) {
+    test_assert_int_equal(ecl_sum_get_data_length(sum1),
+                          ecl_sum_get_data_length(sum2));
+    test_assert_int_equal(ecl_sum_get_last_report_step(sum1),
+                          ecl_sum_get_last_report_step(sum2));
+    test_assert_time_t_equal(ecl_sum_get_end_time(sum1),
+                             ecl_sum_get_end_time(sum2));
+    for (int i = 0; i < ecl_sum_get_data_length(sum1); i++) {
+        test_assert_int_equal(ecl_sum_iget_report_step(sum1, i),
+                              ecl_sum_iget_report_step(sum2, i));
+        test_assert_double_equal(ecl_sum_get_general_var(sum1, i, "FOPT"),
+                                 ecl_sum_get_general_var(sum2, i, "FOPT"));
+        test_assert_double_equal(ecl_sum_get_general_var(sum1, i, "BPR:567"),
+                                 ecl_sum_get_general_var(sum2, i, "BPR:567"));
+    }
+}
+
+void test_refresh(bool lazy_load) {
+    ecl::util::TestArea ta("sum_refresh");
+    const char *full_unsmry = "FULL/CASE.UNSMRY";
+    const char *unsmry = "CASE.UNSMRY";
+    util_make_path("FULL");
+    write_summary("FULL/CASE", util_make_date_utc(1, 1, 2010), 5, 4);
+    util_copy_file("FULL/CASE.SMSPEC", "CASE.SMSPEC");
+
+    ecl_sum_type *full_sum = ecl_sum_fread_alloc_case("FULL/CASE", ":");
+    long full_size = util_file_size(full_unsmry);
+
+    /*
+      Start out with roughly one third of the file, which ends in the
+      middle of a keyword; then let the file grow in two steps.
+    */
+    long size1 = full_size / 3;
+    long size2 = (2 * full_size) / 3;
+    copy_bytes(full_unsmry, unsmry, 0, size1, "w");
+
+    stringlist_type *data_files = stringlist_alloc_new();
+    stringlist_append_copy(data_files, unsmry);
+    ecl_sum_type *ecl_sum = ecl_sum_fread_alloc("CASE.SMSPEC", data_files, ":",
+                                                false, lazy_load, 0);
+    stringlist_free(data_files);
+
+    int length1 = ecl_sum_get_data_length(ecl_sum);
+    test_assert_true(length1 > 0);
+    test_assert_true(length1 < ecl_sum_get_data_length(full_sum));
+    test_assert_int_equal(ecl_sum_refresh(ecl_sum), 0);
+
+    copy_bytes(full_unsmry, unsmry, size1, size2 - size1, "a");
+    int new_steps = ecl_sum_refresh(ecl_sum);
+    test_assert_true(new_steps > 0);
+    test_assert_int_equal(ecl_sum_get_data_length(ecl_sum), length1 + new_steps);
+    test_assert_double_equal(
+        ecl_sum_get_general_var(ecl_sum, length1 + new_steps - 1, "FOPT"),
+        ecl_sum_get_general_var(full_sum, length1 + new_steps - 1, "FOPT"));
+
+    copy_bytes(full_unsmry, unsmry, size2, full_size - size2, "a");
+    test_assert_true(ecl_sum_refresh(ecl_sum) > 0);
+    assert_sum_equal(ecl_sum, full_sum);
+    test_assert_int_equal(ecl_sum_refresh(ecl_sum), 0);
+
+    ecl_sum_free(ecl_sum);
+    ecl_sum_free(full_sum);
+}
+
+int main(int argc, char **argv) {
+    test_refresh(false);
+    test_refresh(true);
+    return 0;
+}
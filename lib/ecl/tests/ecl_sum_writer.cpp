@@ -18,12 +18,18 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <ert/util/test_util.hpp>
+#include <ert/util/double_vector.hpp>
 #include <ert/util/time_t_vector.hpp>
 #include <ert/util/util.h>
 #include <ert/util/test_work_area.hpp>
 
 #include <ert/ecl/ecl_sum.hpp>
+#include <ert/ecl/ecl_sum_vector.hpp>
 #include <ert/ecl/ecl_grid.hpp>
 #include <ert/ecl/ecl_file.hpp>
 #include <ert/ecl/ecl_kw_magic.hpp>
@@ -253,8 +259,308 @@ void test_long_restart_names() {
     }
 }
 
+static std::vector<std::string> split_csv_line(const char *line) {
+    std::vector<std::string> fields;
+    std::string field;
+    for (const char *c = line; *c; c++) {
+        if (*c == ';') {
+            fields.push_back(field);
+            field.clear();
+        } else
+            field += *c;
+    }
+    fields.push_back(field);
+    return fields;
+}
+
+/*
+  Checks the csv file against a line by line formatting with
+  fprintf()/strftime(). With @value_fmt == NULL, i.e. the shortest float
+  format of ecl_sum_export_csv_vector(), the values must read back to
+  the same float.
+*/
+static void test_csv_file(const ecl_sum_type *ecl_sum, const char *filename,
+                          const char **keys, int num_keys,
+                          const char *date_format, const char *value_fmt) {
+    FILE *stream = util_fopen(filename, "r");
+    bool at_eof;
+    char *line = util_fscanf_alloc_line(stream, &at_eof);
+    std::string expected = "DAYS;DATE";
+    for (int k = 0; k < num_keys; k++)
+        expected += std::string(";") + keys[k];
+    test_assert_string_equal(line, expected.c_str());
+    free(line);
+
+    for (int i = 0; i < ecl_sum_get_data_length(ecl_sum); i++) {
+        char buffer[128];
+        struct tm ts;
+        time_t sim_time = ecl_sum_iget_sim_time(ecl_sum, i);
+        util_time_utc(&sim_time, &ts);
+        strftime(buffer, sizeof buffer, date_format, &ts);
+
+        line = util_fscanf_alloc_line(stream, &at_eof);
+        std::vector<std::string> fields = split_csv_line(line);
+        test_assert_int_equal(fields.size(), num_keys + 2);
+        test_assert_string_equal(fields[1].c_str(), buffer);
+        /* util_fscanf_alloc_line() skips the leading blanks. */
+        snprintf(buffer, sizeof buffer, "%.2f",
+                 ecl_sum_iget_sim_days(ecl_sum, i));
+        test_assert_string_equal(fields[0].c_str(), buffer);
+
+        for (int k = 0; k < num_keys; k++) {
+            const std::string &field = fields[k + 2];
+
+            if (!ecl_sum_has_general_var(ecl_sum, keys[k])) {
+                test_assert_string_equal(field.c_str(), "");
+                continue;
+            }
+
+            double value = ecl_sum_get_general_var(ecl_sum, i, keys[k]);
+            if (value_fmt) {
+                snprintf(buffer, sizeof buffer, value_fmt, value);
+                test_assert_string_equal(field.c_str(), buffer);
+            } else {
+                test_assert_true(strtof(field.c_str(), NULL) == (float)value);
+                test_assert_true(field.size() <= 14);
+            }
+        }
+        free(line);
+    }
+    fclose(stream);
+}
+
+static ecl_sum_type *alloc_csv_case(const char *case_name, const char **keys,
+                                    int num_keys) {
+    time_t start_time = util_make_date_utc(1, 1, 2010);
+    ecl_sum_type *ecl_sum = ecl_sum_alloc_writer(case_name, false, true, ":",
+                                                 start_time, true, 10, 11, 12);
+    std::vector<const ecl::smspec_node *> nodes;
+    for (int k = 0; k < num_keys; k++) {
+        char **parts;
+        int num_parts;
+        util_split_string(keys[k], ":", &num_parts, &parts);
+        nodes.push_back(ecl_sum_add_var(ecl_sum, parts[0],
+                                        num_parts > 1 ? parts[1] : NULL, 0,
+                                        "UNIT", 0.0));
+        util_free_stringlist(parts, num_parts);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        ecl_sum_tstep_type *tstep =
+            ecl_sum_add_tstep(ecl_sum, 1 + i / 10, i * 8 * 3600.0);
+        for (int k = 0; k < num_keys; k++)
+            ecl_sum_tstep_set_from_node(tstep, *nodes[k],
+                                        k == 0 ? i * 1000.1 : 1.0 / (i + 1));
+    }
+    return ecl_sum;
+}
+
+void test_export_csv() {
+    ecl::util::TestArea ta("export_csv");
+    const char *keys[] = {"FOPT", "WWCT:OP_2", "WOPR:OP_1"};
+    const char *case_keys[] = {"FOPT", "WOPR:OP_1"};
+    ecl_sum_type *ecl_sum = alloc_csv_case("CASE", case_keys, 2);
+
+    stringlist_type *key_list = stringlist_alloc_new();
+    for (int k = 0; k < 3; k++)
+        stringlist_append_copy(key_list, keys[k]);
+
+    ecl_sum_export_csv(ecl_sum, "daily.csv", key_list, "%d/%m/%Y", ";");
+    test_csv_file(ecl_sum, "daily.csv", case_keys, 2, "%d/%m/%Y", "%g");
+
+    ecl_sum_export_csv(ecl_sum, "hourly.csv", key_list, "%Y-%m-%d %H:%M",
+                       ";");
+    test_csv_file(ecl_sum, "hourly.csv", case_keys, 2, "%Y-%m-%d %H:%M",
+                  "%g");
+
+    /* The layout case has a key which is not in CASE. */
+    ecl_sum_type *layout_case = alloc_csv_case("LAYOUT", keys, 3);
+    ecl_sum_vector_type *layout = ecl_sum_vector_alloc(layout_case, true);
+    ecl_sum_vector_type *vector =
+        ecl_sum_vector_alloc_layout_copy(layout, ecl_sum);
+    ecl_sum_export_csv_vector(ecl_sum, "vector.csv", vector, "%d/%m/%Y", ";");
+    test_csv_file(ecl_sum, "vector.csv", keys, 3, "%d/%m/%Y", NULL);
+
+    ecl_sum_vector_free(vector);
+    ecl_sum_vector_free(layout);
+    ecl_sum_free(layout_case);
+    stringlist_free(key_list);
+    ecl_sum_free(ecl_sum);
+}
+
+static void write_stream_case(const char *name, bool stream, bool unified) {
+    time_t start_time = util_make_date_utc(1, 1, 2010);
+    ecl_sum_type *ecl_sum;
+    if (stream)
+        ecl_sum = ecl_sum_alloc_stream_writer(
+            name, NULL, 0, false, unified, ":", start_time, true, 10, 10, 10);
+    else
+        ecl_sum = ecl_sum_alloc_writer(name, false, unified, ":", start_time,
+                                       true, 10, 10, 10);
+
+    const ecl::smspec_node *fopt =
+        ecl_sum_add_var(ecl_sum, "FOPT", NULL, 0, "SM3", 0.0);
+    const ecl::smspec_node *wwct =
+        ecl_sum_add_var(ecl_sum, "WWCT", "OP-1", 0, "(1)", 0.0);
+
+    for (int report_step = 1; report_step <= 4; report_step++) {
+        for (int step = 0; step < 6; step++) {
+            int time_index = (report_step - 1) * 6 + step;
+            ecl_sum_tstep_type *tstep =
+                ecl_sum_add_tstep(ecl_sum, report_step, time_index * 43200.0);
+            ecl_sum_tstep_set_from_node(tstep, *fopt, time_index * 10.0);
+            ecl_sum_tstep_set_from_node(tstep, *wwct, step * 0.125);
+
+            /* Flushing in the middle of a report step. */
+            if (stream && report_step == 2 && step == 3)
+                ecl_sum_fwrite(ecl_sum);
+        }
+    }
+    ecl_sum_fwrite(ecl_sum);
+    ecl_sum_free(ecl_sum);
+}
+
+void test_stream_writer() {
+    ecl::util::TestArea ta("stream_writer");
+    write_stream_case("MEMORY", false, true);
+    write_stream_case("STREAM", true, true);
+    test_assert_true(util_files_equal("MEMORY.SMSPEC", "STREAM.SMSPEC"));
+    test_assert_true(util_files_equal("MEMORY.UNSMRY", "STREAM.UNSMRY"));
+
+    write_stream_case("MEMORYX", false, false);
+    write_stream_case("STREAMX", true, false);
+    for (int report_step = 1; report_step <= 4; report_step++) {
+        char *file1 = util_alloc_sprintf("MEMORYX.S%04d", report_step);
+        char *file2 = util_alloc_sprintf("STREAMX.S%04d", report_step);
+        test_assert_true(util_files_equal(file1, file2));
+        free(file1);
+        free(file2);
+    }
+
+    {
+        ecl_sum_type *ecl_sum = ecl_sum_fread_alloc_case("STREAM", ":");
+        test_assert_int_equal(ecl_sum_get_data_length(ecl_sum), 24);
+        test_assert_int_equal(ecl_sum_get_last_report_step(ecl_sum), 4);
+        for (int time_index = 0; time_index < 24; time_index++) {
+            test_assert_double_equal(
+                ecl_sum_get_general_var(ecl_sum, time_index, "FOPT"),
+                time_index * 10.0);
+            test_assert_int_equal(ecl_sum_iget_report_step(ecl_sum, time_index),
+                                  time_index / 6 + 1);
+        }
+        ecl_sum_free(ecl_sum);
+    }
+
+    {
+        time_t start_time = util_make_date_utc(1, 1, 2010);
+        ecl_sum_type *ecl_sum = ecl_sum_alloc_stream_writer(
+            "WRITER", NULL, 0, false, true, ":", start_time, true, 10, 10, 10);
+        ecl_sum_add_var(ecl_sum, "FOPT", NULL, 0, "SM3", 0.0);
+        ecl_sum_add_tstep(ecl_sum, 1, 0);
+        ecl_sum_add_tstep(ecl_sum, 1, 86400);
+        ecl_sum_add_tstep(ecl_sum, 2, 2 * 86400);
+
+        test_assert_int_equal(ecl_sum_get_data_length(ecl_sum), 3);
+        test_assert_double_equal(ecl_sum_iget_sim_days(ecl_sum, 1), 1.0);
+        test_assert_double_equal(
+            ecl_sum_get_general_var(ecl_sum, 2, "FOPT"), 0.0);
+        test_assert_throw(ecl_sum_get_general_var(ecl_sum, 0, "FOPT"),
+                          std::out_of_range);
+        test_assert_throw(ecl_sum_add_tstep(ecl_sum, 2, 0),
+                          std::invalid_argument);
+        ecl_sum_free(ecl_sum);
+    }
+}
+
+void test_eager_load() {
+    ecl::util::TestArea ta("eager_load");
+    write_stream_case("CASE", false, true);
+
+    {
+        ecl_sum_type *lazy_sum = ecl_sum_fread_alloc_case("CASE", ":");
+        ecl_sum_type *ecl_sum =
+            ecl_sum_fread_alloc_case2__("CASE", ":", true, false, 0);
+        const char *keys[] = {"FOPT", "WWCT:OP-1"};
+
+        test_assert_int_equal(ecl_sum_get_data_length(ecl_sum), 24);
+        for (const char *key : keys) {
+            int params_index =
+                ecl_sum_get_general_var_params_index(ecl_sum, key);
+            double_vector_type *data =
+                ecl_sum_alloc_data_vector(ecl_sum, params_index, false);
+            for (int time_index = 0; time_index < 24; time_index++) {
+                double value =
+                    ecl_sum_get_general_var(lazy_sum, time_index, key);
+                test_assert_double_equal(
+                    ecl_sum_get_general_var(ecl_sum, time_index, key), value);
+                test_assert_double_equal(
+                    double_vector_iget(data, time_index), value);
+            }
+            double_vector_free(data);
+        }
+
+        ecl_sum_set_case(ecl_sum, "COPY");
+        ecl_sum_fwrite(ecl_sum);
+        test_assert_true(util_files_equal("CASE.UNSMRY", "COPY.UNSMRY"));
+
+        /* Adding a timestep to a loaded case. */
+        ecl_sum_tstep_type *tstep = ecl_sum_add_tstep(ecl_sum, 5, 24 * 43200.0);
+        ecl_sum_tstep_set_from_key(tstep, "FOPT", 240.0);
+        test_assert_int_equal(ecl_sum_get_data_length(ecl_sum), 25);
+        test_assert_double_equal(ecl_sum_get_general_var(ecl_sum, 23, "FOPT"),
+                                 230.0);
+        test_assert_double_equal(ecl_sum_get_general_var(ecl_sum, 24, "FOPT"),
+                                 240.0);
+
+        ecl_sum_free(ecl_sum);
+        ecl_sum_free(lazy_sum);
+    }
+
+    /*
+      A case where the report steps are not in time order, made by
+      renaming the files of a normal case; the timesteps are sorted by
+      time when the case is loaded.
+    */
+    {
+        time_t start_time = util_make_date_utc(1, 1, 2010);
+        ecl_sum_type *ecl_sum = ecl_sum_alloc_writer(
+            "FORWARD", false, false, ":", start_time, true, 10, 10, 10);
+        const ecl::smspec_node *fopt =
+            ecl_sum_add_var(ecl_sum, "FOPT", NULL, 0, "SM3", 0.0);
+        for (int report_step = 1; report_step <= 3; report_step++) {
+            ecl_sum_tstep_type *tstep = ecl_sum_add_tstep(
+                ecl_sum, report_step, (report_step - 1) * 86400.0);
+            ecl_sum_tstep_set_from_node(tstep, *fopt, report_step);
+        }
+        ecl_sum_fwrite(ecl_sum);
+        ecl_sum_free(ecl_sum);
+
+        util_copy_file("FORWARD.SMSPEC", "REVERSE.SMSPEC");
+        util_copy_file("FORWARD.S0001", "REVERSE.S0003");
+        util_copy_file("FORWARD.S0002", "REVERSE.S0002");
+        util_copy_file("FORWARD.S0003", "REVERSE.S0001");
+    }
+    {
+        ecl_sum_type *ecl_sum = ecl_sum_fread_alloc_case("REVERSE", ":");
+        test_assert_int_equal(ecl_sum_get_data_length(ecl_sum), 3);
+        for (int time_index = 0; time_index < 3; time_index++) {
+            test_assert_double_equal(ecl_sum_iget_sim_days(ecl_sum, time_index),
+                                     time_index);
+            test_assert_double_equal(
+                ecl_sum_get_general_var(ecl_sum, time_index, "FOPT"),
+                time_index + 1);
+            test_assert_int_equal(ecl_sum_iget_report_step(ecl_sum, time_index),
+                                  3 - time_index);
+        }
+        ecl_sum_free(ecl_sum);
+    }
+}
+
 int main(int argc, char **argv) {
     util_install_signals();
+    test_export_csv();
+    test_stream_writer();
+    test_eager_load();
     test_write_read();
     test_ecl_sum_alloc_restart_writer();
     test_long_restart_names();
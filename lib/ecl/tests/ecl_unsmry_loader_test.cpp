@@ -1,4 +1,5 @@
 #include <vector>
+#include <stdexcept>
 
 #include <ert/util/test_work_area.hpp>
 #include <ert/util/test_util.hpp>
@@ -57,7 +58,65 @@ void test_load() {
     ecl_sum_free(ecl_sum);
 }
 
+void test_get_vectors() {
+    ecl::util::TestArea ta("ecl_sum_loader_vectors");
+    ecl_sum_type *ecl_sum = write_ecl_sum();
+    ecl::unsmry_loader loader(ecl_sum_get_smspec(ecl_sum), "CASE.UNSMRY", 0);
+
+    const auto vectors = loader.get_vectors({3, -1, 1, 2});
+    test_assert_int_equal(vectors.size(), 4);
+    test_assert_int_equal(vectors[0].size(), 4);
+    test_assert_true(vectors[1].empty());
+    test_assert_true(vectors[0] == loader.get_vector(3));
+    test_assert_true(vectors[2] == loader.get_vector(1));
+    test_assert_true(vectors[3] == loader.get_vector(2));
+    test_assert_double_equal(vectors[2][3], 6.0);
+
+    test_assert_throw(loader.get_vectors({1, 100}), std::out_of_range);
+    ecl_sum_free(ecl_sum);
+}
+
+void test_column_cache() {
+    ecl::util::TestArea ta("ecl_sum_loader_columns");
+    ecl_sum_type *ecl_sum = write_ecl_sum();
+    {
+        ecl::unsmry_loader loader(ecl_sum_get_smspec(ecl_sum), "CASE.UNSMRY",
+                                  ECL_FILE_COLUMN_CACHE);
+        const std::vector<double> BPR_value = loader.get_vector(2);
+        test_assert_true(util_file_exists(".CASE.UNSMRY.columns"));
+        test_assert_int_equal(BPR_value.size(), 4);
+        test_assert_double_equal(BPR_value[2], 10.0);
+    }
+    {
+        /* Reuse the existing cache file. */
+        ecl::unsmry_loader loader(ecl_sum_get_smspec(ecl_sum), "CASE.UNSMRY",
+                                  ECL_FILE_COLUMN_CACHE);
+        const std::vector<double> FOPT_value = loader.get_vector(1);
+        const std::vector<double> WWCT_value = loader.get_vector(3);
+        test_assert_double_equal(FOPT_value[3], 6.0);
+        test_assert_double_equal(WWCT_value[1], 10.0);
+
+        const auto vectors = loader.get_vectors({1, 3});
+        test_assert_true(vectors[0] == FOPT_value);
+        test_assert_true(vectors[1] == WWCT_value);
+    }
+    {
+        /* A stale or truncated cache file is rebuilt. */
+        FILE *stream = fopen(".CASE.UNSMRY.columns", "wb");
+        util_fwrite_int(0, stream);
+        fclose(stream);
+
+        ecl::unsmry_loader loader(ecl_sum_get_smspec(ecl_sum), "CASE.UNSMRY",
+                                  ECL_FILE_COLUMN_CACHE);
+        const std::vector<double> WWCT_value = loader.get_vector(3);
+        test_assert_double_equal(WWCT_value[3], 22.0);
+    }
+    ecl_sum_free(ecl_sum);
+}
+
 int main() {
     test_load();
+    test_get_vectors();
+    test_column_cache();
     return 0;
 }
@@ -34,13 +34,19 @@ extern "C" {
 #include <ert/ecl/ecl_type.hpp>
 
 #define ECL_FILE_FLAGS_ENUM_DEFS                                               \
-    {.value = 1, .name = "ECL_FILE_CLOSE_STREAM"}, {                           \
-        .value = 2, .name = "ECL_FILE_WRITABLE"                                \
+    {.value = 1, .name = "ECL_FILE_CLOSE_STREAM"},                             \
+        {.value = 2, .name = "ECL_FILE_WRITABLE"},                             \
+        {.value = 4, .name = "ECL_FILE_MMAP"},                                 \
+        {.value = 8, .name = "ECL_FILE_INDEX_CACHE"}, {                        \
+        .value = 16, .name = "ECL_FILE_COLUMN_CACHE"                           \
     }
-#define ECL_FILE_FLAGS_ENUM_SIZE 2
+#define ECL_FILE_FLAGS_ENUM_SIZE 5
 
 typedef struct ecl_file_struct ecl_file_type;
 bool ecl_file_load_all(ecl_file_type *ecl_file);
+bool ecl_file_load_kw_list(ecl_file_type *ecl_file, int num_kw,
+                           const char **kw_list, const int *occurence_list);
+int ecl_file_refresh(ecl_file_type *ecl_file);
 ecl_file_type *ecl_file_open(const char *filename, int flags);
 ecl_file_type *ecl_file_fast_open(const char *filename,
                                   const char *index_filename, int flags);
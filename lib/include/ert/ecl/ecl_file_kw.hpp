@@ -48,6 +48,8 @@ void ecl_file_kw_free(ecl_file_kw_type *file_kw);
 void ecl_file_kw_free__(void *arg);
 ecl_kw_type *ecl_file_kw_get_kw(ecl_file_kw_type *file_kw, fortio_type *fortio,
                                 inv_map_type *inv_map);
+void ecl_file_kw_load_kw_list(ecl_file_kw_type **file_kw_list, int num_kw,
+                              fortio_type *fortio, inv_map_type *inv_map);
 ecl_kw_type *ecl_file_kw_get_kw_ptr(ecl_file_kw_type *file_kw);
 ecl_file_kw_type *ecl_file_kw_alloc_copy(const ecl_file_kw_type *src);
 const char *ecl_file_kw_get_header(const ecl_file_kw_type *file_kw);
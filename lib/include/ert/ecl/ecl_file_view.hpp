@@ -35,12 +35,29 @@ typedef enum {
                                     This flag will close the underlying FILE object between each access; this is
                                     mainly to save filedescriptors in cases where many ecl_file instances are open at
                                     the same time. */
-    ECL_FILE_WRITABLE = 2      /*
+    ECL_FILE_WRITABLE = 2,     /*
                                     This flag opens the file in a mode where it can be updated and modified, but it
                                     must still exist and be readable. I.e. this should not compared with the normal:
                                     fopen(filename , "w") where an existing file is truncated to zero upon successfull
                                     open.
                                  */
+    ECL_FILE_MMAP = 4,         /*
+                                    This flag will memory map the file read-only when it is opened, and keywords are
+                                    subsequently loaded directly from the mapping. The flag is ignored for formatted
+                                    files, in combination with ECL_FILE_WRITABLE and on platforms without mmap().
+                                 */
+    ECL_FILE_INDEX_CACHE = 8,  /*
+                                    With this flag ecl_file_open() will store the keyword index in a hidden file
+                                    .<name>.index next to the file, and reuse it on subsequent opens as long as the
+                                    size and mtime of the file are unchanged. When the file has grown only the new
+                                    part of the file is scanned.
+                                 */
+    ECL_FILE_COLUMN_CACHE = 16 /*
+                                    Only used when summary data is loaded lazily: the PARAMS records of the UNSMRY
+                                    file are transposed to column major order in one pass, and stored in a hidden
+                                    file .<name>.columns next to the UNSMRY file. Subsequently a summary vector is
+                                    loaded with one contiguous read.
+                                 */
 } ecl_file_flag_type;
 
 typedef struct ecl_file_view_struct ecl_file_view_type;
@@ -55,6 +72,8 @@ ecl_file_view_type *ecl_file_view_alloc(fortio_type *fortio, int *flags,
 int ecl_file_view_get_global_index(const ecl_file_view_type *ecl_file_view,
                                    const char *kw, int ith);
 void ecl_file_view_make_index(ecl_file_view_type *ecl_file_view);
+void ecl_file_view_extend_index(ecl_file_view_type *ecl_file_view,
+                                int start_index);
 bool ecl_file_view_has_kw(const ecl_file_view_type *ecl_file_view,
                           const char *kw);
 ecl_file_kw_type *
@@ -69,6 +88,9 @@ void ecl_file_view_index_fload_kw(const ecl_file_view_type *ecl_file_view,
                                   const char *kw, int index,
                                   const int_vector_type *index_map,
                                   char *buffer);
+bool ecl_file_view_index_fread_kw(const ecl_file_view_type *ecl_file_view,
+                                  const char *kw, int index,
+                                  ecl_kw_type *ecl_kw);
 int ecl_file_view_find_kw_value(const ecl_file_view_type *ecl_file_view,
                                 const char *kw, const void *value);
 const char *
@@ -94,6 +116,9 @@ void ecl_file_view_replace_kw(ecl_file_view_type *ecl_file_view,
                               ecl_kw_type *old_kw, ecl_kw_type *new_kw,
                               bool insert_copy);
 bool ecl_file_view_load_all(ecl_file_view_type *ecl_file_view);
+bool ecl_file_view_load_kw_list(ecl_file_view_type *ecl_file_view, int num_kw,
+                                const char **kw_list,
+                                const int *occurence_list);
 void ecl_file_view_add_kw(ecl_file_view_type *ecl_file_view,
                           ecl_file_kw_type *file_kw);
 void ecl_file_view_free(ecl_file_view_type *ecl_file_view);
@@ -43,6 +43,20 @@ extern "C" {
 typedef double(block_function_ftype)(const double_vector_type *);
 typedef struct ecl_grid_struct ecl_grid_type;
 
+/*
+  Read only view of the compressed sparse row NNC storage of one grid,
+  see ecl_grid_init_compact_nnc(). The connections from cell g are found
+  in the index range [row_offset[g], row_offset[g + 1]) of the lgr_nr,
+  global_index and nnc_index arrays.
+*/
+typedef struct {
+    int size; /* Number of cells (rows). */
+    const int *row_offset;
+    const int *lgr_nr;
+    const int *global_index;
+    const int *nnc_index;
+} ecl_grid_nnc_csr_type;
+
 bool ecl_grid_have_coarse_cells(const ecl_grid_type *main_grid);
 bool ecl_grid_cell_in_coarse_group1(const ecl_grid_type *main_grid,
                                     int global_index);
@@ -127,6 +141,10 @@ bool ecl_grid_cell_contains3(const ecl_grid_type *grid, int i, int j, int k,
                              double x, double y, double z);
 int ecl_grid_get_global_index_from_xyz(ecl_grid_type *grid, double x, double y,
                                        double z, int start_index);
+void ecl_grid_get_global_index_from_xyz_batch(ecl_grid_type *grid,
+                                              int num_points, const double *x,
+                                              const double *y, const double *z,
+                                              int *global_index);
 bool ecl_grid_get_ijk_from_xyz(ecl_grid_type *grid, double x, double y,
                                double z, int start_index, int *i, int *j,
                                int *k);
@@ -197,6 +215,15 @@ char *ecl_grid_alloc_case_filename(const char *case_input);
 
 void ecl_grid_free(ecl_grid_type *);
 void ecl_grid_free__(void *arg);
+void ecl_grid_init_compact_geometry(ecl_grid_type *grid);
+void ecl_grid_free_compact_geometry(ecl_grid_type *grid);
+bool ecl_grid_has_compact_geometry(const ecl_grid_type *grid);
+void ecl_grid_freeze(ecl_grid_type *grid);
+void ecl_grid_init_compact_nnc(ecl_grid_type *grid);
+void ecl_grid_free_compact_nnc(ecl_grid_type *grid);
+bool ecl_grid_has_compact_nnc(const ecl_grid_type *grid);
+bool ecl_grid_get_compact_nnc(const ecl_grid_type *grid,
+                              ecl_grid_nnc_csr_type *csr);
 grid_dims_type ecl_grid_iget_dims(const ecl_grid_type *grid, int grid_nr);
 void ecl_grid_get_dims(const ecl_grid_type *, int *, int *, int *, int *);
 int ecl_grid_get_nz(const ecl_grid_type *grid);
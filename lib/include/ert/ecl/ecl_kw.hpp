@@ -150,6 +150,8 @@ bool ecl_kw_content_equal(const ecl_kw_type *ecl_kw1,
 bool ecl_kw_fskip_data__(ecl_data_type, int, fortio_type *);
 bool ecl_kw_fskip_data(ecl_kw_type *ecl_kw, fortio_type *fortio);
 bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio);
+bool ecl_kw_pread_data(ecl_kw_type *ecl_kw, const fortio_type *fortio,
+                       offset_type data_offset);
 void ecl_kw_fskip_header(fortio_type *fortio);
 bool ecl_kw_size_and_numeric_type_equal(const ecl_kw_type *kw1,
                                         const ecl_kw_type *kw2);
@@ -30,6 +30,18 @@
 
 typedef struct ecl_smspec_struct ecl_smspec_type;
 
+/**
+   A general key, e.g. "WWCT:OP_1", prepared for repeated lookup; see
+   ecl_smspec_get_key_node().
+*/
+typedef struct ecl_smspec_key_struct ecl_smspec_key_type;
+
+/**
+   A precompiled set of key patterns, e.g. "WOPR:*" and "BPR:*"; see
+   ecl_smspec_select_matching_keys().
+*/
+typedef struct ecl_smspec_matcher_struct ecl_smspec_matcher_type;
+
 #ifdef __cplusplus
 #include <vector>
 const std::vector<float> &
@@ -61,6 +73,8 @@ ecl_smspec_get_well_completion_var_node(const ecl_smspec_type *ecl_smspec,
 const ecl::smspec_node &
 ecl_smspec_get_general_var_node(const ecl_smspec_type *smspec,
                                 const char *lookup_kw);
+const ecl::smspec_node *ecl_smspec_get_key_node(const ecl_smspec_type *smspec,
+                                                const ecl_smspec_key_type *key);
 const ecl::smspec_node &
 ecl_smspec_iget_node_w_node_index(const ecl_smspec_type *smspec,
                                   int node_index);
@@ -167,12 +181,25 @@ bool ecl_smspec_has_general_var(const ecl_smspec_type *ecl_smspec,
 const char *ecl_smspec_get_general_var_unit(const ecl_smspec_type *ecl_smspec,
                                             const char *lookup_kw);
 
+ecl_smspec_key_type *ecl_smspec_key_alloc(const char *gen_key);
+void ecl_smspec_key_free(ecl_smspec_key_type *key);
+const char *ecl_smspec_key_get_key(const ecl_smspec_key_type *key);
+int ecl_smspec_get_key_params_index(const ecl_smspec_type *smspec,
+                                    const ecl_smspec_key_type *key);
+
 void ecl_smspec_select_matching_general_var_list(const ecl_smspec_type *smspec,
                                                  const char *pattern,
                                                  stringlist_type *keys);
 stringlist_type *
 ecl_smspec_alloc_matching_general_var_list(const ecl_smspec_type *smspec,
                                            const char *pattern);
+ecl_smspec_matcher_type *
+ecl_smspec_matcher_alloc(const stringlist_type *patterns,
+                         const char *key_join_string);
+void ecl_smspec_matcher_free(ecl_smspec_matcher_type *matcher);
+void ecl_smspec_select_matching_keys(const ecl_smspec_type *smspec,
+                                     const ecl_smspec_matcher_type *matcher,
+                                     stringlist_type *keys);
 
 int ecl_smspec_get_time_seconds(const ecl_smspec_type *ecl_smspec);
 int ecl_smspec_get_time_index(const ecl_smspec_type *ecl_smspec);
@@ -198,6 +225,8 @@ char *ecl_smspec_alloc_well_key(const ecl_smspec_type *smspec,
                                 const char *keyword, const char *wgname);
 bool ecl_smspec_equal(const ecl_smspec_type *self,
                       const ecl_smspec_type *other);
+bool ecl_smspec_shareable(const ecl_smspec_type *self,
+                          const ecl_smspec_type *other);
 
 // void                       ecl_smspec_sort( ecl_smspec_type * smspec );
 ert_ecl_unit_enum ecl_smspec_get_unit_system(const ecl_smspec_type *smspec);
@@ -179,6 +179,10 @@ ecl_sum_get_general_var_node(const ecl_sum_type *ecl_sum,
 bool ecl_sum_has_general_var(const ecl_sum_type *ecl_sum,
                              const char *lookup_kw);
 bool ecl_sum_has_key(const ecl_sum_type *ecl_sum, const char *lookup_kw);
+const ecl::smspec_node *ecl_sum_get_key_node(const ecl_sum_type *ecl_sum,
+                                             const ecl_smspec_key_type *key);
+int ecl_sum_get_key_params_index(const ecl_sum_type *ecl_sum,
+                                 const ecl_smspec_key_type *key);
 double ecl_sum_get_general_var_from_sim_days(const ecl_sum_type *ecl_sum,
                                              double sim_days, const char *var);
 double ecl_sum_get_general_var_from_sim_time(const ecl_sum_type *ecl_sum,
@@ -245,6 +249,9 @@ ecl_sum_alloc_matching_general_var_list(const ecl_sum_type *ecl_sum,
 void ecl_sum_select_matching_general_var_list(const ecl_sum_type *ecl_sum,
                                               const char *pattern,
                                               stringlist_type *keys);
+void ecl_sum_select_matching_keys(const ecl_sum_type *ecl_sum,
+                                  const ecl_smspec_matcher_type *matcher,
+                                  stringlist_type *keys);
 ecl_smspec_type *ecl_sum_get_smspec(const ecl_sum_type *ecl_sum);
 ecl_smspec_var_type ecl_sum_identify_var_type(const char *var);
 ecl_smspec_var_type ecl_sum_get_var_type(const ecl_sum_type *ecl_sum,
@@ -270,8 +277,14 @@ ecl_sum_type *ecl_sum_alloc_writer(const char *ecl_case, bool fmt_output,
                                    bool unified, const char *key_join_string,
                                    time_t sim_start, bool time_in_days, int nx,
                                    int ny, int nz);
+ecl_sum_type *
+ecl_sum_alloc_stream_writer(const char *ecl_case, const char *restart_case,
+                            int restart_step, bool fmt_output, bool unified,
+                            const char *key_join_string, time_t sim_start,
+                            bool time_in_days, int nx, int ny, int nz);
 void ecl_sum_fwrite(const ecl_sum_type *ecl_sum);
 bool ecl_sum_can_write(const ecl_sum_type *ecl_sum);
+int ecl_sum_refresh(ecl_sum_type *ecl_sum);
 void ecl_sum_fwrite_smspec(const ecl_sum_type *ecl_sum);
 const ecl::smspec_node *ecl_sum_add_smspec_node(ecl_sum_type *ecl_sum,
                                                 const ecl::smspec_node *node);
@@ -292,6 +305,13 @@ bool ecl_sum_report_step_compatible(const ecl_sum_type *ecl_sum1,
 void ecl_sum_export_csv(const ecl_sum_type *ecl_sum, const char *filename,
                         const stringlist_type *var_list,
                         const char *date_format, const char *sep);
+void ecl_sum_export_csv_vector(const ecl_sum_type *ecl_sum,
+                               const char *filename,
+                               const ecl_sum_vector_type *keys,
+                               const char *date_format, const char *sep);
+void ecl_sum_export_columns(const ecl_sum_type *ecl_sum, const char *filename,
+                            const ecl_sum_vector_type *keys, int row_group_size,
+                            bool compress);
 
 double_vector_type *ecl_sum_alloc_seconds_solution(const ecl_sum_type *ecl_sum,
                                                    const char *gen_key,
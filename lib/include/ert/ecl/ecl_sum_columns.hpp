@@ -0,0 +1,68 @@
+#ifndef ERT_ECL_SUM_COLUMNS_H
+#define ERT_ECL_SUM_COLUMNS_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include <ert/util/type_macros.hpp>
+
+#include <ert/ecl/smspec_node.hpp>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+   Reader for the columnar summary files written by
+   ecl_sum_export_columns(). The file is memory mapped when possible;
+   a column which is stored uncompressed in one row group is used
+   directly from the mapping, otherwise it is assembled in memory the
+   first time it is accessed. Because of this lazy assembly the
+   accessors are not thread safe. For a file without rows the data
+   accessors return NULL.
+*/
+typedef struct ecl_sum_columns_struct ecl_sum_columns_type;
+
+ecl_sum_columns_type *ecl_sum_columns_fread_alloc(const char *filename);
+void ecl_sum_columns_free(ecl_sum_columns_type *columns);
+
+int ecl_sum_columns_get_length(const ecl_sum_columns_type *columns);
+int ecl_sum_columns_get_size(const ecl_sum_columns_type *columns);
+int ecl_sum_columns_get_num_row_groups(const ecl_sum_columns_type *columns);
+bool ecl_sum_columns_is_mmapped(const ecl_sum_columns_type *columns);
+time_t ecl_sum_columns_get_start_time(const ecl_sum_columns_type *columns);
+
+const int64_t *ecl_sum_columns_get_sim_time(ecl_sum_columns_type *columns);
+const double *ecl_sum_columns_get_sim_days(ecl_sum_columns_type *columns);
+const int *ecl_sum_columns_get_report_step(ecl_sum_columns_type *columns);
+
+bool ecl_sum_columns_has_key(const ecl_sum_columns_type *columns,
+                             const char *key);
+int ecl_sum_columns_get_index(const ecl_sum_columns_type *columns,
+                              const char *key);
+const char *ecl_sum_columns_iget_key(const ecl_sum_columns_type *columns,
+                                     int index);
+const char *ecl_sum_columns_iget_keyword(const ecl_sum_columns_type *columns,
+                                         int index);
+const char *ecl_sum_columns_iget_wgname(const ecl_sum_columns_type *columns,
+                                        int index);
+const char *ecl_sum_columns_iget_unit(const ecl_sum_columns_type *columns,
+                                      int index);
+int ecl_sum_columns_iget_num(const ecl_sum_columns_type *columns, int index);
+ecl_smspec_var_type
+ecl_sum_columns_iget_var_type(const ecl_sum_columns_type *columns, int index);
+bool ecl_sum_columns_iget_is_rate(const ecl_sum_columns_type *columns,
+                                  int index);
+bool ecl_sum_columns_iget_is_total(const ecl_sum_columns_type *columns,
+                                   int index);
+float ecl_sum_columns_iget_default(const ecl_sum_columns_type *columns,
+                                   int index);
+const float *ecl_sum_columns_iget_data(ecl_sum_columns_type *columns,
+                                       int index);
+
+UTIL_IS_INSTANCE_HEADER(ecl_sum_columns);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -40,16 +40,21 @@ typedef struct ecl_sum_data_struct ecl_sum_data_type;
 void ecl_sum_data_reset_self_map(ecl_sum_data_type *data);
 void ecl_sum_data_add_case(ecl_sum_data_type *self,
                            const ecl_sum_data_type *other);
+int ecl_sum_data_refresh(ecl_sum_data_type *data);
 void ecl_sum_data_fwrite_step(const ecl_sum_data_type *data,
                               const char *ecl_case, bool fmt_case, bool unified,
                               int report_step);
 void ecl_sum_data_fwrite(const ecl_sum_data_type *data, const char *ecl_case,
                          bool fmt_case, bool unified);
 bool ecl_sum_data_can_write(const ecl_sum_data_type *data);
+void ecl_sum_data_set_header_file(ecl_sum_data_type *data,
+                                  const char *header_file);
 bool ecl_sum_data_fread(ecl_sum_data_type *data,
                         const stringlist_type *filelist, bool lazy_load,
                         int file_options);
 ecl_sum_data_type *ecl_sum_data_alloc_writer(ecl_smspec_type *smspec);
+void ecl_sum_data_stream_open(ecl_sum_data_type *data, const char *ecl_case,
+                              bool fmt_case, bool unified);
 ecl_sum_data_type *ecl_sum_data_alloc(ecl_smspec_type *smspec);
 double ecl_sum_data_time2days(const ecl_sum_data_type *data, time_t sim_time);
 int ecl_sum_data_get_report_step_from_time(const ecl_sum_data_type *data,
@@ -134,6 +139,10 @@ void ecl_sum_data_init_datetime64_vector(const ecl_sum_data_type *data,
 void ecl_sum_data_init_double_frame(const ecl_sum_data_type *data,
                                     const ecl_sum_vector_type *keywords,
                                     double *output_data);
+void ecl_sum_data_init_double_frame_rows(const ecl_sum_data_type *data,
+                                         const int *time_indices, int num_rows,
+                                         const int *params_indices,
+                                         int num_params, double *output_data);
 double_vector_type *
 ecl_sum_data_alloc_seconds_solution(const ecl_sum_data_type *data,
                                     const ecl::smspec_node &node, double value,
@@ -0,0 +1,44 @@
+#ifndef ERT_ECL_SUM_ENSEMBLE_H
+#define ERT_ECL_SUM_ENSEMBLE_H
+
+#include <ert/util/type_macros.hpp>
+#include <ert/util/stringlist.hpp>
+#include <ert/util/time_t_vector.hpp>
+
+#include <ert/ecl/ecl_sum.hpp>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+   An ensemble of summary cases which have been loaded together. The
+   cases are loaded in parallel, and cases with identical SMSPEC
+   headers share one ecl_smspec instance; the ecl_sum instances are
+   owned by the ensemble.
+*/
+typedef struct ecl_sum_ensemble_struct ecl_sum_ensemble_type;
+
+ecl_sum_ensemble_type *
+ecl_sum_ensemble_fread_alloc(const stringlist_type *case_list,
+                             const char *key_join_string, int num_threads);
+void ecl_sum_ensemble_free(ecl_sum_ensemble_type *ensemble);
+
+int ecl_sum_ensemble_get_size(const ecl_sum_ensemble_type *ensemble);
+const ecl_sum_type *
+ecl_sum_ensemble_iget_case(const ecl_sum_ensemble_type *ensemble, int index);
+const char *
+ecl_sum_ensemble_iget_case_name(const ecl_sum_ensemble_type *ensemble,
+                                int index);
+int ecl_sum_ensemble_get_num_smspec(const ecl_sum_ensemble_type *ensemble);
+
+void ecl_sum_ensemble_init_double_frame_interp(
+    const ecl_sum_ensemble_type *ensemble, const stringlist_type *keys,
+    const time_t_vector_type *time_points, double *data);
+
+UTIL_IS_INSTANCE_HEADER(ecl_sum_ensemble);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
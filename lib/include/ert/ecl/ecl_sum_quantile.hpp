@@ -0,0 +1,50 @@
+#ifndef ERT_ECL_SUM_QUANTILE_H
+#define ERT_ECL_SUM_QUANTILE_H
+
+#include <ert/util/type_macros.hpp>
+#include <ert/util/stringlist.hpp>
+#include <ert/util/time_t_vector.hpp>
+
+#include <ert/ecl/ecl_sum.hpp>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECL_SUM_QUANTILE_DEFAULT_CAPACITY 200
+
+/**
+   Streaming computation of quantiles, e.g. P10/P50/P90, of a set of
+   summary vectors over an ensemble. The cases are added one at a time
+   and interpolated to a common time axis; only a quantile sketch is
+   kept for each (key, time) pair, so the memory does not grow with the
+   size of the ensemble.
+*/
+typedef struct ecl_sum_quantile_struct ecl_sum_quantile_type;
+
+ecl_sum_quantile_type *
+ecl_sum_quantile_alloc(const stringlist_type *keys,
+                       const time_t_vector_type *time_points, int capacity);
+void ecl_sum_quantile_free(ecl_sum_quantile_type *quantile);
+
+void ecl_sum_quantile_add_case(ecl_sum_quantile_type *quantile,
+                               const ecl_sum_type *ecl_sum);
+int ecl_sum_quantile_add_cases(ecl_sum_quantile_type *quantile,
+                               const stringlist_type *case_list,
+                               const char *key_join_string);
+
+int ecl_sum_quantile_get_size(const ecl_sum_quantile_type *quantile);
+int ecl_sum_quantile_iget_count(const ecl_sum_quantile_type *quantile,
+                                int key_index);
+bool ecl_sum_quantile_is_exact(const ecl_sum_quantile_type *quantile);
+double ecl_sum_quantile_iget(const ecl_sum_quantile_type *quantile,
+                             int key_index, int time_index, double q);
+void ecl_sum_quantile_init_double_frame(const ecl_sum_quantile_type *quantile,
+                                        double q, double *data);
+
+UTIL_IS_INSTANCE_HEADER(ecl_sum_quantile);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
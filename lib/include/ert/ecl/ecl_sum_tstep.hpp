@@ -44,6 +44,9 @@ ecl_sum_tstep_type *ecl_sum_tstep_alloc_from_file(
 ecl_sum_tstep_type *ecl_sum_tstep_alloc_new(int report_step, int ministep,
                                             float sim_seconds,
                                             const ecl_smspec_type *smspec);
+void ecl_sum_tstep_time_from_params(const float *params,
+                                    const ecl_smspec_type *smspec,
+                                    time_t *sim_time, double *sim_seconds);
 
 void ecl_sum_tstep_set_from_node(ecl_sum_tstep_type *tstep,
                                  const ecl::smspec_node &smspec_node,
@@ -62,6 +65,10 @@ int ecl_sum_tstep_get_ministep(const ecl_sum_tstep_type *ministep);
 void ecl_sum_tstep_fwrite(const ecl_sum_tstep_type *ministep,
                           const int *index_map, int index_map_size,
                           fortio_type *fortio);
+void ecl_sum_tstep_fwrite_kw(const ecl_sum_tstep_type *ministep,
+                             const int *index_map, int index_map_size,
+                             ecl_kw_type *ministep_kw, ecl_kw_type *params_kw,
+                             fortio_type *fortio);
 void ecl_sum_tstep_iset(ecl_sum_tstep_type *tstep, int index, float value);
 
 /// scales with value; equivalent to iset( iget() * scalar)
@@ -64,6 +64,11 @@ void fortio_complete_write(fortio_type *, int record_size);
 void fortio_fskip_buffer(fortio_type *, int);
 int fortio_fskip_record(fortio_type *);
 bool fortio_fread_buffer(fortio_type *, char *buffer, int buffer_size);
+bool fortio_mmap(fortio_type *fortio);
+bool fortio_is_mmapped(const fortio_type *fortio);
+bool fortio_refresh_size(fortio_type *fortio);
+bool fortio_pread_buffer(const fortio_type *fortio, offset_type offset,
+                         char *buffer, int buffer_size);
 void fortio_fwrite_record(fortio_type *, const char *buffer, int buffer_size);
 FILE *fortio_get_FILE(const fortio_type *);
 void fortio_fflush(fortio_type *);
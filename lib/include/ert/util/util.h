@@ -288,6 +288,8 @@ char *util_fread_realloc_string(char *, FILE *);
 char *util_fread_alloc_string(FILE *);
 void util_fskip_string(FILE *stream);
 void util_endian_flip_vector(void *data, int element_size, int elements);
+void util_endian_flip_copy_vector(void *target, const void *src,
+                                  int element_size, int elements);
 
 void util_clamp_double(double *value, double limit1, double limit2);
 double util_double_vector_mean(int, const double *);
@@ -24,6 +24,8 @@ extern "C" {
 #endif
 
 void util_endian_flip_vector(void *data, int element_size, int elements);
+void util_endian_flip_copy_vector(void *target, const void *src,
+                                  int element_size, int elements);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,103 @@
+#ifndef ERT_ECL_SUM_COLUMNS_FORMAT_H
+#define ERT_ECL_SUM_COLUMNS_FORMAT_H
+
+#include <stdint.h>
+
+namespace ecl {
+namespace sum_columns {
+
+/*
+  On disk layout of the columnar summary files written by
+  ecl_sum_export_columns() and read by ecl_sum_columns_fread_alloc():
+
+    file_header
+    column_header[num_columns]
+    chunk_header[num_row_groups * num_columns]
+    string table - '\0' terminated strings
+    column data
+
+  All integers are stored in the native byte order of the writer, the
+  byte_order field is used by the reader to reject files from a
+  machine with a different byte order. The first NUM_TIME_COLUMNS
+  columns are the time axis: TIME as int64 seconds since the epoch,
+  DAYS as double and REPORT_STEP as int32; the rest are the summary
+  vectors as float, i.e. exactly the values stored in the UNSMRY file.
+
+  The rows are split in row groups, and the data of each column is
+  stored as one chunk per row group; the chunk of column c in row group
+  g is chunk_header[g * num_columns + c]. A chunk is either stored as
+  is, or compressed with zlib as one stream; the size field is the
+  uncompressed size in bytes. All chunks start on a COLUMN_ALIGNMENT
+  boundary, so when there is only one row group and no compression the
+  columns can be used directly from a memory mapping of the file.
+*/
+
+const char MAGIC[8] = {'E', 'C', 'L', 'S', 'U', 'M', 'C', '\0'};
+const uint32_t VERSION = 1;
+const uint32_t ENDIAN_MARK = 0x01020304;
+const uint64_t COLUMN_ALIGNMENT = 64;
+const uint32_t NUM_TIME_COLUMNS = 3;
+
+enum data_type : uint32_t {
+    DATA_INT32 = 1,
+    DATA_INT64 = 2,
+    DATA_FLOAT = 3,
+    DATA_DOUBLE = 4
+};
+
+/* The types of the TIME, DAYS and REPORT_STEP columns. */
+const data_type TIME_COLUMN_TYPES[NUM_TIME_COLUMNS] = {DATA_INT64, DATA_DOUBLE,
+                                                       DATA_INT32};
+
+enum compression_type : uint32_t { COMPRESSION_NONE = 0, COMPRESSION_ZLIB = 1 };
+
+enum column_flags : uint32_t {
+    COLUMN_RATE = 1,
+    COLUMN_TOTAL = 2,
+    COLUMN_HISTORICAL = 4
+};
+
+struct file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t num_rows;
+    uint32_t num_columns; /* Including the time axis columns. */
+    uint32_t num_time_columns;
+    uint32_t num_row_groups;
+    uint32_t reserved;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    int64_t start_time;
+};
+
+struct column_header {
+    uint32_t data_type;
+    /* Offsets into the string table. */
+    uint32_t key;
+    uint32_t keyword;
+    uint32_t wgname;
+    uint32_t unit;
+    int32_t num;
+    int32_t var_type;
+    uint32_t flags;
+    float default_value;
+    uint32_t reserved[7];
+};
+
+struct chunk_header {
+    uint64_t offset;
+    uint64_t stored_size;
+    uint64_t size;
+    uint32_t compression;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(file_header) == 64, "Unexpected file_header size");
+static_assert(sizeof(column_header) == 64, "Unexpected column_header size");
+static_assert(sizeof(chunk_header) == 32, "Unexpected chunk_header size");
+
+} // namespace sum_columns
+} // namespace ecl
+
+#endif
@@ -1,6 +1,7 @@
 #include <vector>
 #include <memory>
 #include <array>
+#include <string>
 
 #include <ert/util/vector.hpp>
 
@@ -83,13 +84,19 @@ class unsmry_loader;
 class ecl_sum_file_data {
 
 public:
-    ecl_sum_file_data(const ecl_smspec_type *smspec);
+    ecl_sum_file_data(const ecl_smspec_type *smspec,
+                      const std::string &header_file = "");
     ~ecl_sum_file_data();
     const ecl_smspec_type *smspec() const;
 
     int length_before(time_t end_time) const;
     void get_time(int length, time_t *data);
     void get_data(int params_index, int length, double *data);
+    void get_data(const std::vector<int> &params_indices, int length,
+                  double *data, int time_stride);
+    void get_data_at(const std::vector<int> &time_indices,
+                     const std::vector<int> &params_indices, double *data,
+                     int time_stride);
     int length() const;
     time_t get_data_start() const;
     time_t get_sim_end() const;
@@ -115,21 +122,67 @@ public:
     int report_step_from_time(time_t sim_time) const;
 
     ecl_sum_tstep_type *add_new_tstep(int report_step, double sim_seconds);
+    void stream_open(const char *ecl_case, bool fmt_case, bool unified);
+    void stream_flush(bool sync);
+    bool is_stream() const;
     bool can_write() const;
     void fwrite_unified(fortio_type *fortio) const;
     void fwrite_multiple(const char *ecl_case, bool fmt_case) const;
     bool fread(const stringlist_type *filelist, bool lazy_load,
                int file_options);
+    int refresh();
 
 private:
     const ecl_smspec_type *ecl_smspec;
+    /*
+      The SMSPEC file of the case the data is loaded for; when the
+      smspec is shared between several cases it can differ from the
+      header file of the smspec.
+    */
+    std::string header_file;
 
     TimeIndex index;
     vector_type *data;
 
+    /*
+      The timesteps loaded from file are not stored as ecl_sum_tstep
+      instances, but as one contiguous row major matrix with one row of
+      ecl_smspec_get_params_size() elements per timestep, ordered as the
+      index. The report step and ministep number of each row are stored
+      in separate vectors, the time is in the index. The data vector
+      above is only used for the tsteps created with add_new_tstep().
+    */
+    std::vector<float> params;
+    std::vector<int> params_report;
+    std::vector<int> params_ministep;
+
     std::unique_ptr<ecl::unsmry_loader> loader;
 
+    /*
+      For a unified summary file which has been loaded completely the
+      file name, the offset of the last PARAMS keyword and the report
+      step it belongs to are retained; refresh() will resume reading
+      from there.
+    */
+    std::string unified_file;
+    offset_type last_params_offset = 0;
+    int last_params_report = 0;
+
+    /*
+      State of a streaming writer, see stream_open(); when streaming
+      the tsteps which have been written to disk are released, and the
+      data vector only holds the tsteps which are still pending.
+    */
+    struct stream_type;
+    std::unique_ptr<stream_type> stream;
+
     void append_tstep(ecl_sum_tstep_type *tstep);
+    bool append_params(int report_step, int ministep_nr,
+                       const ecl_kw_type *params_kw, const char *src_file);
+    const float *iget_params(int time_index) const;
+    void sort_params(std::vector<time_t> &sim_time,
+                     std::vector<double> &sim_seconds);
+    void params_to_tsteps();
     void build_index();
     void fwrite_report(int report_step, fortio_type *fortio) const;
     bool check_file(ecl_file_type *ecl_file);
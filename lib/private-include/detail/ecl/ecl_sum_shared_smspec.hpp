@@ -0,0 +1,29 @@
+#ifndef ERT_ECL_SUM_SHARED_SMSPEC_H
+#define ERT_ECL_SUM_SHARED_SMSPEC_H
+
+#include <functional>
+
+#include <ert/ecl/ecl_smspec.hpp>
+#include <ert/ecl/ecl_sum.hpp>
+
+namespace ecl {
+
+/*
+  Called with the SMSPEC header which has just been loaded for a case.
+  The callback takes ownership of the header, and returns the instance
+  the case should use - either the argument itself or an equal header
+  which has been loaded earlier. The returned instance must outlive the
+  ecl_sum instance.
+*/
+typedef std::function<ecl_smspec_type *(ecl_smspec_type *)> share_smspec_ftype;
+
+} // namespace ecl
+
+ecl_sum_type *
+ecl_sum_fread_alloc_case_shared(const char *input_file,
+                                const char *key_join_string,
+                                bool include_restart, bool lazy_load,
+                                int file_options,
+                                const ecl::share_smspec_ftype &share_smspec);
+
+#endif
@@ -8,6 +8,11 @@
 
 namespace ecl {
 
+/*
+  The loader is not thread safe: all the const getters read through the
+  one stream of the UNSMRY file, and the column cache state is updated
+  on demand.
+*/
 class unsmry_loader {
 public:
     unsmry_loader(const ecl_smspec_type *smspec, const std::string &filename,
@@ -15,6 +20,11 @@ public:
     ~unsmry_loader();
 
     std::vector<double> get_vector(int pos) const;
+    std::vector<std::vector<double>>
+    get_vectors(const std::vector<int> &params_indices) const;
+    void get_rows(const std::vector<int> &time_indices,
+                  const std::vector<int> &params_indices, double *data,
+                  int time_stride) const;
     std::vector<double> sim_seconds() const;
     std::vector<time_t> sim_time() const;
     int length() const;
@@ -23,8 +33,12 @@ public:
     double iget_sim_seconds(int time_index) const;
     std::vector<int> report_steps(int offset) const;
     double iget(int time_index, int params_index) const;
+    int refresh();
 
 private:
+    bool column_vector(int pos, std::vector<double> &data) const;
+    void load_columns() const;
+
     int size; //Number of entries in the smspec index
     int time_index;
     int time_seconds;
@@ -34,6 +48,16 @@ private:
     std::array<int, 3> date_index;
     ecl_file_type *file;
     ecl_file_view_type *file_view;
+
+    /*
+      Column major cache file of the PARAMS data, used with the
+      ECL_FILE_COLUMN_CACHE flag. The column_length is the number of
+      timesteps in a valid cache file, and column_failed_length the
+      number of timesteps for which writing the cache failed.
+    */
+    std::string column_file;
+    mutable int column_length = 0;
+    mutable int column_failed_length = -1;
 };
 
 } // namespace ecl
@@ -0,0 +1,73 @@
+#ifndef ERT_SMSPEC_KEY_INDEX_H
+#define ERT_SMSPEC_KEY_INDEX_H
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ert/ecl/smspec_node.hpp>
+
+namespace ecl {
+
+/*
+  Flat open addressing hash table from general key, e.g. "WWCT:OP_1",
+  to smspec_node. The keys are stored in insertion order in the entries
+  vector, and the slots vector holds the full hash and the position in
+  entries; a lookup is then one hash evaluation, typically one probe
+  and one string compare. The hash of a key can be computed up front
+  with hash() and passed to find() for repeated lookups.
+
+  When a separator, i.e. the key join string, is given the keys which
+  contain it are also grouped on the part in front of the first
+  separator, i.e. the VAR in VAR:WGNAME:NUM. That is used by the
+  smspec_key_matcher to restrict patterns like "WOPR:*" to the keys
+  starting with "WOPR:".
+*/
+
+class smspec_key_index {
+public:
+    typedef std::pair<std::string, const smspec_node *> entry_type;
+
+    explicit smspec_key_index(const std::string &separator = "")
+        : key_separator(separator) {}
+
+    static uint64_t hash(const char *key);
+
+    void insert(const char *key, const smspec_node *node);
+    const smspec_node *find(const char *key, uint64_t key_hash) const;
+    const smspec_node *find(const char *key) const {
+        return this->find(key, hash(key));
+    }
+    const entry_type *find_entry(const char *key, uint64_t key_hash) const;
+
+    /*
+      Position in entries() of all the keys starting with @prefix
+      followed by the separator, or nullptr if there are none.
+    */
+    const std::vector<size_t> *prefix_entries(const std::string &prefix) const;
+    const std::string &separator() const { return this->key_separator; }
+
+    const std::vector<entry_type> &entries() const { return this->entry_list; }
+    size_t size() const { return this->entry_list.size(); }
+
+private:
+    struct slot_type {
+        uint64_t hash;
+        size_t entry; /* Position in entry_list + 1; 0 is an empty slot. */
+    };
+
+    void rehash(size_t num_slots);
+    size_t find_slot(const char *key, uint64_t key_hash) const;
+
+    std::string key_separator;
+    std::vector<entry_type> entry_list;
+    std::vector<slot_type> slots;
+    std::unordered_map<std::string, std::vector<size_t>> prefix_index;
+};
+
+} // namespace ecl
+
+#endif
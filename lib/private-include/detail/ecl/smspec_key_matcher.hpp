@@ -0,0 +1,65 @@
+#ifndef ERT_SMSPEC_KEY_MATCHER_H
+#define ERT_SMSPEC_KEY_MATCHER_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "detail/ecl/smspec_key_index.hpp"
+
+namespace ecl {
+
+/*
+  A set of fnmatch() style patterns which have been classified up front
+  to exploit the VAR:WGNAME:NUM structure of the general keys:
+
+    - A pattern without wildcards is a plain hash lookup.
+    - A pattern like "WOPR:OP_*" where the part in front of the first
+      separator is a literal only considers the keys starting with
+      "WOPR:"; when the rest of the pattern is "*" all those keys match
+      and fnmatch() is not called at all.
+    - The remaining patterns are matched with fnmatch() in one common
+      pass over all the keys.
+
+  The matcher does not depend on any particular smspec, so the same
+  instance can be used for all the cases in an ensemble. If the index
+  has been built with a different separator than the matcher all the
+  prefix patterns are just matched with fnmatch().
+*/
+
+class smspec_key_matcher {
+public:
+    smspec_key_matcher(const std::vector<std::string> &patterns,
+                       const std::string &separator);
+
+    /*
+      Returns the positions in index.entries() of all keys matching at
+      least one of the patterns, each key is included only once. The
+      positions come in the order they have been found in.
+    */
+    std::vector<size_t> select(const smspec_key_index &index) const;
+
+private:
+    enum pattern_kind {
+        MATCH_ALL,    /* NULL or "*" - everything except TIME. */
+        MATCH_LITERAL,
+        MATCH_PREFIX, /* Literal prefix, rest is "*". */
+        MATCH_PREFIX_FNMATCH,
+        MATCH_FNMATCH
+    };
+
+    struct pattern_type {
+        pattern_kind kind;
+        std::string pattern;
+        std::string prefix;
+        uint64_t hash;
+    };
+
+    std::string separator;
+    std::vector<pattern_type> pattern_list;
+};
+
+} // namespace ecl
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef ECL_NUMBER_PARSER
+#define ECL_NUMBER_PARSER
+
+namespace ecl {
+namespace util {
+
+/*
+  Will parse a number from the start of the string @s, with the same
+  semantics as strtol() / strtof() / strtod(), i.e. sscanf() with the
+  "%d" and "%g" formats: leading whitespace is not skipped, trailing
+  characters are ignored. Returns a pointer to the first character after
+  the number, or NULL if no number could be parsed.
+*/
+const char *parse_number(const char *s, int *value);
+const char *parse_number(const char *s, float *value);
+const char *parse_number(const char *s, double *value);
+
+} // namespace util
+} // namespace ecl
+
+#endif
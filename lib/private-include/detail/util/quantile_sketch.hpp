@@ -0,0 +1,48 @@
+#ifndef ERT_QUANTILE_SKETCH_H
+#define ERT_QUANTILE_SKETCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace ecl {
+namespace util {
+
+/*
+  Streaming estimate of the quantiles of a sample.
+
+  As long as no more than capacity values have been added the values are
+  stored as they are, and quantile() gives exactly the same result as
+  statistics_empirical_quantile(). Beyond that the sketch is a KLL
+  compactor hierarchy: when a level is full it is sorted and every other
+  value is promoted to the next level with twice the weight. The level
+  capacities decrease geometrically downwards from the top level, so the
+  memory is bounded by roughly 3 * capacity values regardless of the
+  number of values added, and the rank error is of order 1 / capacity.
+*/
+
+class quantile_sketch {
+public:
+    explicit quantile_sketch(int capacity);
+
+    void add(double value);
+    double quantile(double q) const;
+    size_t size() const { return this->count; }
+    bool exact() const { return this->levels.size() == 1; }
+
+private:
+    size_t level_capacity(size_t level) const;
+    void compact(size_t level);
+    double exact_quantile(double q) const;
+
+    int capacity;
+    size_t count = 0;
+    std::vector<std::vector<double>> levels;
+    std::vector<bool> offset;
+};
+
+} // namespace util
+} // namespace ecl
+
+#endif
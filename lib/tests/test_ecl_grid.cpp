@@ -1,7 +1,18 @@
 #include <catch2/catch.hpp>
 #include <ert/ecl/ecl_grid.hpp>
 #include <ert/ecl/ecl_kw.hpp>
+#include <ert/ecl/ecl_endian_flip.hpp>
+#include <ert/ecl/ecl_file.hpp>
 #include <ert/ecl/ecl_kw_magic.hpp>
+#include <ert/ecl/ecl_nnc_export.hpp>
+#include <ert/ecl/ecl_nnc_geometry.hpp>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/nnc_info.hpp>
+#include <ert/ecl/nnc_vector.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <thread>
 #include <vector>
 
 #include "tmpdir.hpp"
@@ -324,3 +335,539 @@ TEST_CASE_METHOD(Tmpdir, "Writing and reading grid", "[unittest]") {
         ecl_grid_free(ecl_grid);
     }
 }
+
+TEST_CASE("Test compact grid geometry", "[unittest]") {
+    GIVEN("A grid with and without compact geometry") {
+        ecl_grid_type *grid =
+            generate_dxv_dyv_dzv_depthz_grid(7, 5, 4, 0.5, 0.25, 2.0);
+        ecl_grid_type *compact_grid =
+            generate_dxv_dyv_dzv_depthz_grid(7, 5, 4, 0.5, 0.25, 2.0);
+
+        REQUIRE(!ecl_grid_has_compact_geometry(compact_grid));
+        ecl_grid_init_compact_geometry(compact_grid);
+        REQUIRE(ecl_grid_has_compact_geometry(compact_grid));
+
+        THEN("The geometry accessors return the same values") {
+            for (int g = 0; g < ecl_grid_get_global_size(grid); g++) {
+                double x1, y1, z1, x2, y2, z2;
+
+                ecl_grid_get_xyz1(grid, g, &x1, &y1, &z1);
+                ecl_grid_get_xyz1(compact_grid, g, &x2, &y2, &z2);
+                REQUIRE(x1 == x2);
+                REQUIRE(y1 == y2);
+                REQUIRE(z1 == z2);
+
+                REQUIRE(ecl_grid_get_cell_volume1(grid, g) ==
+                        ecl_grid_get_cell_volume1(compact_grid, g));
+
+                for (int c = 0; c < 8; c++) {
+                    ecl_grid_get_cell_corner_xyz1(grid, g, c, &x1, &y1, &z1);
+                    ecl_grid_get_cell_corner_xyz1(compact_grid, g, c, &x2, &y2,
+                                                  &z2);
+                    REQUIRE(x1 == x2);
+                    REQUIRE(y1 == y2);
+                    REQUIRE(z1 == z2);
+                }
+            }
+        }
+
+        THEN("The compact geometry can be dropped again") {
+            ecl_grid_free_compact_geometry(compact_grid);
+            REQUIRE(!ecl_grid_has_compact_geometry(compact_grid));
+            REQUIRE(ecl_grid_get_cell_volume1(compact_grid, 0) ==
+                    ecl_grid_get_cell_volume1(grid, 0));
+        }
+
+        ecl_grid_free(compact_grid);
+        ecl_grid_free(grid);
+    }
+}
+
+/**
+ * Reference cell volume: the pre vectorization formula from
+ * ecl_cell_get_volume(), kept here as an independent check of the block
+ * volume kernel.
+ */
+static double reference_C(const double *r, int f1, int f2, int f3) {
+    if (f1 == 0) {
+        if (f2 == 0)
+            return (f3 == 0) ? r[0] : r[4] - r[0];
+        else
+            return (f3 == 0) ? r[2] - r[0] : r[6] + r[0] - r[4] - r[2];
+    } else {
+        if (f2 == 0)
+            return (f3 == 0) ? r[1] - r[0] : r[5] + r[0] - r[4] - r[1];
+        else
+            return (f3 == 0) ? r[3] + r[0] - r[2] - r[1]
+                             : r[7] + r[4] + r[2] + r[1] - r[6] - r[5] -
+                                   r[3] - r[0];
+    }
+}
+
+static double reference_cell_volume(const ecl_grid_type *grid, int g) {
+    double X[8], Y[8], Z[8];
+    for (int c = 0; c < 8; c++)
+        ecl_grid_get_cell_corner_xyz1(grid, g, c, &X[c], &Y[c], &Z[c]);
+
+    double volume = 0;
+    for (int pb = 0; pb <= 1; pb++)
+        for (int pg = 0; pg <= 1; pg++)
+            for (int qa = 0; qa <= 1; qa++)
+                for (int qg = 0; qg <= 1; qg++)
+                    for (int ra = 0; ra <= 1; ra++)
+                        for (int rb = 0; rb <= 1; rb++) {
+                            int divisor =
+                                (qa + ra + 1) * (pb + rb + 1) * (pg + qg + 1);
+                            double dV =
+                                reference_C(X, 1, pb, pg) *
+                                    reference_C(Y, qa, 1, qg) *
+                                    reference_C(Z, ra, rb, 1) -
+                                reference_C(X, 1, pb, pg) *
+                                    reference_C(Z, qa, 1, qg) *
+                                    reference_C(Y, ra, rb, 1) -
+                                reference_C(Y, 1, pb, pg) *
+                                    reference_C(X, qa, 1, qg) *
+                                    reference_C(Z, ra, rb, 1) +
+                                reference_C(Y, 1, pb, pg) *
+                                    reference_C(Z, qa, 1, qg) *
+                                    reference_C(X, ra, rb, 1) +
+                                reference_C(Z, 1, pb, pg) *
+                                    reference_C(X, qa, 1, qg) *
+                                    reference_C(Y, ra, rb, 1) -
+                                reference_C(Z, 1, pb, pg) *
+                                    reference_C(Y, qa, 1, qg) *
+                                    reference_C(X, ra, rb, 1);
+
+                            volume += dV / divisor;
+                        }
+
+    return std::fabs(volume);
+}
+
+TEST_CASE("Test whole grid volume", "[unittest]") {
+    GIVEN("A distorted grid with inactive cells") {
+        /* More than one block of cells per layer. */
+        const int nx = 13, ny = 11, nz = 3;
+        std::vector<float> coord(ECL_GRID_COORD_SIZE(nx, ny));
+        std::vector<float> zcorn(ECL_GRID_ZCORN_SIZE(nx, ny, nz));
+        std::vector<int> actnum(nx * ny * nz);
+
+        for (int j = 0, c = 0; j <= ny; j++)
+            for (int i = 0; i <= nx; i++) {
+                float x = 10.0 * i + (i * j) % 3;
+                float y = 10.0 * j + (i + j) % 4;
+                coord[c++] = x;
+                coord[c++] = y;
+                coord[c++] = 0;
+                coord[c++] = x + 2;
+                coord[c++] = y - 1;
+                coord[c++] = 100;
+            }
+        for (size_t z = 0; z < zcorn.size(); z++)
+            zcorn[z] = 2.0 * (z / (8 * nx * ny)) + 0.1 * (z % 7);
+        for (size_t g = 0; g < actnum.size(); g++)
+            actnum[g] = (g % 5) != 0;
+
+        ecl_grid_type *grid = ecl_grid_alloc_GRDECL_data(
+            nx, ny, nz, zcorn.data(), coord.data(), actnum.data(), false,
+            nullptr);
+
+        THEN("The volumes agree with the reference formula") {
+            ecl_kw_type *global_kw = ecl_grid_alloc_volume_kw(grid, false);
+            ecl_kw_type *active_kw = ecl_grid_alloc_volume_kw(grid, true);
+
+            REQUIRE(ecl_kw_get_size(global_kw) ==
+                    ecl_grid_get_global_size(grid));
+            REQUIRE(ecl_kw_get_size(active_kw) ==
+                    ecl_grid_get_active_size(grid));
+            for (int g = 0; g < ecl_grid_get_global_size(grid); g++) {
+                double volume = reference_cell_volume(grid, g);
+                REQUIRE_THAT(ecl_kw_iget_double(global_kw, g),
+                             WithinAbs(volume, 1e-8));
+                REQUIRE_THAT(ecl_grid_get_cell_volume1(grid, g),
+                             WithinAbs(volume, 1e-8));
+            }
+            for (int a = 0; a < ecl_grid_get_active_size(grid); a++) {
+                int g = ecl_grid_get_global_index1A(grid, a);
+                REQUIRE_THAT(ecl_kw_iget_double(active_kw, a),
+                             WithinAbs(reference_cell_volume(grid, g), 1e-8));
+            }
+
+            ecl_kw_free(global_kw);
+            ecl_kw_free(active_kw);
+        }
+
+        ecl_grid_free(grid);
+    }
+
+    GIVEN("A rectangular grid") {
+        ecl_grid_type *grid =
+            ecl_grid_alloc_rectangular(70, 3, 2, 0.5, 2.0, 4.0, nullptr);
+
+        THEN("The volume keyword holds the cell volumes") {
+            ecl_kw_type *volume_kw = ecl_grid_alloc_volume_kw(grid, false);
+            for (int g = 0; g < ecl_kw_get_size(volume_kw); g++)
+                REQUIRE_THAT(ecl_kw_iget_double(volume_kw, g),
+                             WithinAbs(4.0, 1e-12));
+            ecl_kw_free(volume_kw);
+        }
+
+        ecl_grid_free(grid);
+    }
+}
+
+TEST_CASE("Test finding cell from xyz", "[unittest]") {
+    GIVEN("A grid with a curved top surface") {
+        ecl_grid_type *grid =
+            generate_dxv_dyv_dzv_depthz_grid(9, 7, 5, 0.5, 0.25, 2.0);
+
+        THEN("The cell found is the first cell containing the point") {
+            double x = GENERATE(take(10, random(0.0, 4.5)));
+            double y = GENERATE(take(10, random(0.0, 1.75)));
+            double z = GENERATE(take(5, random(-1.0, 11.0)));
+
+            int expected = -1;
+            for (int g = 0; g < ecl_grid_get_global_size(grid); g++) {
+                if (ecl_grid_cell_contains_xyz1(grid, g, x, y, z)) {
+                    expected = g;
+                    break;
+                }
+            }
+            REQUIRE(ecl_grid_get_global_index_from_xyz(grid, x, y, z, -1) ==
+                    expected);
+            REQUIRE(ecl_grid_get_global_index_from_xyz(grid, x, y, z, 0) ==
+                    expected);
+        }
+
+        THEN("Cell centers are found in their own cell") {
+            for (int g = 0; g < ecl_grid_get_global_size(grid); g++) {
+                double x, y, z;
+                ecl_grid_get_xyz1(grid, g, &x, &y, &z);
+                REQUIRE(ecl_grid_get_global_index_from_xyz(grid, x, y, z, -1) ==
+                        g);
+            }
+        }
+
+        THEN("Points outside the grid are not found") {
+            REQUIRE(ecl_grid_get_global_index_from_xyz(grid, -1, -1, -100,
+                                                       -1) == -1);
+        }
+
+        ecl_grid_free(grid);
+    }
+}
+
+TEST_CASE("Test finding cells from xyz in batch", "[unittest]") {
+    GIVEN("A grid and a trajectory through it") {
+        ecl_grid_type *grid =
+            generate_dxv_dyv_dzv_depthz_grid(9, 7, 5, 0.5, 0.25, 2.0);
+
+        int num_points = 1000;
+        std::vector<double> x(num_points), y(num_points), z(num_points);
+        for (int i = 0; i < num_points; i++) {
+            x[i] = 0.1 + 4.0 * i / num_points;
+            y[i] = 0.2 + 1.5 * i / num_points;
+            z[i] = -0.5 + 11.0 * i / num_points;
+        }
+
+        THEN("The batch lookup agrees with point by point lookup") {
+            std::vector<int> global_index(num_points);
+            ecl_grid_get_global_index_from_xyz_batch(grid, num_points, x.data(),
+                                                     y.data(), z.data(),
+                                                     global_index.data());
+            for (int i = 0; i < num_points; i++)
+                REQUIRE(global_index[i] ==
+                        ecl_grid_get_global_index_from_xyz(grid, x[i], y[i],
+                                                           z[i], -1));
+        }
+
+        ecl_grid_free(grid);
+    }
+}
+
+TEST_CASE("Test concurrent queries on a frozen grid", "[unittest]") {
+    GIVEN("A frozen grid shared by several threads") {
+        ecl_grid_type *reference_grid =
+            generate_dxv_dyv_dzv_depthz_grid(12, 9, 4, 0.5, 0.25, 2.0);
+        ecl_grid_type *grid =
+            generate_dxv_dyv_dzv_depthz_grid(12, 9, 4, 0.5, 0.25, 2.0);
+        const int size = ecl_grid_get_global_size(grid);
+        ecl_grid_freeze(grid);
+
+        THEN("All threads get the same results as a serial query") {
+            const int num_threads = 4;
+            /* Every thread visits all the cells, each in its own order;
+               the strides are coprime to the grid size. */
+            const int stride[num_threads] = {1, 5, 7, 11};
+            for (int t = 0; t < num_threads; t++)
+                REQUIRE(std::gcd(stride[t], size) == 1);
+            std::vector<std::vector<double>> xyz(num_threads);
+            std::vector<std::vector<int>> cells(num_threads);
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < num_threads; t++)
+                threads.emplace_back([&, t]() {
+                    for (int n = 0; n < size; n++) {
+                        int g = (n * stride[t]) % size;
+                        double x, y, z;
+                        ecl_grid_get_xyz1(grid, g, &x, &y, &z);
+                        xyz[t].push_back(x);
+                        xyz[t].push_back(y);
+                        xyz[t].push_back(z);
+                        xyz[t].push_back(ecl_grid_get_cell_volume1(grid, g));
+                        cells[t].push_back(ecl_grid_get_global_index_from_xyz(
+                            grid, x, y, z, -1));
+                    }
+                });
+            for (auto &thread : threads)
+                thread.join();
+
+            for (int t = 0; t < num_threads; t++) {
+                for (int n = 0; n < size; n++) {
+                    int g = (n * stride[t]) % size;
+                    double x, y, z;
+                    ecl_grid_get_xyz1(reference_grid, g, &x, &y, &z);
+                    REQUIRE(xyz[t][4 * n] == x);
+                    REQUIRE(xyz[t][4 * n + 1] == y);
+                    REQUIRE(xyz[t][4 * n + 2] == z);
+                    REQUIRE(xyz[t][4 * n + 3] ==
+                            ecl_grid_get_cell_volume1(reference_grid, g));
+                    REQUIRE(cells[t][n] ==
+                            ecl_grid_get_global_index_from_xyz(
+                                reference_grid, x, y, z, -1));
+                }
+            }
+        }
+
+        ecl_grid_free(grid);
+        ecl_grid_free(reference_grid);
+    }
+}
+
+static void fwrite_int_kw(fortio_type *fortio, const char *header,
+                          const std::vector<int> &data) {
+    ecl_kw_type *kw = ecl_kw_alloc_new(header, data.size(), ECL_INT,
+                                       data.data());
+    ecl_kw_fwrite(kw, fortio);
+    ecl_kw_free(kw);
+}
+
+static void fwrite_string_kw(fortio_type *fortio, const char *header,
+                             const char *value) {
+    ecl_kw_type *kw = ecl_kw_alloc(header, 1, ECL_CHAR);
+    ecl_kw_iset_string8(kw, 0, value);
+    ecl_kw_fwrite(kw, fortio);
+    ecl_kw_free(kw);
+}
+
+/*
+  Appends a 2x2x2 LGR, with all cells in host cell @host_cell of
+  @parent, and @num_nnc connections to the main grid.
+*/
+static void fwrite_lgr(fortio_type *fortio, int lgr_nr, const char *parent,
+                       int host_cell, int num_nnc) {
+    ecl_grid_type *lgr = ecl_grid_alloc_rectangular(2, 2, 2, 1, 1, 1, nullptr);
+    char name[9];
+    snprintf(name, sizeof name, "LGR%d", lgr_nr);
+
+    fwrite_string_kw(fortio, LGR_KW, name);
+    fwrite_string_kw(fortio, LGR_PARENT_KW, parent);
+    {
+        ecl_kw_type *gridhead_kw = ecl_grid_alloc_gridhead_kw(2, 2, 2, lgr_nr);
+        ecl_kw_type *coord_kw = ecl_grid_alloc_coord_kw(lgr);
+        ecl_kw_type *zcorn_kw = ecl_grid_alloc_zcorn_kw(lgr);
+        ecl_kw_type *actnum_kw = ecl_grid_alloc_actnum_kw(lgr);
+        ecl_kw_fwrite(gridhead_kw, fortio);
+        ecl_kw_fwrite(coord_kw, fortio);
+        ecl_kw_fwrite(zcorn_kw, fortio);
+        ecl_kw_fwrite(actnum_kw, fortio);
+        ecl_kw_free(gridhead_kw);
+        ecl_kw_free(coord_kw);
+        ecl_kw_free(zcorn_kw);
+        ecl_kw_free(actnum_kw);
+    }
+    fwrite_int_kw(fortio, HOSTNUM_KW, std::vector<int>(8, host_cell + 1));
+    fwrite_int_kw(fortio, ENDGRID_KW, {});
+    fwrite_int_kw(fortio, ENDLGR_KW, {});
+
+    std::vector<int> nnchead(NNCHEAD_SIZE, 0);
+    nnchead[NNCHEAD_NUMNNC_INDEX] = num_nnc;
+    nnchead[NNCHEAD_LGR_INDEX] = lgr_nr;
+    std::vector<int> nncg, nncl;
+    for (int i = 0; i < num_nnc; i++) {
+        nncg.push_back(1 + (i * 5) % 32);
+        nncl.push_back(1 + i % 8);
+    }
+    fwrite_int_kw(fortio, NNCHEAD_KW, nnchead);
+    fwrite_int_kw(fortio, NNCG_KW, nncg);
+    fwrite_int_kw(fortio, NNCL_KW, nncl);
+    ecl_grid_free(lgr);
+}
+
+static void require_nnc(const ecl_grid_type *grid, int cell, int lgr_nr,
+                        const std::vector<std::pair<int, int>> &expected) {
+    const nnc_info_type *nnc_info = ecl_grid_get_cell_nnc_info1(grid, cell);
+    REQUIRE(nnc_info);
+    const nnc_vector_type *nnc_vector = nnc_info_get_vector(nnc_info, lgr_nr);
+    REQUIRE(nnc_vector);
+    REQUIRE(nnc_vector_get_size(nnc_vector) == (int)expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        REQUIRE(nnc_vector_iget_grid_index(nnc_vector, i) ==
+                expected[i].first);
+        REQUIRE(nnc_vector_iget_nnc_index(nnc_vector, i) ==
+                expected[i].second);
+    }
+}
+
+TEST_CASE_METHOD(Tmpdir, "Loading grid with LGRs and NNCs", "[unittest]") {
+    GIVEN("An EGRID file with nested LGRs and non neighbour connections") {
+        auto filename = (dirname / "LGR.EGRID");
+        const int num_self_nnc = 1000;
+        const int num_lgr_nnc = 50;
+        {
+            ecl_grid_type *grid =
+                ecl_grid_alloc_rectangular(4, 4, 2, 1, 1, 1, nullptr);
+            for (int i = 0; i < num_self_nnc; i++)
+                ecl_grid_add_self_nnc(grid, i % 32, (i * 7) % 32, i);
+            ecl_grid_fwrite_EGRID2(grid, filename.c_str(), ECL_METRIC_UNITS);
+            ecl_grid_free(grid);
+        }
+        {
+            fortio_type *fortio =
+                fortio_open_append(filename.c_str(), false, ECL_ENDIAN_FLIP);
+            fwrite_lgr(fortio, 1, "", 5, num_lgr_nnc);
+            fwrite_lgr(fortio, 2, "LGR1", 3, num_lgr_nnc);
+            fwrite_lgr(fortio, 3, "", 20, num_lgr_nnc);
+
+            std::vector<int> nncheada(NNCHEAD_SIZE, 0);
+            nncheada[NNCHEADA_ILOC1_INDEX] = 1;
+            nncheada[NNCHEADA_ILOC2_INDEX] = 3;
+            fwrite_int_kw(fortio, NNCHEADA_KW, nncheada);
+            fwrite_int_kw(fortio, NNA1_KW, {1, 1, 2});
+            fwrite_int_kw(fortio, NNA2_KW, {8, 7, 6});
+            fortio_fclose(fortio);
+        }
+
+        ecl_grid_type *grid = ecl_grid_alloc(filename.c_str());
+        REQUIRE(ecl_grid_get_num_lgr(grid) == 3);
+
+        THEN("The LGRs are installed in their host grids") {
+            const ecl_grid_type *lgr1 = ecl_grid_get_lgr(grid, "LGR1");
+            const ecl_grid_type *lgr2 = ecl_grid_get_lgr(grid, "LGR2");
+            const ecl_grid_type *lgr3 = ecl_grid_get_lgr(grid, "LGR3");
+            REQUIRE(ecl_grid_get_lgr_nr(lgr1) == 1);
+            REQUIRE(ecl_grid_get_lgr_nr(lgr2) == 2);
+            REQUIRE(ecl_grid_get_lgr_nr(lgr3) == 3);
+            REQUIRE(ecl_grid_get_cell_lgr1(grid, 5) == lgr1);
+            REQUIRE(ecl_grid_get_cell_lgr1(grid, 20) == lgr3);
+            REQUIRE(ecl_grid_get_cell_lgr1(lgr1, 3) == lgr2);
+            REQUIRE(ecl_grid_get_parent_cell1(lgr2, 0) == 3);
+        }
+
+        THEN("A copy of the grid keeps the LGR numbers") {
+            ecl_grid_type *copy = ecl_grid_alloc_copy(grid);
+            REQUIRE(ecl_grid_get_lgr_nr(copy) == 0);
+            for (int lgr_nr = 1; lgr_nr <= 3; lgr_nr++) {
+                const char *name = ecl_grid_get_lgr_name(grid, lgr_nr);
+                REQUIRE(ecl_grid_get_lgr_nr(ecl_grid_get_lgr(copy, name)) ==
+                        lgr_nr);
+                REQUIRE(ecl_grid_get_lgr_nr_from_name(copy, name) == lgr_nr);
+            }
+            ecl_grid_free(copy);
+        }
+
+        THEN("The connections of each cell are in file order") {
+            for (int cell = 0; cell < 32; cell++) {
+                std::vector<std::pair<int, int>> self, lgr1;
+                for (int i = 0; i < num_self_nnc; i++)
+                    if (i % 32 == cell)
+                        self.push_back({(i * 7) % 32, i});
+                for (int i = 0; i < num_lgr_nnc; i++)
+                    if ((i * 5) % 32 == cell)
+                        lgr1.push_back({i % 8, i});
+
+                require_nnc(grid, cell, 0, self);
+                if (!lgr1.empty()) {
+                    require_nnc(grid, cell, 1, lgr1);
+                    require_nnc(grid, cell, 2, lgr1);
+                    require_nnc(grid, cell, 3, lgr1);
+                }
+            }
+
+            const ecl_grid_type *lgr1 = ecl_grid_get_lgr(grid, "LGR1");
+            require_nnc(lgr1, 0, 3, {{7, 0}, {6, 1}});
+            require_nnc(lgr1, 1, 3, {{5, 2}});
+        }
+
+        THEN("CSR NNC storage gives the same connections") {
+            auto init_filename = (dirname / "LGR.INIT");
+            {
+                ecl_kw_type *trannnc_kw =
+                    ecl_kw_alloc(TRANNNC_KW, num_self_nnc, ECL_FLOAT);
+                for (int i = 0; i < num_self_nnc; i++)
+                    ecl_kw_iset_float(trannnc_kw, i, 0.5 * i);
+                fortio_type *fortio = fortio_open_writer(
+                    init_filename.c_str(), false, ECL_ENDIAN_FLIP);
+                ecl_kw_fwrite(trannnc_kw, fortio);
+                fortio_fclose(fortio);
+                ecl_kw_free(trannnc_kw);
+            }
+            ecl_file_type *init_file =
+                ecl_file_open(init_filename.c_str(), 0);
+            ecl_grid_type *copy = ecl_grid_alloc_copy(grid);
+            int num_nnc = ecl_grid_get_num_nnc(grid);
+
+            ecl_grid_init_compact_nnc(copy);
+            REQUIRE(ecl_grid_has_compact_nnc(copy));
+            REQUIRE(ecl_grid_has_compact_nnc(ecl_grid_get_lgr(copy, "LGR2")));
+            REQUIRE(ecl_grid_get_num_nnc(copy) == num_nnc);
+
+            std::vector<ecl_nnc_type> nnc_data(num_nnc);
+            std::vector<ecl_nnc_type> csr_nnc_data(num_nnc);
+            REQUIRE(ecl_nnc_export(grid, init_file, nnc_data.data()) ==
+                    num_self_nnc);
+            REQUIRE(ecl_nnc_export(copy, init_file, csr_nnc_data.data()) ==
+                    num_self_nnc);
+            /* The export is only sorted on the cell pairs, and the test
+               grid has repeated pairs. */
+            auto nnc_cmp = [](const ecl_nnc_type &nnc1,
+                              const ecl_nnc_type &nnc2) {
+                int cmp = ecl_nnc_sort_cmp(&nnc1, &nnc2);
+                return cmp < 0 ||
+                       (cmp == 0 && nnc1.input_index < nnc2.input_index);
+            };
+            std::sort(nnc_data.begin(), nnc_data.end(), nnc_cmp);
+            std::sort(csr_nnc_data.begin(), csr_nnc_data.end(), nnc_cmp);
+            for (int i = 0; i < num_nnc; i++)
+                REQUIRE(ecl_nnc_equal(&nnc_data[i], &csr_nnc_data[i]));
+
+            ecl_nnc_geometry_type *nnc_geo = ecl_nnc_geometry_alloc(grid);
+            ecl_nnc_geometry_type *csr_nnc_geo = ecl_nnc_geometry_alloc(copy);
+            REQUIRE(ecl_nnc_geometry_size(nnc_geo) == num_nnc);
+            REQUIRE(ecl_nnc_geometry_size(csr_nnc_geo) == num_nnc);
+            for (int i = 0; i < num_nnc; i++) {
+                const ecl_nnc_pair_type *pair =
+                    ecl_nnc_geometry_iget(nnc_geo, i);
+                const ecl_nnc_pair_type *csr_pair =
+                    ecl_nnc_geometry_iget(csr_nnc_geo, i);
+                REQUIRE(pair->grid_nr1 == csr_pair->grid_nr1);
+                REQUIRE(pair->grid_nr2 == csr_pair->grid_nr2);
+                REQUIRE(pair->global_index1 == csr_pair->global_index1);
+                REQUIRE(pair->global_index2 == csr_pair->global_index2);
+            }
+
+            REQUIRE(ecl_grid_compare(grid, copy, true, true, false));
+
+            ecl_grid_free_compact_nnc(copy);
+            REQUIRE_FALSE(ecl_grid_has_compact_nnc(copy));
+            REQUIRE(ecl_grid_compare(grid, copy, true, true, false));
+
+            ecl_nnc_geometry_free(nnc_geo);
+            ecl_nnc_geometry_free(csr_nnc_geo);
+            ecl_grid_free(copy);
+            ecl_file_close(init_file);
+        }
+
+        ecl_grid_free(grid);
+    }
+}
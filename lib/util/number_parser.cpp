@@ -0,0 +1,184 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "detail/util/number_parser.hpp"
+
+namespace ecl {
+namespace util {
+
+namespace {
+
+const double powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                1e18, 1e19, 1e20, 1e21, 1e22};
+
+const int max_exact_power = 22;
+const uint64_t max_exact_mantissa = uint64_t(1) << 53;
+const int max_mantissa_digits = 19;
+
+bool is_digit(char c) { return (c >= '0' && c <= '9'); }
+
+/*
+  Fast path for plain decimal numbers like "-1234.5678" and "1.5e-3".
+  When the significand fits exactly in a double, and the power of ten is
+  exactly representable as a double, one multiplication or division
+  gives the correctly rounded result - i.e. the same result as strtod().
+  For everything else NULL is returned, and the caller must fall back to
+  strtod().
+*/
+const char *parse_decimal(const char *s, double *value) {
+    const char *p = s;
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        p++;
+    }
+
+    /* Hexadecimal floating point input is left for strtod(). */
+    if (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+        return NULL;
+
+    uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+
+    for (; is_digit(*p); p++) {
+        has_digits = true;
+        if (mantissa == 0 && *p == '0')
+            continue;
+
+        if (num_digits == max_mantissa_digits)
+            return NULL;
+
+        mantissa = 10 * mantissa + (*p - '0');
+        num_digits++;
+    }
+
+    if (*p == '.') {
+        for (p++; is_digit(*p); p++) {
+            has_digits = true;
+            if (mantissa == 0 && *p == '0') {
+                exponent--;
+                continue;
+            }
+
+            if (num_digits == max_mantissa_digits)
+                return NULL;
+
+            mantissa = 10 * mantissa + (*p - '0');
+            num_digits++;
+            exponent--;
+        }
+    }
+
+    if (!has_digits)
+        return NULL;
+
+    if (*p == 'e' || *p == 'E') {
+        const char *q = p + 1;
+        bool negative_exponent = false;
+        if (*q == '-' || *q == '+') {
+            negative_exponent = (*q == '-');
+            q++;
+        }
+
+        if (is_digit(*q)) {
+            int e = 0;
+            for (; is_digit(*q); q++) {
+                if (e < 10000)
+                    e = 10 * e + (*q - '0');
+            }
+            exponent += negative_exponent ? -e : e;
+            p = q;
+        }
+    }
+
+    double d = 0;
+    if (mantissa != 0) {
+        if (mantissa > max_exact_mantissa || exponent > max_exact_power ||
+            exponent < -max_exact_power)
+            return NULL;
+
+        d = (double)mantissa;
+        if (exponent < 0)
+            d /= powers_of_ten[-exponent];
+        else
+            d *= powers_of_ten[exponent];
+    }
+
+    *value = negative ? -d : d;
+    return p;
+}
+
+/*
+  Returns true if @d is exactly halfway between two adjacent float
+  values; converting such a double to float can give a different
+  result than converting the original decimal string directly.
+*/
+bool is_float_midpoint(double d) {
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof bits);
+
+    const uint64_t low_bits = (uint64_t(1) << 29) - 1;
+    return (bits & low_bits) == (uint64_t(1) << 28);
+}
+
+} // namespace
+
+const char *parse_number(const char *s, int *value) {
+    const char *p = s;
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        p++;
+    }
+
+    if (!is_digit(*p))
+        return NULL;
+
+    long long result = 0;
+    for (; is_digit(*p); p++) {
+        result = 10 * result + (*p - '0');
+        if (result > (long long)INT_MAX + 1)
+            return NULL;
+    }
+
+    if (negative)
+        result = -result;
+
+    if (result > INT_MAX || result < INT_MIN)
+        return NULL;
+
+    *value = (int)result;
+    return p;
+}
+
+const char *parse_number(const char *s, double *value) {
+    const char *end = parse_decimal(s, value);
+    if (end)
+        return end;
+
+    char *strtod_end;
+    *value = strtod(s, &strtod_end);
+    return (strtod_end == s) ? NULL : strtod_end;
+}
+
+const char *parse_number(const char *s, float *value) {
+    double d;
+    const char *end = parse_decimal(s, &d);
+    if (end && !is_float_midpoint(d)) {
+        *value = (float)d;
+        return end;
+    }
+
+    char *strtof_end;
+    *value = strtof(s, &strtof_end);
+    return (strtof_end == s) ? NULL : strtof_end;
+}
+
+} // namespace util
+} // namespace ecl
@@ -0,0 +1,137 @@
+#include <math.h>
+
+#include <algorithm>
+#include <utility>
+
+#include <ert/util/util.h>
+#include <ert/util/double_vector.hpp>
+#include <ert/util/statistics.hpp>
+
+#include "detail/util/quantile_sketch.hpp"
+
+/* Ratio between the capacities of two neighbouring levels. */
+#define QUANTILE_SKETCH_LEVEL_RATIO (2.0 / 3.0)
+#define QUANTILE_SKETCH_MIN_LEVEL_CAPACITY 8
+
+namespace ecl {
+namespace util {
+
+quantile_sketch::quantile_sketch(int capacity)
+    : capacity(std::max(capacity, QUANTILE_SKETCH_MIN_LEVEL_CAPACITY)),
+      levels(1), offset(1, false) {}
+
+size_t quantile_sketch::level_capacity(size_t level) const {
+    size_t depth = this->levels.size() - 1 - level;
+    size_t level_capacity =
+        ceil(this->capacity * pow(QUANTILE_SKETCH_LEVEL_RATIO, depth));
+    return std::max(level_capacity,
+                    size_t(QUANTILE_SKETCH_MIN_LEVEL_CAPACITY));
+}
+
+/*
+  Sorts the level and promotes every other value to the next level; the
+  start position alternates between compactions to avoid a systematic
+  bias. With an odd number of values the largest is left behind.
+*/
+void quantile_sketch::compact(size_t level) {
+    if (level + 1 == this->levels.size()) {
+        this->levels.emplace_back();
+        this->offset.push_back(false);
+    }
+
+    std::vector<double> &values = this->levels[level];
+    std::vector<double> &next = this->levels[level + 1];
+    size_t num_compact = values.size() & ~size_t(1);
+
+    std::sort(values.begin(), values.end());
+    for (size_t i = this->offset[level]; i < num_compact; i += 2)
+        next.push_back(values[i]);
+
+    this->offset[level] = !this->offset[level];
+    values.erase(values.begin(), values.begin() + num_compact);
+}
+
+void quantile_sketch::add(double value) {
+    this->levels[0].push_back(value);
+    this->count++;
+
+    for (size_t level = 0; level < this->levels.size(); level++)
+        if (this->levels[level].size() > this->level_capacity(level))
+            this->compact(level);
+}
+
+/*
+  Selection based implementation of statistics_empirical_quantile(); the
+  two order statistics around the quantile are found with nth_element().
+  Ties are rare for continuous data, and then we fall back to sorting
+  and the original implementation.
+*/
+double quantile_sketch::exact_quantile(double q) const {
+    std::vector<double> data = this->levels[0];
+    const int size = data.size() - 1;
+    if (size == 0)
+        return data[0];
+
+    double real_index = q * size;
+    int lower_index = floor(real_index);
+    int upper_index = ceil(real_index);
+
+    auto lower = data.begin() + lower_index;
+    std::nth_element(data.begin(), lower, data.end());
+    double lower_value = *lower;
+    double upper_value = lower_value;
+
+    if (lower_index < size) {
+        upper_index = std::max(upper_index, lower_index + 1);
+        upper_value = *std::min_element(lower + 1, data.end());
+    } else {
+        lower_index--;
+        lower_value = *std::max_element(data.begin(), lower);
+    }
+
+    if (upper_value == lower_value) {
+        double_vector_type *values = double_vector_alloc(0, 0);
+        double_vector_memcpy_from_data(values, data.data(), data.size());
+        double value = statistics_empirical_quantile(values, q);
+        double_vector_free(values);
+        return value;
+    }
+
+    double upper_quantile = upper_index * 1.0 / size;
+    double lower_quantile = lower_index * 1.0 / size;
+    double a = (upper_value - lower_value) / (upper_quantile - lower_quantile);
+    return lower_value + a * (q - lower_quantile);
+}
+
+double quantile_sketch::quantile(double q) const {
+    if ((q < 0) || (q > 1.0))
+        util_abort("%s: quantile must be in [0,1] \n", __func__);
+
+    if (this->count == 0)
+        return NAN;
+
+    if (this->exact())
+        return this->exact_quantile(q);
+
+    std::vector<std::pair<double, uint64_t>> weighted;
+    for (size_t level = 0; level < this->levels.size(); level++)
+        for (double value : this->levels[level])
+            weighted.emplace_back(value, uint64_t(1) << level);
+    std::sort(weighted.begin(), weighted.end());
+
+    uint64_t total_weight = 0;
+    for (const auto &item : weighted)
+        total_weight += item.second;
+
+    double rank = q * (total_weight - 1);
+    uint64_t weight = 0;
+    for (const auto &item : weighted) {
+        weight += item.second;
+        if (weight > rank)
+            return item.first;
+    }
+    return weighted.back().first;
+}
+
+} // namespace util
+} // namespace ecl
@@ -0,0 +1,69 @@
+/*
+   Copyright (C) 2023  Equinor ASA, Norway.
+
+   The file 'ert_util_endian_flip.cpp' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <string.h>
+
+#include <vector>
+
+#include <ert/util/util.h>
+#include <ert/util/test_util.hpp>
+
+/*
+  Compare the (possibly vectorized) flip functions with a byte by byte
+  reversal, for a range of lengths and misaligned start addresses so
+  that both the vector body and the scalar tail are exercised.
+*/
+
+static void reference_flip(char *target, const char *src, int element_size,
+                           int elements) {
+    for (int i = 0; i < elements; i++)
+        for (int j = 0; j < element_size; j++)
+            target[i * element_size + j] =
+                src[i * element_size + element_size - 1 - j];
+}
+
+static void test_flip(int element_size, int elements, int misalign) {
+    size_t bytes = element_size * elements;
+    std::vector<char> src(bytes + misalign);
+    std::vector<char> expected(bytes);
+    std::vector<char> target(bytes + misalign);
+
+    for (size_t i = 0; i < src.size(); i++)
+        src[i] = (char)(i * 7 + 3);
+
+    reference_flip(expected.data(), &src[misalign], element_size, elements);
+
+    util_endian_flip_copy_vector(&target[misalign], &src[misalign],
+                                 element_size, elements);
+    test_assert_int_equal(
+        memcmp(&target[misalign], expected.data(), bytes), 0);
+
+    util_endian_flip_vector(&src[misalign], element_size, elements);
+    test_assert_int_equal(memcmp(&src[misalign], expected.data(), bytes), 0);
+}
+
+int main(int argc, char **argv) {
+    const int element_sizes[] = {1, 2, 4, 8};
+    for (int element_size : element_sizes)
+        for (int elements = 0; elements < 80; elements++)
+            for (int misalign = 0; misalign < 3; misalign++)
+                test_flip(element_size, elements, misalign);
+
+    test_flip(4, 1000, 0);
+    test_flip(8, 1000, 1);
+    exit(0);
+}
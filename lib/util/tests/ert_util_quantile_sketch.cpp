@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <ert/util/test_util.hpp>
+#include <ert/util/double_vector.hpp>
+#include <ert/util/statistics.hpp>
+
+#include "detail/util/quantile_sketch.hpp"
+
+/*
+  As long as the sketch is exact the result should be identical to
+  statistics_empirical_quantile(), also when there are ties.
+*/
+void test_exact(int size, int num_distinct) {
+    std::mt19937 rng(size);
+    std::uniform_int_distribution<int> dist(0, num_distinct - 1);
+    ecl::util::quantile_sketch sketch(size);
+    double_vector_type *data = double_vector_alloc(0, 0);
+
+    for (int i = 0; i < size; i++) {
+        double value = dist(rng) * 0.25;
+        sketch.add(value);
+        double_vector_append(data, value);
+    }
+    test_assert_true(sketch.exact());
+    test_assert_int_equal(sketch.size(), size);
+
+    for (int i = 0; i <= 20; i++) {
+        double q = i * 0.05;
+        double expected = statistics_empirical_quantile(data, q);
+        test_assert_double_equal(sketch.quantile(q), expected);
+    }
+    double_vector_free(data);
+}
+
+void test_approximate() {
+    const int size = 100000;
+    const int capacity = 100;
+    std::vector<double> values(size);
+    for (int i = 0; i < size; i++)
+        values[i] = i;
+    std::shuffle(values.begin(), values.end(), std::mt19937(1));
+
+    ecl::util::quantile_sketch sketch(capacity);
+    for (double value : values)
+        sketch.add(value);
+    test_assert_false(sketch.exact());
+
+    for (double q : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+        double rank = sketch.quantile(q);
+        test_assert_true(fabs(rank - q * (size - 1)) < 0.03 * size);
+    }
+}
+
+int main(int argc, char **argv) {
+    test_assert_true(isnan(ecl::util::quantile_sketch(10).quantile(0.5)));
+    test_exact(1, 1);
+    test_exact(2, 2);
+    test_exact(10, 1);
+    test_exact(50, 5);
+    test_exact(99, 1000);
+    test_exact(200, 1000000);
+    test_approximate();
+    exit(0);
+}
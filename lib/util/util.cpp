@@ -118,7 +118,7 @@
      ((var << 40) & 0x00ff000000000000) | ((var << 56) & 0xff00000000000000))
 
 static uint16_t util_endian_convert16(uint16_t u) {
-    return ((u >> 8U) & 0xFFU) | ((u & 0xFFU) >> 8U);
+    return ((u >> 8U) & 0xFFU) | ((u & 0xFFU) << 8U);
 }
 
 static uint32_t util_endian_convert32(uint32_t u) {
@@ -150,54 +150,200 @@ static uint64_t util_endian_convert32_64(uint64_t u) {
     return u;
 }
 
-void util_endian_flip_vector(void *data, int element_size, int elements) {
-    int i;
+/*
+   Fused "byte swap + copy" kernels for 4 and 8 byte elements; used by
+   util_endian_flip_copy_vector() and util_endian_flip_vector(). The
+   kernels are called with either non-overlapping or identical source
+   and target, and neither of them need to be aligned.
+
+   On x86 the SSSE3 / AVX2 versions are selected at runtime based on
+   the capabilities of the CPU; on all other platforms - and on x86
+   CPUs without SSSE3 - the scalar versions are used.
+*/
+
+typedef void(util_endian_kernel_ftype)(char *, const char *, size_t);
+
+static void util_endian_flip_copy32_scalar(char *target, const char *src,
+                                           size_t elements) {
+    size_t i = 0;
+#ifdef ARCH64
+    /*
+      On a 64 bit CPU the fastest scalar way to swap 32 bit variables
+      is to swap two elements in one operation with
+      util_endian_convert32_64().
+    */
+    for (; i + 2 <= elements; i += 2) {
+        uint64_t u;
+        memcpy(&u, &src[4 * i], sizeof u);
+        u = util_endian_convert32_64(u);
+        memcpy(&target[4 * i], &u, sizeof u);
+    }
+#endif
+    for (; i < elements; i++) {
+        uint32_t u;
+        memcpy(&u, &src[4 * i], sizeof u);
+        u = util_endian_convert32(u);
+        memcpy(&target[4 * i], &u, sizeof u);
+    }
+}
+
+static void util_endian_flip_copy64_scalar(char *target, const char *src,
+                                           size_t elements) {
+    for (size_t i = 0; i < elements; i++) {
+        uint64_t u;
+        memcpy(&u, &src[8 * i], sizeof u);
+        u = util_endian_convert64(u);
+        memcpy(&target[8 * i], &u, sizeof u);
+    }
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTIL_ENDIAN_X86_KERNELS
+#include <immintrin.h>
+
+__attribute__((target("ssse3"))) static void
+util_endian_flip_copy_ssse3(char *target, const char *src, size_t bytes,
+                            __m128i mask) {
+    size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)&src[i]);
+        _mm_storeu_si128((__m128i *)&target[i], _mm_shuffle_epi8(v, mask));
+    }
+}
+
+__attribute__((target("ssse3"))) static void
+util_endian_flip_copy32_ssse3(char *target, const char *src, size_t elements) {
+    const __m128i mask =
+        _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    size_t head = elements - elements % 4;
+    util_endian_flip_copy_ssse3(target, src, 4 * head, mask);
+    util_endian_flip_copy32_scalar(&target[4 * head], &src[4 * head],
+                                   elements - head);
+}
+
+__attribute__((target("ssse3"))) static void
+util_endian_flip_copy64_ssse3(char *target, const char *src, size_t elements) {
+    const __m128i mask =
+        _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    size_t head = elements - elements % 2;
+    util_endian_flip_copy_ssse3(target, src, 8 * head, mask);
+    util_endian_flip_copy64_scalar(&target[8 * head], &src[8 * head],
+                                   elements - head);
+}
+
+__attribute__((target("avx2"))) static void
+util_endian_flip_copy_avx2(char *target, const char *src, size_t bytes,
+                           __m256i mask) {
+    size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        __m256i v0 = _mm256_loadu_si256((const __m256i *)&src[i]);
+        __m256i v1 = _mm256_loadu_si256((const __m256i *)&src[i + 32]);
+        _mm256_storeu_si256((__m256i *)&target[i],
+                            _mm256_shuffle_epi8(v0, mask));
+        _mm256_storeu_si256((__m256i *)&target[i + 32],
+                            _mm256_shuffle_epi8(v1, mask));
+    }
+    for (; i + 32 <= bytes; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)&src[i]);
+        _mm256_storeu_si256((__m256i *)&target[i],
+                            _mm256_shuffle_epi8(v, mask));
+    }
+}
+
+__attribute__((target("avx2"))) static void
+util_endian_flip_copy32_avx2(char *target, const char *src, size_t elements) {
+    const __m256i mask = _mm256_setr_epi8(
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6,
+        5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    size_t head = elements - elements % 8;
+    util_endian_flip_copy_avx2(target, src, 4 * head, mask);
+    util_endian_flip_copy32_scalar(&target[4 * head], &src[4 * head],
+                                   elements - head);
+}
+
+__attribute__((target("avx2"))) static void
+util_endian_flip_copy64_avx2(char *target, const char *src, size_t elements) {
+    const __m256i mask = _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2,
+        1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    size_t head = elements - elements % 4;
+    util_endian_flip_copy_avx2(target, src, 8 * head, mask);
+    util_endian_flip_copy64_scalar(&target[8 * head], &src[8 * head],
+                                   elements - head);
+}
+#endif
+
+static util_endian_kernel_ftype *util_endian_select_kernel(int element_size) {
+#ifdef UTIL_ENDIAN_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return (element_size == 4) ? util_endian_flip_copy32_avx2
+                                   : util_endian_flip_copy64_avx2;
+
+    if (__builtin_cpu_supports("ssse3"))
+        return (element_size == 4) ? util_endian_flip_copy32_ssse3
+                                   : util_endian_flip_copy64_ssse3;
+#endif
+    return (element_size == 4) ? util_endian_flip_copy32_scalar
+                               : util_endian_flip_copy64_scalar;
+}
+
+static void util_endian_flip_copy32(char *target, const char *src,
+                                    size_t elements) {
+    static util_endian_kernel_ftype *kernel = util_endian_select_kernel(4);
+    kernel(target, src, elements);
+}
+
+static void util_endian_flip_copy64(char *target, const char *src,
+                                    size_t elements) {
+    static util_endian_kernel_ftype *kernel = util_endian_select_kernel(8);
+    kernel(target, src, elements);
+}
+
+/**
+   Will copy @elements elements of size @element_size from @src to
+   @target, and endian flip them on the way. This is equivalent to a
+   memcpy() followed by util_endian_flip_vector() on the target, but
+   the data is only passed through memory once. The @src and @target
+   buffers can not overlap, unless they are identical.
+*/
+
+void util_endian_flip_copy_vector(void *target, const void *src,
+                                  int element_size, int elements) {
     switch (element_size) {
     case (1):
+        if (target != src)
+            memcpy(target, src, elements);
         break;
     case (2): {
-        uint16_t *tmp16 = (uint16_t *)data;
+        uint16_t *target16 = (uint16_t *)target;
+        const uint16_t *src16 = (const uint16_t *)src;
 
-        for (i = 0; i < elements; i++)
-            tmp16[i] = util_endian_convert16(tmp16[i]);
+        for (int i = 0; i < elements; i++)
+            target16[i] = util_endian_convert16(src16[i]);
         break;
     }
-    case (4): {
-#ifdef ARCH64
-        /*
-        In the case of a 64 bit CPU the fastest way to swap 32 bit
-        variables will be by swapping two elements in one operation;
-        this is provided by the util_endian_convert32_64() function. In the case
-        of binary ECLIPSE files this case is quite common, and
-        therefore worth supporting as a special case.
-      */
-        uint64_t *tmp64 = (uint64_t *)data;
-
-        for (i = 0; i < elements / 2; i++)
-            tmp64[i] = util_endian_convert32_64(tmp64[i]);
-
-        if (elements & 1) {
-            // Odd number of elements - flip the last element as an ordinary 32 bit swap.
-            uint32_t *tmp32 = (uint32_t *)data;
-            tmp32[elements - 1] = util_endian_convert32(tmp32[elements - 1]);
-        }
+    case (4):
+        util_endian_flip_copy32((char *)target, (const char *)src, elements);
         break;
-#else
-        uint32_t *tmp32 = (uint32_t *)data;
-
-        for (i = 0; i < elements; i++)
-            tmp32[i] = util_endian_convert32(tmp32[i]);
-
+    case (8):
+        util_endian_flip_copy64((char *)target, (const char *)src, elements);
         break;
-#endif
+    default:
+        util_abort(
+            "%s: can only endian flip 1/2/4/8 byte variables - aborting \n",
+            __func__);
     }
-    case (8): {
-        uint64_t *tmp64 = (uint64_t *)data;
+}
 
-        for (i = 0; i < elements; i++)
-            tmp64[i] = util_endian_convert64(tmp64[i]);
+void util_endian_flip_vector(void *data, int element_size, int elements) {
+    switch (element_size) {
+    case (1):
+    case (2):
+    case (4):
+    case (8):
+        util_endian_flip_copy_vector(data, data, element_size, elements);
         break;
-    }
     default:
         fprintf(stderr, "%s: current element size: %d \n", __func__,
                 element_size);
@@ -100,11 +100,17 @@ class EclFileFlagEnum(BaseCEnum):
     ECL_FILE_DEFAULT = None
     ECL_FILE_CLOSE_STREAM = None
     ECL_FILE_WRITABLE = None
+    ECL_FILE_MMAP = None
+    ECL_FILE_INDEX_CACHE = None
+    ECL_FILE_COLUMN_CACHE = None
 
 
 EclFileFlagEnum.addEnum("ECL_FILE_DEFAULT", 0)
 EclFileFlagEnum.addEnum("ECL_FILE_CLOSE_STREAM", 1)
 EclFileFlagEnum.addEnum("ECL_FILE_WRITABLE", 2)
+EclFileFlagEnum.addEnum("ECL_FILE_MMAP", 4)
+EclFileFlagEnum.addEnum("ECL_FILE_INDEX_CACHE", 8)
+EclFileFlagEnum.addEnum("ECL_FILE_COLUMN_CACHE", 16)
 
 
 # -----------------------------------------------------------------
@@ -220,6 +220,13 @@ class EclFile(BaseCClass):
               in cases where a high number of EclFile instances are
               open concurrently.
 
+           ecl.ECL_FILE_MMAP : The file is memory mapped read-only,
+              and keywords are loaded directly from the mapping.
+
+           ecl.ECL_FILE_INDEX_CACHE : The keyword index is cached in a
+              hidden file next to the file, and reused when the file
+              is opened again.
+
         When the file has been loaded the EclFile instance can be used
         to query for and get reference to the EclKW instances
         constituting the file, like e.g. SWAT from a restart file or
@@ -114,6 +114,9 @@ class EclGrid(BaseCClass):
     _get_ijk_xyz = EclPrototype(
         "int  ecl_grid_get_global_index_from_xyz(ecl_grid, double, double, double, int)"
     )
+    _get_global_index_xyz_batch = EclPrototype(
+        "void ecl_grid_get_global_index_from_xyz_batch(ecl_grid, int, double*, double*, double*, int*)"
+    )
     _cell_contains = EclPrototype(
         "bool ecl_grid_cell_contains_xyz1(ecl_grid, int, double, double, double)"
     )
@@ -879,10 +882,10 @@ class EclGrid(BaseCClass):
 
         Will locate the cell in the grid which contains the true
         position (@x,@y,@z), the return value is as a triplet
-        (i,j,k). The underlying C implementation is not veeery
-        efficient, and can potentially take quite long time. If you
-        provide a good intial guess with the parameter @start_ijk (a
-        tuple (i,j,k)) things can speed up quite substantially.
+        (i,j,k). The first lookup builds a search tree over the cells
+        of the grid, subsequent lookups are fast. If you provide a good
+        intial guess with the parameter @start_ijk (a tuple (i,j,k))
+        that cell is checked first.
 
         If the location (@x,@y,@z) can not be found in the grid, the
         method will return None.
@@ -902,6 +905,33 @@ class EclGrid(BaseCClass):
             return (i.value, j.value, k.value)
         return None
 
+    def find_cells(self, x, y, z):
+        """
+        Lookup the cells containing the true positions (x[i],y[i],z[i]).
+
+        The arguments @x, @y and @z should be sequences of equal
+        length, the return value is a numpy vector with the global
+        index of the cell containing each position, or -1 if the
+        position is not in the grid. The lookup runs in parallel, and is
+        fastest when consecutive points are close, e.g. along a well
+        trajectory.
+        """
+        x = numpy.ascontiguousarray(x, dtype=numpy.float64)
+        y = numpy.ascontiguousarray(y, dtype=numpy.float64)
+        z = numpy.ascontiguousarray(z, dtype=numpy.float64)
+        if not len(x) == len(y) == len(z):
+            raise ValueError("The x, y and z vectors must have equal length")
+
+        global_index = numpy.zeros(len(x), dtype=numpy.int32)
+        self._get_global_index_xyz_batch(
+            len(x),
+            x.ctypes.data_as(ctypes.POINTER(ctypes.c_double)),
+            y.ctypes.data_as(ctypes.POINTER(ctypes.c_double)),
+            z.ctypes.data_as(ctypes.POINTER(ctypes.c_double)),
+            global_index.ctypes.data_as(ctypes.POINTER(ctypes.c_int32)),
+        )
+        return global_index
+
     def cell_contains(self, x, y, z, active_index=None, global_index=None, ijk=None):
         """
         Will check if the cell contains point given by world
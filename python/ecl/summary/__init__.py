@@ -30,5 +30,6 @@ from .ecl_sum import EclSum  # , EclSumVector, EclSumNode, EclSMSPECNode
 from .ecl_sum_keyword_vector import EclSumKeyWordVector
 from .ecl_sum_node import EclSumNode
 from .ecl_sum_vector import EclSumVector
+from .ecl_sum_ensemble import EclSumEnsemble
 from .ecl_npv import EclNPV, NPVPriceVector
 from .ecl_cmp import EclCmp
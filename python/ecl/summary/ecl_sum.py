@@ -170,6 +170,7 @@ class EclSum(BaseCClass):
     _get_report_time = EclPrototype("time_t   ecl_sum_get_report_time(ecl_sum, int)")
     _fwrite_sum = EclPrototype("void     ecl_sum_fwrite(ecl_sum)")
     _can_write = EclPrototype("bool     ecl_sum_can_write(ecl_sum)")
+    _refresh = EclPrototype("int      ecl_sum_refresh(ecl_sum)")
     _set_case = EclPrototype("void     ecl_sum_set_case(ecl_sum, char*)")
     _alloc_time_vector = EclPrototype(
         "time_t_vector_obj ecl_sum_alloc_time_vector(ecl_sum, bool)"
@@ -249,7 +250,9 @@ class EclSum(BaseCClass):
         over multiple CASE.Snnn files all the data will be loaded at
         construction time, and the @lazy_load option is ignored. If the
         lazy_load functionality is used the file_options intege flag is passed
-        when opening the UNSMRY file.
+        when opening the UNSMRY file. With the ECL_FILE_COLUMN_CACHE flag the
+        UNSMRY file is transposed to a column major cache file in one pass, and
+        each vector is subsequently loaded with one contiguous read.
 
         """
         if not load_case:
@@ -1527,6 +1530,14 @@ are advised to fetch vector as a numpy vector and then scale that yourself:
     def can_write(self):
         return self._can_write()
 
+    def refresh(self):
+        """
+        Will load timesteps which have been added to the unified summary
+        file since the case was loaded, e.g. while the simulation is still
+        running, and return the number of new timesteps.
+        """
+        return self._refresh()
+
     def fwrite(self, ecl_case=None):
         if not self.can_write():
             raise NotImplementedError(
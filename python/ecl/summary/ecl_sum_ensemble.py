@@ -0,0 +1,96 @@
+"""
+The EclSumEnsemble class loads a list of summary cases in parallel.
+Cases with identical SMSPEC headers share one header instance, and the
+data of all cases can be exported as one (case x time x key) numpy
+array.
+"""
+import ctypes
+
+import numpy
+from cwrap import BaseCClass
+
+from ecl import EclPrototype
+from ecl.util.util import StringList, TimeVector
+from ecl.summary.ecl_sum import EclSum
+
+
+class EclSumEnsemble(BaseCClass):
+    TYPE_NAME = "ecl_sum_ensemble"
+    _fread_alloc = EclPrototype(
+        "void* ecl_sum_ensemble_fread_alloc(stringlist, char*, int)", bind=False
+    )
+    _free = EclPrototype("void ecl_sum_ensemble_free(ecl_sum_ensemble)")
+    _get_size = EclPrototype("int ecl_sum_ensemble_get_size(ecl_sum_ensemble)")
+    _iget_case = EclPrototype(
+        "ecl_sum_ref ecl_sum_ensemble_iget_case(ecl_sum_ensemble, int)"
+    )
+    _iget_case_name = EclPrototype(
+        "char* ecl_sum_ensemble_iget_case_name(ecl_sum_ensemble, int)"
+    )
+    _get_num_smspec = EclPrototype(
+        "int ecl_sum_ensemble_get_num_smspec(ecl_sum_ensemble)"
+    )
+    _init_frame_interp = EclPrototype(
+        "void ecl_sum_ensemble_init_double_frame_interp(ecl_sum_ensemble, stringlist, time_t_vector, double*)"
+    )
+
+    def __init__(self, case_list, join_string=":", num_threads=0):
+        """Loads all the summary cases in @case_list.
+
+        The cases are loaded with @num_threads threads, the default is
+        one thread per core. Cases which can not be loaded are skipped,
+        use the case_names property to see which cases were loaded.
+        """
+        cases = StringList(initial=case_list)
+        c_pointer = self._fread_alloc(cases, join_string, num_threads)
+        if c_pointer is None:
+            raise IOError("Failed to load summary ensemble")
+        super(EclSumEnsemble, self).__init__(c_pointer)
+
+    def __len__(self):
+        return self._get_size()
+
+    def __getitem__(self, index):
+        if index < 0:
+            index += len(self)
+        if not 0 <= index < len(self):
+            raise IndexError("Invalid index:%d" % index)
+
+        ecl_sum = self._iget_case(index)
+        ecl_sum.setParent(parent=self)
+        return ecl_sum
+
+    @property
+    def case_names(self):
+        return [self._iget_case_name(index) for index in range(len(self))]
+
+    @property
+    def num_smspec(self):
+        """The number of distinct SMSPEC headers in the ensemble."""
+        return self._get_num_smspec()
+
+    def numpy_array(self, keys, time_index):
+        """Will return a numpy array with shape (case, time, key).
+
+        The values are interpolated to the time points in @time_index as
+        in EclSum.pandas_frame(). Keys which are missing in a case get
+        the value NaN for that case.
+        """
+        key_list = StringList(initial=keys)
+        time_points = TimeVector()
+        for t in time_index:
+            time_points.append(t)
+
+        data = numpy.zeros([len(self), len(time_points), len(key_list)])
+        self._init_frame_interp(
+            key_list, time_points, data.ctypes.data_as(ctypes.POINTER(ctypes.c_double))
+        )
+        return data
+
+    def free(self):
+        self._free()
+
+    def __repr__(self):
+        return self._create_repr(
+            "size=%d, num_smspec=%d" % (len(self), self.num_smspec)
+        )
@@ -237,6 +237,22 @@ class GridTest(EclTest):
             grid.findCellCornerXY(nx, ny - 0.25, 0), (nx + 1) * (ny + 1) - 1
         )
 
+    def test_find_cells(self):
+        grid = GridGen.createRectangular((10, 20, 30), (1, 1, 1))
+        x = [0.5, 5.5, 9.5, 20.0]
+        y = [0.5, 10.5, 19.5, 0.5]
+        z = [0.5, 15.5, 29.5, 0.5]
+        global_index = grid.find_cells(x, y, z)
+
+        self.assertEqual(len(global_index), 4)
+        for i in range(3):
+            ijk = grid.find_cell(x[i], y[i], z[i])
+            self.assertEqual(global_index[i], grid.get_global_index(ijk=ijk))
+        self.assertEqual(global_index[3], -1)
+
+        with self.assertRaises(ValueError):
+            grid.find_cells([0.5], [0.5, 1.5], [0.5])
+
     def test_dims(self):
         grid = GridGen.createRectangular((10, 20, 30), (1, 1, 1))
         self.assertEqual(grid.getNX(), 10)
@@ -23,6 +23,7 @@ import shutil
 import cwrap
 import stat
 import pandas
+import numpy
 
 
 def assert_frame_equal(a, b):
@@ -41,7 +42,7 @@ from unittest import skipIf, skipUnless
 from ecl import EclUnitTypeEnum
 from ecl import EclDataType
 from ecl.eclfile import FortIO, openFortIO, EclKW, EclFile
-from ecl.summary import EclSum, EclSumVarType, EclSumKeyWordVector
+from ecl.summary import EclSum, EclSumVarType, EclSumKeyWordVector, EclSumEnsemble
 from ecl.util.test import TestAreaContext
 from tests import EclTest
 from ecl.util.test.ecl_mock import createEclSum
@@ -628,6 +629,33 @@ class SumTest(EclTest):
         self.assertEqual(len(case.keys()), columns)
         self.assertEqual(len(case), rows)
 
+    def test_ensemble(self):
+        with TestAreaContext("sum_ensemble"):
+            case_list = []
+            for i in range(4):
+                path = "real-%d" % i
+                with pushd(path):
+                    case = create_case() if i < 3 else create_case2()
+                    case.fwrite()
+                case_list.append(os.path.join(path, "CSV"))
+            case_list.append("real-4/CSV")
+
+            ensemble = EclSumEnsemble(case_list, num_threads=2)
+            self.assertEqual(len(ensemble), 4)
+            self.assertEqual(ensemble.num_smspec, 2)
+            self.assertEqual(ensemble.case_names, case_list[:4])
+
+            dates = ensemble[0].dates
+            data = ensemble.numpy_array(["FOPT", "FGPT"], dates)
+            self.assertEqual(data.shape, (4, len(dates), 2))
+            for i in range(3):
+                frame = ensemble[i].pandas_frame(
+                    column_keys=["FOPT", "FGPT"], time_index=dates
+                )
+                self.assertTrue((data[i, :, 0] == frame["FOPT"].values).all())
+                self.assertTrue((data[i, :, 1] == frame["FGPT"].values).all())
+            self.assertTrue(numpy.isnan(data[3, :, 0]).all())
+
     def test_csv_load(self):
         case = create_case2()
         frame = case.pandas_frame()